@@ -0,0 +1,14 @@
+/**
+ * @class IntrusiveList
+ *
+ * @file intrusivelist.cpp
+ *
+ * @brief Intrusive singly linked list class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "intrusivelist.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,382 @@
+#ifndef INTRUSIVELIST_H_
+#define INTRUSIVELIST_H_
+
+#include "intrusivelisthook.h"
+
+/**
+ * @class IntrusiveList
+ *
+ * @file intrusivelist.h
+ *
+ * Intrusive singly linked list class definition.
+ *
+ * A singly linked list of objects that carry their own link, an
+ * IntrusiveListHook, instead of being copied into list nodes. Linking and
+ * unlinking never allocate, an object is reached from the list without an
+ * extra indirection, and the objects stay where their owner put them: the
+ * list never copies, creates or deletes one. This suits objects that already
+ * live elsewhere and have to be in a list as well, such as connections that
+ * sit on a list of active connections and a list of timers at the same time.
+ *
+ * The hook policy says where an object's hook is: IntrusiveListBaseHook<T>
+ * (the default) for objects that derive from IntrusiveListHook<T>, or
+ * IntrusiveListMemberHook<T, &T::member> for a hook member. An object can be
+ * in one list per hook at a time; linking it into a second list through the
+ * same hook corrupts the first.
+ *
+ * The operations mirror those of SinglyLinkedList, with objects in place of
+ * nodes, and so do their running times: <tt>prepend</tt>, <tt>append</tt>
+ * and <tt>pop_front</tt> take O(1) time, <tt>remove</tt> O(n) to find the
+ * predecessor. Since the objects are not the list's, <tt>clear</tt> and
+ * <tt>remove</tt> only unlink them.
+ *
+ * @see singlylinkedlist.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T, class Hook = IntrusiveListBaseHook<T> >
+class IntrusiveList {
+public:
+    /**
+     * Default constructor.
+     */
+    IntrusiveList();
+
+    /**
+     * Destructor. Unlinks all the objects.
+     */
+    virtual ~IntrusiveList();
+
+    // -- getter methods
+
+    /**
+     * Getter for the list's head.
+     *
+     * @return The list's first object; <code>null</code> if the list is
+     *         empty.
+     */
+    inline T * head() { return m_head; }
+
+    /**
+     * Getter for the list's tail.
+     *
+     * @return The list's last object; <code>null</code> if the list is
+     *         empty.
+     */
+    inline T * tail() { return m_tail; }
+
+    /**
+     * Getter for the list's size.
+     *
+     * @return The number of objects in the list.
+     */
+    inline int size() { return m_size; }
+
+    /**
+     * Getter for the object after a given one.
+     *
+     * @param[in] object
+     *     An object in the list.
+     *
+     * @return The next object; <code>null</code> for the last one.
+     */
+    static inline T * next(T * object) { return Hook::hook(object).next(); }
+
+    // -- setter methods
+    // -- public methods
+
+    /**
+     * Clear list. Unlinks exactly size() objects, so this also works on a
+     * list that has been circulized.
+     */
+    void clear();
+
+    /**
+     * Prepends an object to the list's head.
+     *
+     * @param[in] object
+     *     The object to be prepended; must not be in a list through the same
+     *     hook.
+     */
+    void prepend(T * object);
+
+    /**
+     * Appends an object to the list's tail. Takes O(1) time.
+     *
+     * @param[in] object
+     *     The object to be appended; must not be in a list through the same
+     *     hook.
+     */
+    void append(T * object);
+
+    /**
+     * Unlinks the list's head. Takes O(1) time.
+     *
+     * @return The former head; <code>null</code> if the list was empty.
+     */
+    T * pop_front();
+
+    /**
+     * Finds the first object in the list that satisfies a predicate.
+     *
+     * @param[in] match
+     *     Takes an object and returns <code>true</code> on a match.
+     *
+     * @return The first matching object; <code>null</code> if there is
+     *         none.
+     */
+    template<class Predicate>
+    T * find_iterative(Predicate match);
+
+    /**
+     * Unlinks an object from the list.
+     *
+     * @param[in] object
+     *     The object to be unlinked.
+     *
+     * @return <code>true</code> if the object was in the list and has been
+     *         unlinked; <code>false</code> otherwise.
+     */
+    bool remove(T * object);
+
+    /**
+     * Reverts the list.
+     */
+    void revert();
+
+    /**
+     * Checks if the list is circular.
+     *
+     * @return <code>true</code> if the list is circular;<code>false</code>
+     *         otherwise.
+     */
+    bool isCircular();
+
+    /**
+     * Connects the last object with the head.
+     *
+     * ATTENTION: Breaks the functionalities based on list traversal; only
+     * <tt>isCircular</tt> and <tt>clear</tt> cope with it.
+     */
+    void circulize();
+
+    /**
+     * Find the <it>N</it>-th to last object in the list. Walks size() - n - 1
+     * objects from the head.
+     *
+     * @param[in] n
+     *     The position from the end; 0 is the last object.
+     *
+     * @return The object; <code>null</code> if n is not in [0, size()).
+     */
+    T * nth_to_last(int n);
+protected:
+private:
+    /**
+     * Copy constructor; a hook links its object into one list only.
+     */
+    IntrusiveList(const IntrusiveList<T, Hook> & other);
+
+    /**
+     * Assignment operator; a hook links its object into one list only.
+     */
+    IntrusiveList<T, Hook> & operator=(const IntrusiveList<T, Hook> & other);
+
+    /**
+     * Pointer to the list's head.
+     */
+    T * m_head;
+
+    /**
+     * Pointer to the list's last object.
+     */
+    T * m_tail;
+
+    /**
+     * The number of objects in the list.
+     */
+    int m_size;
+};
+
+
+template<class T, class Hook>
+IntrusiveList<T, Hook>::IntrusiveList()
+{
+    m_head = 0;
+    m_tail = 0;
+    m_size = 0;
+}
+
+
+template<class T, class Hook>
+IntrusiveList<T, Hook>::~IntrusiveList()
+{
+    clear();
+}
+
+
+template<class T, class Hook>
+void IntrusiveList<T, Hook>::clear()
+{
+    for (; m_size > 0; m_size--) {
+        T * object = m_head;
+        m_head = next(object);
+        Hook::hook(object).set_next(0);
+    }
+
+    m_head = 0;
+    m_tail = 0;
+}
+
+
+template<class T, class Hook>
+void IntrusiveList<T, Hook>::prepend(T * object)
+{
+    Hook::hook(object).set_next(m_head);
+    m_head = object;
+    if (m_tail == 0)
+        m_tail = object;
+    m_size++;
+}
+
+
+template<class T, class Hook>
+void IntrusiveList<T, Hook>::append(T * object)
+{
+    Hook::hook(object).set_next(0);
+
+    if (m_tail == 0)
+        m_head = object;
+    else
+        Hook::hook(m_tail).set_next(object);
+
+    m_tail = object;
+    m_size++;
+}
+
+
+template<class T, class Hook>
+T * IntrusiveList<T, Hook>::pop_front()
+{
+    T * object = m_head;
+
+    if (object == 0)
+        return 0;
+
+    m_head = next(object);
+    if (object == m_tail)
+        m_tail = 0;
+    Hook::hook(object).set_next(0);
+    m_size--;
+
+    return object;
+}
+
+
+template<class T, class Hook>
+template<class Predicate>
+T * IntrusiveList<T, Hook>::find_iterative(Predicate match)
+{
+    T * object = m_head;
+
+    while (object != 0 && !match(object))
+        object = next(object);
+
+    return object;
+}
+
+
+template<class T, class Hook>
+bool IntrusiveList<T, Hook>::remove(T * object)
+{
+    T * prev = 0;
+    T * curr = m_head;
+
+    while (curr != 0) {
+        if (curr == object) {
+            if (prev != 0)
+                Hook::hook(prev).set_next(next(curr));
+            else
+                m_head = next(curr);
+            if (curr == m_tail)
+                m_tail = prev;
+            Hook::hook(curr).set_next(0);
+            m_size--;
+            return true;
+        }
+        prev = curr;
+        curr = next(curr);
+    }
+
+    return false;
+}
+
+
+template<class T, class Hook>
+void IntrusiveList<T, Hook>::revert()
+{
+    T * prev = 0;
+    T * curr = m_head;
+
+    while (curr) {
+        T * step = next(curr);
+
+        Hook::hook(curr).set_next(prev);
+        prev = curr;
+        curr = step;
+    }
+
+    m_tail = m_head;
+    m_head = prev;
+}
+
+
+template<class T, class Hook>
+bool IntrusiveList<T, Hook>::isCircular()
+{
+    if (!m_head)
+        return false;
+
+    T * slow = m_head;
+    T * fast = next(m_head);
+
+    while (true)
+    {
+        if (!fast || !next(fast))
+            return false;
+        else if (fast == slow || next(fast) == slow)
+            return true;
+        else
+        {
+            slow = next(slow);
+            fast = next(next(fast));
+        }
+    }
+}
+
+
+template<class T, class Hook>
+void IntrusiveList<T, Hook>::circulize()
+{
+    if (m_tail)
+        Hook::hook(m_tail).set_next(m_head);
+}
+
+
+template<class T, class Hook>
+T * IntrusiveList<T, Hook>::nth_to_last(int n)
+{
+    if (n < 0 || n >= m_size)
+        return 0;
+
+    T * object = m_head;
+
+    for (int i = m_size - n - 1; i > 0; i--)
+        object = next(object);
+
+    return object;
+}
+
+
+#endif /* INTRUSIVELIST_H_ */
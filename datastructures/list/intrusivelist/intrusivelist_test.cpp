@@ -0,0 +1,285 @@
+/**
+ * @file intrusivelist_test.cpp
+ *
+ * Test unit for the intrusive singly linked list class.
+ *
+ * @see intrusivelist.h intrusivelist.cpp intrusivelisthook.h
+ * intrusivelisthook.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "intrusivelist.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+void test_base_hook();
+void test_member_hooks();
+void test_revert_nth_to_last();
+void test_isCircular();
+void test_link_timing();
+
+int main (int argc, char** argv)
+{
+    test_base_hook();
+    test_member_hooks();
+    test_revert_nth_to_last();
+    test_isCircular();
+    test_link_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * A timer, linked through its base class.
+ */
+struct Timer : public IntrusiveListHook<Timer>
+{
+    int deadline;
+
+    Timer(int d = 0) : deadline(d) {}
+};
+
+
+/**
+ * A connection, which can be on a list of active connections and on a list
+ * of idle ones at the same time, through two member hooks.
+ */
+struct Connection
+{
+    int id;
+    IntrusiveListHook<Connection> active;
+    IntrusiveListHook<Connection> idle;
+
+    Connection(int i = 0) : id(i) {}
+};
+
+typedef IntrusiveList<Connection, IntrusiveListMemberHook<Connection, &Connection::active> > ActiveList;
+typedef IntrusiveList<Connection, IntrusiveListMemberHook<Connection, &Connection::idle> > IdleList;
+
+
+/**
+ * Prints the deadlines of a list of timers.
+ */
+void print(IntrusiveList<Timer> & timers)
+{
+    std::cout << "HEAD -> ";
+    for (Timer * timer = timers.head(); timer != 0; timer = timers.next(timer))
+        std::cout << "| " << timer->deadline << " | -> ";
+    std::cout << "NULL" << std::endl;
+}
+
+
+/**
+ * Checks the size and the tail of a list against a walk from its head.
+ */
+template<class T, class Hook>
+bool is_consistent(IntrusiveList<T, Hook> & list)
+{
+    int count = 0;
+    T * last = 0;
+    for (T * object = list.head(); object != 0; object = list.next(object)) {
+        last = object;
+        count++;
+    }
+
+    return count == list.size() && last == list.tail();
+}
+
+
+/**
+ * Matches a connection by its id.
+ */
+struct HasId
+{
+    int id;
+
+    HasId(int i) : id(i) {}
+    bool operator()(Connection * connection) const { return connection->id == id; }
+};
+
+
+// test functions
+
+
+void test_base_hook()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    Timer timers[10];
+    IntrusiveList<Timer> list;
+    for (int i = 0; i < 10; i++) {
+        timers[i].deadline = i * 10;
+        if (i % 2 == 0)
+            list.append(&timers[i]);
+        else
+            list.prepend(&timers[i]);
+    }
+    std::cout << "Appended the even, prepended the odd deadlines:" << std::endl;
+    print(list);
+
+    list.remove(&timers[9]);
+    list.remove(&timers[8]);
+    list.remove(&timers[4]);
+    std::cout << "Removed the head, the tail and 40:" << std::endl;
+    print(list);
+    std::cout << "Removing 40 again: " << (list.remove(&timers[4]) ? "removed" : "not found") << std::endl;
+
+    Timer * timer = list.pop_front();
+    std::cout << "Popped " << timer->deadline << ", size " << list.size()
+            << (is_consistent(list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    list.clear();
+    std::cout << "Cleared: size " << list.size() << (is_consistent(list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_member_hooks()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    std::vector<Connection> connections;
+    for (int i = 0; i < 8; i++)
+        connections.push_back(Connection(i));
+
+    ActiveList active;
+    IdleList idle;
+    for (int i = 0; i < 8; i++) {
+        active.append(&connections[i]);
+        if (i % 3 == 0)
+            idle.prepend(&connections[i]);
+    }
+
+    std::cout << "Active:";
+    for (Connection * c = active.head(); c != 0; c = active.next(c))
+        std::cout << " " << c->id;
+    std::cout << std::endl << "Idle:";
+    for (Connection * c = idle.head(); c != 0; c = idle.next(c))
+        std::cout << " " << c->id;
+    std::cout << std::endl;
+
+    // Close connection 3: it leaves both lists, the others stay put.
+    Connection * closing = active.find_iterative(HasId(3));
+    bool ok = closing == &connections[3] && active.remove(closing) && idle.remove(closing);
+    ok = ok && active.size() == 7 && idle.size() == 2 && is_consistent(active) && is_consistent(idle);
+    ok = ok && active.find_iterative(HasId(3)) == 0 && idle.find_iterative(HasId(6)) == &connections[6];
+    std::cout << "Closed connection 3" << (ok ? " (ok)" : " (WRONG)") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_revert_nth_to_last()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    Timer timers[11];
+    IntrusiveList<Timer> list;
+    for (int i = 0; i < 11; i++) {
+        timers[i].deadline = i;
+        list.append(&timers[i]);
+    }
+
+    list.revert();
+    std::cout << "Reverted list:" << std::endl;
+    print(list);
+
+    int ns[] = { 0, 5, 10, 11 };
+    for (int i = 0; i < 4; i++) {
+        Timer * timer = list.nth_to_last(ns[i]);
+        if (timer)
+            std::cout << "The " << ns[i] << "-th to last is " << timer->deadline << "." << std::endl;
+        else
+            std::cout << "The " << ns[i] << "-th to last is \"undefined\"." << std::endl;
+    }
+    std::cout << "Consistent after revert" << (is_consistent(list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_isCircular()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    Timer timers[7];
+    IntrusiveList<Timer> list;
+    for (int i = 0; i < 7; i++)
+        list.append(&timers[i]);
+
+    std::cout << "The list is " << (list.isCircular() ? "" : "NOT ") << "circular." << std::endl;
+    list.circulize();
+    std::cout << "The circulized list is " << (list.isCircular() ? "" : "NOT ") << "circular." << std::endl;
+    list.clear();
+    std::cout << "Cleared: " << (list.size() == 0 && timers[6].next() == 0 ? "(ok)" : "(WRONG)") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Links objects that live in an array into an intrusive list, and their
+ * addresses into a SinglyLinkedList, which allocates a node for each.
+ */
+void test_link_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1000000;
+    const int rounds = 10;
+    std::vector<Connection> connections(n);
+    for (int i = 0; i < n; i++)
+        connections[i].id = i;
+
+    long sum = 0;
+    ActiveList intrusive;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < n; i++)
+            intrusive.append(&connections[i]);
+        for (Connection * c = intrusive.head(); c != 0; c = intrusive.next(c))
+            sum += c->id;
+        while (intrusive.pop_front() != 0)
+            ;
+    }
+    double intrusive_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SinglyLinkedList<Connection *> wrapped;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < n; i++)
+            wrapped.append(new SinglyLinkedListNode<Connection *>(&connections[i]));
+        for (SinglyLinkedListNode<Connection *> * node = wrapped.head(); node != 0; node = node->next())
+            sum -= node->data()->id;
+        wrapped.clear();
+    }
+    double wrapped_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << rounds << " rounds of linking, walking and unlinking " << n << " objects ("
+            << (sum == 0 ? "ok" : "WRONG") << "):" << std::endl;
+    std::cout << "IntrusiveList:                  " << intrusive_secs << "s" << std::endl;
+    std::cout << "SinglyLinkedList of pointers:   " << wrapped_secs << "s" << std::endl;
+
+    std::cout << std::endl;
+}
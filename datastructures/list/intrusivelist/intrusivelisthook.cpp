@@ -0,0 +1,14 @@
+/**
+ * @class IntrusiveListHook
+ *
+ * @file intrusivelisthook.cpp
+ *
+ * @brief Intrusive list hook class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "intrusivelisthook.h"
+
+// Empty due to template implementation.
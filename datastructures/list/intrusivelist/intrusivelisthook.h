@@ -0,0 +1,95 @@
+#ifndef INTRUSIVELISTHOOK_H_
+#define INTRUSIVELISTHOOK_H_
+
+/**
+ * @class IntrusiveListHook
+ *
+ * @file intrusivelisthook.h
+ *
+ * Intrusive list hook class definition.
+ *
+ * The link of an IntrusiveList, kept inside the linked object itself rather
+ * than in a node that wraps a copy of it. An object is linked through a hook
+ * either by deriving from IntrusiveListHook<T> (a <em>base hook</em>, see
+ * IntrusiveListBaseHook) or by holding an IntrusiveListHook<T> member (a
+ * <em>member hook</em>, see IntrusiveListMemberHook); an object with several
+ * member hooks can be in as many lists at once, one per hook.
+ *
+ * The hook points straight at the next object, so following a link needs
+ * no pointer arithmetic. A hook is not copied with its object: a copy starts
+ * out unlinked.
+ *
+ * @see intrusivelist.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class IntrusiveListHook {
+public:
+    /**
+     * Default constructor.
+     */
+    IntrusiveListHook() : m_next(0) {}
+
+    /**
+     * Copy constructor. The copy is not linked.
+     */
+    IntrusiveListHook(const IntrusiveListHook &) : m_next(0) {}
+
+    /**
+     * Assignment operator. Leaves the link alone.
+     */
+    IntrusiveListHook & operator=(const IntrusiveListHook &) { return *this; }
+
+    // -- getter methods
+
+    /**
+     * Getter for the hook's next pointer.
+     *
+     * @return A pointer to the next object.
+     */
+    inline T * next() const { return m_next; }
+
+    // -- setter methods
+
+    /**
+     * Setter for the hook's pointer to the next object.
+     *
+     * @param[in] next
+     *     A pointer to the object which we want set as next.
+     */
+    inline void set_next(T * next) { m_next = next; }
+protected:
+private:
+    /**
+     * A pointer to the next object in the list sequence.
+     */
+    T * m_next;
+};
+
+
+/**
+ * @class IntrusiveListBaseHook
+ *
+ * Finds the hook of an object that derives from IntrusiveListHook<T>.
+ */
+template<class T>
+struct IntrusiveListBaseHook
+{
+    static inline IntrusiveListHook<T> & hook(T * object) { return *object; }
+};
+
+
+/**
+ * @class IntrusiveListMemberHook
+ *
+ * Finds the hook of an object that holds it as the given member.
+ */
+template<class T, IntrusiveListHook<T> T::*Member>
+struct IntrusiveListMemberHook
+{
+    static inline IntrusiveListHook<T> & hook(T * object) { return object->*Member; }
+};
+
+#endif /* INTRUSIVELISTHOOK_H_ */
@@ -0,0 +1,14 @@
+/**
+ * @class ListRanker
+ *
+ * @file listranker.cpp
+ *
+ * @brief Parallel list ranking class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "listranker.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,510 @@
+#ifndef LISTRANKER_H_
+#define LISTRANKER_H_
+
+#include "../singlylinkedlist/singlylinkedlist.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ListRanker
+ *
+ * @file listranker.h
+ *
+ * Parallel list ranking class definition.
+ *
+ * <p>
+ * Computes the <em>rank</em> of every node of a linked list, its distance
+ * from the head, and <em>prefix aggregates</em>, the values of the nodes
+ * from the head up to each node combined in list order, on several threads
+ * (D. Helman and J. JaJa, "Prefix computations on symmetric multiprocessors",
+ * 2001). Walking a list one node after the other is a chain of dependent
+ * loads, each of which may miss the cache; the work here is spread over
+ * many independent walks instead.
+ *
+ * The lists are given in <em>successor form</em>: n nodes numbered 0 to
+ * n - 1 and an array holding, for every node, the number of the next one,
+ * or -1 after the last. The array may hold several lists at once, a forest
+ * of chains, each headed by a node that no other node points to; ranks and
+ * aggregates start over at every head. The ranking runs in four passes:
+ *
+ * <ol>
+ * <li>the nodes that some node points to are marked, so that the others are
+ *     known to be heads;</li>
+ * <li><em>splitters</em> are chosen: all the heads, and every k-th node by
+ *     number, about SUBLISTS_PER_THREAD per thread; they cut the chains into
+ *     sublists of n / (SUBLISTS_PER_THREAD * threads) nodes on average;</li>
+ * <li>every sublist is walked from its splitter up to the next one, giving
+ *     every node its rank and aggregate within the sublist, and the sublist
+ *     its length and total; a thread walks LANES sublists at a time,
+ *     interleaved, so that up to LANES cache misses are outstanding at
+ *     once, even on a single core;</li>
+ * <li>the sublists are ranked along their chains by the calling thread
+ *     alone, since there are only a few of them, and every node adds the
+ *     rank and aggregate of the sublists before its own.</li>
+ * </ol>
+ *
+ * The passes take O(n / threads) time each, plus O(threads) for the
+ * sublists. Nodes on a cycle, which has no head, get rank -1.
+ *
+ * A SinglyLinkedList is ranked by numbering its nodes without walking it,
+ * through the slabs of its node pool (see singlylinkedlistnodepool.h): the
+ * free nodes of the pool, and the nodes of other lists that share it, form
+ * chains of their own and are ranked along. This costs time in the number
+ * of nodes the pool has handed out, not in the length of the list, so it
+ * only pays off when the list uses most of its pool; a list holding less
+ * than half of it is walked instead. So is a list without a pool, or with
+ * nodes that did not come from its pool, or a circulized one.
+ *
+ * The threads are started for every pass and take work in chunks from a
+ * shared counter; the calling thread is one of them.
+ *
+ * @see singlylinkedlist.h singlylinkedlistnodepool.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class ListRanker {
+public:
+    /**
+     * The number of sublists per thread; more keep the threads evenly
+     * loaded, fewer make the sequential pass shorter.
+     */
+    static const int SUBLISTS_PER_THREAD = 256;
+
+    /**
+     * The number of sublists a thread walks at a time.
+     */
+    static const int LANES = 16;
+
+    /**
+     * The number of nodes a thread takes at a time in the passes over all
+     * the nodes.
+     */
+    static const int CHUNK = 16384;
+
+    /**
+     * Constructor.
+     *
+     * @param[in] threads
+     *     The number of threads to use, the calling one included.
+     */
+    explicit ListRanker(int threads);
+
+    /**
+     * Destructor.
+     */
+    virtual ~ListRanker();
+
+    // -- getter methods
+
+    /**
+     * Getter for the number of threads.
+     *
+     * @return The number of threads used, the calling one included.
+     */
+    inline int threads() const { return m_threads; }
+
+    // -- public methods
+
+    /**
+     * Ranks lists given in successor form.
+     *
+     * @param[in] next
+     *     The number of the node after each node; -1 after the last one.
+     * @param[in] n
+     *     The number of nodes.
+     * @param[out] rank
+     *     Set to the distance of each node from the head of its list; -1 for
+     *     nodes on a cycle.
+     * @param[out] chain
+     *     If not <code>null</code>, set to the number of the head of each
+     *     node's list; -1 for nodes on a cycle.
+     */
+    void rank(const int * next, int n, int * rank, int * chain = 0);
+
+    /**
+     * Computes the prefix aggregates of lists given in successor form.
+     *
+     * @param[in] next
+     *     The number of the node after each node; -1 after the last one.
+     * @param[in] values
+     *     The value of each node.
+     * @param[in] n
+     *     The number of nodes.
+     * @param[out] prefix
+     *     Set to the values from the head of each node's list up to the node,
+     *     combined in list order.
+     * @param[in] op
+     *     Combines two values; must be associative, but need not be
+     *     commutative.
+     */
+    template<class Op>
+    void scan(const int * next, const T * values, int n, T * prefix, Op op);
+
+    /**
+     * Copies the data of a list into an array, in list order.
+     *
+     * @param[in] list
+     *     The list.
+     * @param[out] out
+     *     The array; room for list.size() elements.
+     *
+     * @return The number of elements copied, list.size().
+     */
+    int to_array(SinglyLinkedList<T> & list, T * out);
+
+    /**
+     * Writes the prefix aggregates of a list into an array, in list order.
+     *
+     * @param[in] list
+     *     The list.
+     * @param[out] out
+     *     The array; room for list.size() elements. Element i is set to the
+     *     data of the first i + 1 nodes combined in list order.
+     * @param[in] op
+     *     Combines two values; must be associative, but need not be
+     *     commutative.
+     *
+     * @return The number of elements written, list.size().
+     */
+    template<class Op>
+    int scan(SinglyLinkedList<T> & list, T * out, Op op);
+protected:
+private:
+    /**
+     * Stands for the combining operation when only ranks are computed.
+     */
+    struct First
+    {
+        const T & operator()(const T & a, const T &) const { return a; }
+    };
+
+    /**
+     * Ranks lists given in successor form, and computes their prefix
+     * aggregates if <code>values</code> is not <code>null</code>; see the
+     * class description. Any of <code>rank</code>, <code>chain</code> and
+     * <code>prefix</code> may be <code>null</code>.
+     */
+    template<class Op>
+    void solve(const int * next, int n, const T * values, T * prefix, Op op, int * rank, int * chain);
+
+    /**
+     * Numbers the nodes of a list's pool by slab, ranks them, and writes the
+     * data of the list's nodes, or their prefix aggregates, in list order.
+     *
+     * @return <code>false</code> if the list cannot be ranked through its
+     *         pool, or holds less than half of the pool's nodes, in which
+     *         case nothing is written.
+     */
+    template<class Op>
+    bool gather(SinglyLinkedList<T> & list, T * out, bool scanned, Op op);
+
+    /**
+     * Runs work(i) for every i in [0, items), on the threads.
+     */
+    template<class Work>
+    void run(int items, Work work);
+
+    /**
+     * The number of threads, the calling one included.
+     */
+    const int m_threads;
+};
+
+
+template<class T>
+ListRanker<T>::ListRanker(int threads)
+    : m_threads(threads > 0 ? threads : 1)
+{
+}
+
+
+template<class T>
+ListRanker<T>::~ListRanker()
+{
+}
+
+
+template<class T>
+void ListRanker<T>::rank(const int * next, int n, int * rank, int * chain)
+{
+    solve(next, n, (const T *) 0, (T *) 0, First(), rank, chain);
+}
+
+
+template<class T>
+template<class Op>
+void ListRanker<T>::scan(const int * next, const T * values, int n, T * prefix, Op op)
+{
+    solve(next, n, values, prefix, op, (int *) 0, (int *) 0);
+}
+
+
+template<class T>
+int ListRanker<T>::to_array(SinglyLinkedList<T> & list, T * out)
+{
+    if (gather(list, out, false, First()))
+        return list.size();
+
+    SinglyLinkedListNode<T> * node = list.head();
+    for (int i = 0; i < list.size(); i++, node = node->next())
+        out[i] = node->data();
+
+    return list.size();
+}
+
+
+template<class T>
+template<class Op>
+int ListRanker<T>::scan(SinglyLinkedList<T> & list, T * out, Op op)
+{
+    if (gather(list, out, true, op))
+        return list.size();
+
+    SinglyLinkedListNode<T> * node = list.head();
+    for (int i = 0; i < list.size(); i++, node = node->next())
+        out[i] = i == 0 ? node->data() : op(out[i - 1], node->data());
+
+    return list.size();
+}
+
+
+template<class T>
+template<class Op>
+void ListRanker<T>::solve(const int * next, int n, const T * values, T * prefix, Op op, int * rank, int * chain)
+{
+    if (n <= 0)
+        return;
+
+    const int chunks = (n + CHUNK - 1) / CHUNK;
+
+    // Pass 1: mark every node that some node points to. After pass 2 the
+    // mark of a splitter j is -(j + 1).
+    std::vector<std::atomic<int> > mark(n);
+    run(chunks, [&](int c) {
+        int last = std::min(n, (c + 1) * CHUNK);
+        for (int v = c * CHUNK; v < last; v++)
+            if (next[v] >= 0)
+                mark[next[v]].store(1, std::memory_order_relaxed);
+    });
+
+    // Pass 2: choose the heads and every stride-th node, chunk by chunk, so
+    // the splitters come out in order of their numbers.
+    int stride = std::max(1, n / (m_threads * SUBLISTS_PER_THREAD));
+    std::vector<std::vector<int> > found(chunks);
+    run(chunks, [&](int c) {
+        int last = std::min(n, (c + 1) * CHUNK);
+        for (int v = c * CHUNK; v < last; v++)
+            if (mark[v].load(std::memory_order_relaxed) == 0 || v % stride == 0)
+                found[c].push_back(v);
+    });
+
+    std::vector<int> splitters;
+    std::vector<char> is_head;
+    for (int c = 0; c < chunks; c++) {
+        for (size_t i = 0; i < found[c].size(); i++) {
+            int v = found[c][i];
+            is_head.push_back(mark[v].load(std::memory_order_relaxed) == 0);
+            splitters.push_back(v);
+        }
+    }
+    const int s = (int) splitters.size();
+    for (int j = 0; j < s; j++)
+        mark[splitters[j]].store(-(j + 1), std::memory_order_relaxed);
+
+    // Pass 3: walk the sublists, LANES at a time per thread.
+    std::vector<int> sub(n, -1);
+    std::vector<int> length(s);
+    std::vector<int> following(s);
+    std::vector<T> total(values != 0 ? s : 0);
+    run((s + LANES - 1) / LANES, [&](int g) {
+        const int first = g * LANES;
+        const int lanes = s - first < LANES ? s - first : LANES;
+        int at[LANES];
+        int steps[LANES];
+        T sum[LANES];
+        int active = lanes;
+
+        for (int l = 0; l < lanes; l++) {
+            at[l] = splitters[first + l];
+            steps[l] = 0;
+            if (values != 0)
+                sum[l] = values[at[l]];
+        }
+
+        while (active > 0) {
+            for (int l = 0; l < lanes; l++) {
+                int v = at[l];
+                if (v < 0)
+                    continue;
+
+                sub[v] = first + l;
+                if (rank != 0)
+                    rank[v] = steps[l];
+                if (values != 0)
+                    prefix[v] = sum[l];
+
+                int w = next[v];
+                int m = w >= 0 ? mark[w].load(std::memory_order_relaxed) : 0;
+                if (w < 0 || m < 0) {
+                    length[first + l] = steps[l] + 1;
+                    following[first + l] = w < 0 ? -1 : -m - 1;
+                    if (values != 0)
+                        total[first + l] = sum[l];
+                    at[l] = -1;
+                    active--;
+                }
+                else {
+                    at[l] = w;
+                    steps[l]++;
+                    if (values != 0)
+                        sum[l] = op(sum[l], values[w]);
+                }
+            }
+        }
+    });
+
+    // Pass 4: rank the sublists along their chains, then the nodes.
+    std::vector<int> offset(s, -1);
+    std::vector<int> head(s, -1);
+    std::vector<T> before(values != 0 ? s : 0);
+    for (int j = 0; j < s; j++) {
+        if (!is_head[j])
+            continue;
+
+        int ranked = 0;
+        T sum = T();
+        for (int k = j; k >= 0; k = following[k]) {
+            offset[k] = ranked;
+            head[k] = splitters[j];
+            ranked += length[k];
+            if (values != 0) {
+                before[k] = sum;
+                sum = k == j ? total[k] : op(sum, total[k]);
+            }
+        }
+    }
+
+    run(chunks, [&](int c) {
+        int last = std::min(n, (c + 1) * CHUNK);
+        for (int v = c * CHUNK; v < last; v++) {
+            int j = sub[v];
+            int start = j >= 0 ? offset[j] : -1;
+            if (rank != 0)
+                rank[v] = start >= 0 ? rank[v] + start : -1;
+            if (chain != 0)
+                chain[v] = start >= 0 ? head[j] : -1;
+            if (values != 0 && start > 0)
+                prefix[v] = op(before[j], prefix[v]);
+        }
+    });
+}
+
+
+template<class T>
+template<class Op>
+bool ListRanker<T>::gather(SinglyLinkedList<T> & list, T * out, bool scanned, Op op)
+{
+    SinglyLinkedListNodePool<T> * pool = list.pool();
+    if (pool == 0 || pool->slabs() == 0 || list.head() == 0)
+        return false;
+
+    // Every node the pool has handed out is ranked; a walk is cheaper for a
+    // list that holds few of them.
+    const int slabs = pool->slabs();
+    const int slab_size = pool->slab_size();
+    const int n = (slabs - 1) * slab_size + pool->carved(slabs - 1);
+    if (list.size() < n / 2)
+        return false;
+
+    // Node i of slab s is numbered s * slab_size() + i. A pointer is mapped
+    // back to its number through the slabs sorted by address.
+    std::vector<std::pair<size_t, int> > bases(slabs);
+    for (int s = 0; s < slabs; s++)
+        bases[s] = std::make_pair((size_t) pool->slab(s), s);
+    std::sort(bases.begin(), bases.end());
+
+    auto number = [&](SinglyLinkedListNode<T> * node) -> int {
+        std::pair<size_t, int> key((size_t) node, slabs);
+        typename std::vector<std::pair<size_t, int> >::iterator it = std::upper_bound(bases.begin(), bases.end(), key);
+        if (it == bases.begin())
+            return -1;
+        --it;
+        size_t i = ((size_t) node - it->first) / sizeof(SinglyLinkedListNode<T>);
+        if (i >= (size_t) pool->carved(it->second))
+            return -1;
+        return it->second * slab_size + (int) i;
+    };
+
+    std::vector<int> next(n);
+    std::vector<T> values(scanned ? n : 0);
+    std::atomic<bool> foreign(false);
+    run(slabs, [&](int s) {
+        SinglyLinkedListNode<T> * slab = pool->slab(s);
+        for (int i = 0; i < pool->carved(s); i++) {
+            int v = s * slab_size + i;
+            SinglyLinkedListNode<T> * after = slab[i].next();
+            next[v] = after != 0 ? number(after) : -1;
+            if (after != 0 && next[v] < 0)
+                foreign = true;
+            if (scanned)
+                values[v] = slab[i].data();
+        }
+    });
+
+    int first = number(list.head());
+    if (foreign || first < 0)
+        return false;
+
+    std::vector<int> rank(n);
+    std::vector<int> chain(n);
+    std::vector<T> prefix(scanned ? n : 0);
+    if (scanned)
+        solve(&next[0], n, &values[0], &prefix[0], op, &rank[0], &chain[0]);
+    else
+        solve(&next[0], n, (const T *) 0, (T *) 0, op, &rank[0], &chain[0]);
+
+    // A circulized list has no head, and leaves its head off any chain.
+    if (chain[first] != first)
+        return false;
+
+    const int size = list.size();
+    run(slabs, [&](int s) {
+        SinglyLinkedListNode<T> * slab = pool->slab(s);
+        for (int i = 0; i < pool->carved(s); i++) {
+            int v = s * slab_size + i;
+            if (chain[v] == first && rank[v] < size)
+                out[rank[v]] = scanned ? prefix[v] : slab[i].data();
+        }
+    });
+
+    return true;
+}
+
+
+template<class T>
+template<class Work>
+void ListRanker<T>::run(int items, Work work)
+{
+    std::atomic<int> item(0);
+    auto loop = [&]() {
+        for (int i = item++; i < items; i = item++)
+            work(i);
+    };
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < m_threads && w < items; w++)
+        workers.push_back(std::thread(loop));
+    loop();
+    for (size_t w = 0; w < workers.size(); w++)
+        workers[w].join();
+}
+
+#endif /* LISTRANKER_H_ */
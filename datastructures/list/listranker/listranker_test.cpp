@@ -0,0 +1,319 @@
+/**
+ * @file listranker_test.cpp
+ *
+ * Test unit for the parallel list ranking class.
+ *
+ * @see listranker.h listranker.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "listranker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void test_rank();
+void test_scan();
+void test_list_to_array();
+void test_ranking_timing();
+
+int main (int argc, char** argv)
+{
+    test_rank();
+    test_scan();
+    test_list_to_array();
+    test_ranking_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Links n nodes, numbered in random order, into lists of the given lengths,
+ * one after the other; returns the successor array and sets the heads.
+ */
+std::vector<int> random_lists(const std::vector<int> & lengths, std::vector<int> & heads, unsigned int seed)
+{
+    int n = 0;
+    for (size_t i = 0; i < lengths.size(); i++)
+        n += lengths[i];
+
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++)
+        order[i] = i;
+    srand(seed);
+    for (int i = n - 1; i > 0; i--)
+        std::swap(order[i], order[rand() % (i + 1)]);
+
+    std::vector<int> next(n, -1);
+    heads.clear();
+    int at = 0;
+    for (size_t i = 0; i < lengths.size(); i++) {
+        heads.push_back(order[at]);
+        for (int k = 1; k < lengths[i]; k++)
+            next[order[at + k - 1]] = order[at + k];
+        at += lengths[i];
+    }
+
+    return next;
+}
+
+
+/**
+ * Ranks lists in successor form by walking them.
+ */
+void walk_rank(const std::vector<int> & next, const std::vector<int> & heads, std::vector<int> & rank)
+{
+    rank.assign(next.size(), -1);
+    for (size_t i = 0; i < heads.size(); i++) {
+        int r = 0;
+        for (int v = heads[i]; v >= 0; v = next[v])
+            rank[v] = r++;
+    }
+}
+
+
+// test functions
+
+
+void test_rank()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    int lengths[] = { 1, 2, 1000, 70000, 5, 300000, 1 };
+    std::vector<int> heads;
+    std::vector<int> next = random_lists(std::vector<int>(lengths, lengths + 7), heads, 7);
+    const int n = (int) next.size();
+
+    std::vector<int> expected;
+    walk_rank(next, heads, expected);
+
+    int thread_counts[] = { 1, 3, 8 };
+    for (int t = 0; t < 3; t++) {
+        ListRanker<int> ranker(thread_counts[t]);
+        std::vector<int> rank(n);
+        std::vector<int> chain(n);
+        ranker.rank(&next[0], n, &rank[0], &chain[0]);
+
+        bool ok = rank == expected;
+        for (size_t i = 0; i < heads.size() && ok; i++)
+            for (int v = heads[i]; v >= 0 && ok; v = next[v])
+                ok = chain[v] == heads[i];
+        std::cout << "7 lists of " << n << " nodes, " << thread_counts[t] << " threads: "
+                << (ok ? "ok" : "WRONG") << std::endl;
+    }
+
+    // Close the longest list into a cycle: its nodes have no rank.
+    int last = heads[5];
+    while (next[last] >= 0)
+        last = next[last];
+    next[last] = heads[5];
+    std::vector<int> rank(n);
+    ListRanker<int>(4).rank(&next[0], n, &rank[0]);
+    int unranked = (int) std::count(rank.begin(), rank.end(), -1);
+    std::cout << "Nodes left unranked after closing a cycle: " << unranked << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Prefix sums, and string concatenation, which does not commute.
+ */
+void test_scan()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    int lengths[] = { 200000, 3, 50000 };
+    std::vector<int> heads;
+    std::vector<int> next = random_lists(std::vector<int>(lengths, lengths + 3), heads, 8);
+    const int n = (int) next.size();
+
+    std::vector<long> values(n);
+    for (int v = 0; v < n; v++)
+        values[v] = v % 1000 - 400;
+    std::vector<long> prefix(n);
+    ListRanker<long>(4).scan(&next[0], &values[0], n, &prefix[0], std::plus<long>());
+
+    bool ok = true;
+    for (size_t i = 0; i < heads.size(); i++) {
+        long sum = 0;
+        for (int v = heads[i]; v >= 0; v = next[v]) {
+            sum += values[v];
+            ok = ok && prefix[v] == sum;
+        }
+    }
+    std::cout << "Prefix sums over " << n << " nodes: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    int short_lengths[] = { 26, 3000 };
+    next = random_lists(std::vector<int>(short_lengths, short_lengths + 2), heads, 9);
+    std::vector<std::string> letters(next.size());
+    int r = 0;
+    for (int v = heads[0]; v >= 0; v = next[v])
+        letters[v] = std::string(1, (char) ('a' + r++));
+    for (int v = heads[1]; v >= 0; v = next[v])
+        letters[v] = "x";
+    std::vector<std::string> words(next.size());
+    ListRanker<std::string>(3).scan(&next[0], &letters[0], (int) next.size(), &words[0], std::plus<std::string>());
+
+    int last = heads[0];
+    while (next[last] >= 0)
+        last = next[last];
+    std::cout << "Concatenated along the first list: " << words[last] << std::endl;
+    ok = true;
+    r = 1;
+    for (int v = heads[1]; v >= 0; v = next[v])
+        ok = ok && words[v] == std::string(r++, 'x');
+    std::cout << "Concatenated along the second list: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_list_to_array()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    ListRanker<int> ranker(4);
+
+    // A list with a pool of its own, with some nodes freed in the middle.
+    SinglyLinkedList<int> owned(64);
+    for (int i = 0; i < 100000; i++)
+        owned.push_back(i);
+    for (int i = 0; i < 100000; i += 7)
+        owned.remove(i);
+    owned.sort();
+    std::vector<int> array(owned.size());
+    std::vector<int> expected;
+    for (SinglyLinkedListNode<int> * node = owned.head(); node != 0; node = node->next())
+        expected.push_back(node->data());
+    ranker.to_array(owned, &array[0]);
+    std::cout << "Pooled list of " << owned.size() << " with freed nodes: "
+            << (array == expected ? "ok" : "WRONG") << std::endl;
+
+    // Two lists sharing a pool, interleaved in its slabs.
+    SinglyLinkedListNodePool<int> pool(100);
+    SinglyLinkedList<int> odd(pool);
+    SinglyLinkedList<int> even(pool);
+    for (int i = 0; i < 50000; i++)
+        (i % 2 ? odd : even).push_front(i);
+    array.resize(odd.size());
+    ranker.to_array(odd, &array[0]);
+    bool ok = true;
+    for (int i = 0; i < odd.size(); i++)
+        ok = ok && array[i] == 49999 - 2 * i;
+    std::vector<int> sums(even.size());
+    ranker.scan(even, &sums[0], std::plus<int>());
+    int sum = 0;
+    for (int i = 0; i < even.size(); i++) {
+        sum += 49998 - 2 * i;
+        ok = ok && sums[i] == sum;
+    }
+    std::cout << "Two lists sharing a pool: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    // A short list next to a long one in the same pool is walked.
+    SinglyLinkedList<int> few(pool);
+    for (int i = 0; i < 100; i++)
+        few.push_back(i);
+    array.resize(few.size());
+    ranker.to_array(few, &array[0]);
+    ok = true;
+    for (int i = 0; i < few.size(); i++)
+        ok = ok && array[i] == i;
+    std::cout << "Short list in a shared pool: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    // A list without a pool, and a circulized one, are walked.
+    SinglyLinkedList<int> plain;
+    for (int i = 0; i < 1000; i++)
+        plain.push_back(i);
+    array.resize(plain.size());
+    ranker.to_array(plain, &array[0]);
+    ok = array[0] == 0 && array[999] == 999;
+    plain.clear();
+
+    SinglyLinkedList<int> circular(16);
+    for (int i = 0; i < 1000; i++)
+        circular.push_back(i);
+    circular.circulize();
+    ranker.to_array(circular, &array[0]);
+    ok = ok && array[0] == 0 && array[999] == 999;
+    std::cout << "Lists without a pool and circulized lists: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Ranks one long list whose nodes are numbered in random order, by walking
+ * it and with the ranker, and copies a pooled SinglyLinkedList whose nodes
+ * have been shuffled by sorting it.
+ */
+void test_ranking_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1 << 23;
+    std::vector<int> heads;
+    std::vector<int> next = random_lists(std::vector<int>(1, n), heads, 10);
+    std::vector<int> expected;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    walk_rank(next, heads, expected);
+    double wsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Ranking " << n << " nodes by walking: " << wsecs << "s" << std::endl;
+
+    int thread_counts[] = { 1, 2, 4, 8 };
+    for (int t = 0; t < 4; t++) {
+        ListRanker<int> ranker(thread_counts[t]);
+        std::vector<int> rank(n);
+        start = std::chrono::steady_clock::now();
+        ranker.rank(&next[0], n, &rank[0]);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Ranking with " << thread_counts[t] << " threads:   " << secs << "s"
+                << (rank == expected ? "" : " WRONG") << std::endl;
+    }
+
+    const int size = 1 << 22;
+    SinglyLinkedList<int> list(4096);
+    srand(11);
+    for (int i = 0; i < size; i++)
+        list.push_back(rand());
+    list.sort();
+    std::vector<int> walked(size);
+    start = std::chrono::steady_clock::now();
+    int i = 0;
+    for (SinglyLinkedListNode<int> * node = list.head(); node != 0; node = node->next())
+        walked[i++] = node->data();
+    wsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Copying a shuffled list of " << size << " by walking: " << wsecs << "s" << std::endl;
+
+    for (int t = 0; t < 4; t++) {
+        ListRanker<int> ranker(thread_counts[t]);
+        std::vector<int> array(size);
+        start = std::chrono::steady_clock::now();
+        ranker.to_array(list, &array[0]);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Copying with " << thread_counts[t] << " threads:   " << secs << "s"
+                << (array == walked ? "" : " WRONG") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
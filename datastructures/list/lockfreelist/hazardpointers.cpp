@@ -0,0 +1,14 @@
+/**
+ * @class HazardPointers
+ *
+ * @file hazardpointers.cpp
+ *
+ * @brief Hazard pointer domain class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "hazardpointers.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,316 @@
+#ifndef HAZARDPOINTERS_H_
+#define HAZARDPOINTERS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @class HazardPointers
+ *
+ * @file hazardpointers.h
+ *
+ * Hazard pointer domain class definition.
+ *
+ * <p>
+ * Safe memory reclamation for lock-free linked structures (M. M. Michael,
+ * "Hazard pointers: safe memory reclamation for lock-free objects", 2004).
+ * A thread that is about to dereference a shared node first publishes its
+ * address in one of its hazard slots and then checks that the node is still
+ * reachable; from then on, until the slot is cleared, the node is not
+ * deleted. A thread that unlinks a node retires it instead of deleting it;
+ * once it has retired enough nodes it scans the slots of all threads and
+ * deletes the retired nodes that nobody has published. With H slots in all,
+ * a scan happens every 2H retirements, so reclamation costs O(1) amortized
+ * time per node, and at most 2H nodes per thread wait to be deleted.
+ *
+ * Since a node cannot be deleted, let alone have its memory reused, while a
+ * thread holds it in a hazard slot, a compare-and-swap on a pointer to a
+ * protected node cannot succeed because a different node happened to get
+ * the same address (the ABA problem); the slots are the ABA protection of
+ * LockFreeStack and LockFreeQueue as well.
+ *
+ * Each thread takes the first free index in [0, MAX_THREADS) the first time
+ * it uses a domain of a given node type, and gives it back when it exits;
+ * the index picks its record in every domain. Nodes retired by a thread that
+ * has exited are reclaimed by the next thread that takes its index, or by
+ * the destructor. At most MAX_THREADS threads can use the domains of a node
+ * type at the same time; another thread waits for an index to be freed.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class Node>
+class HazardPointers {
+public:
+    /**
+     * The maximum number of threads using the domains of a node type at the
+     * same time.
+     */
+    static const int MAX_THREADS = 128;
+
+    /**
+     * The number of hazard slots per thread.
+     */
+    static const int SLOTS = 2;
+
+    /**
+     * Default constructor.
+     */
+    HazardPointers();
+
+    /**
+     * Destructor. Deletes all the retired nodes.
+     *
+     * Must not run concurrently with any other operation on the domain.
+     */
+    virtual ~HazardPointers();
+
+    // -- public methods
+
+    /**
+     * Loads a shared pointer and protects the node it points to.
+     *
+     * Publishes the pointer in a hazard slot of the calling thread and
+     * reloads it until it is unchanged, so that the node was still reachable
+     * through it after it had been published.
+     *
+     * @param[in] slot
+     *     The hazard slot, in [0, SLOTS).
+     * @param[in] source
+     *     The shared pointer.
+     *
+     * @return The protected pointer; may be <code>null</code>.
+     */
+    Node * protect(int slot, const std::atomic<Node *> & source);
+
+    /**
+     * Publishes a pointer in a hazard slot of the calling thread. The caller
+     * must check afterwards that the node is still reachable.
+     *
+     * @param[in] slot
+     *     The hazard slot, in [0, SLOTS).
+     * @param[in] node
+     *     The node to protect.
+     */
+    void set(int slot, Node * node);
+
+    /**
+     * Clears the hazard slots of the calling thread.
+     */
+    void clear();
+
+    /**
+     * Hands an unlinked node over for deferred deletion.
+     *
+     * @param[in] node
+     *     The node to retire. No thread may reach it through the structure
+     *     any more.
+     */
+    void retire(Node * node);
+protected:
+private:
+    /**
+     * The number of nodes a thread retires before it scans the slots.
+     */
+    static const int SCAN_THRESHOLD = 2 * MAX_THREADS * SLOTS;
+
+    /**
+     * The hazard slots and the retired nodes of a thread, padded to a cache
+     * line of its own so that threads do not bounce it between cores.
+     */
+    struct Record
+    {
+        std::atomic<Node *> hazards[SLOTS];
+        std::vector<Node *> retired;
+        char padding[64 - SLOTS * sizeof(std::atomic<Node *>) - sizeof(std::vector<Node *>)];
+    };
+
+    /**
+     * Claims an index for the lifetime of the thread.
+     */
+    struct ThreadIndex
+    {
+        int index;
+
+        ThreadIndex();
+        ~ThreadIndex();
+    };
+
+    /**
+     * The index of the calling thread.
+     *
+     * @return
+     *     The index, claimed on a thread's first call.
+     */
+    static int thread_index();
+
+    /**
+     * The claimed flags of the indices.
+     */
+    static std::atomic<bool> * claimed();
+
+    /**
+     * One past the largest index ever claimed; the scans look no further.
+     */
+    static std::atomic<int> & watermark();
+
+    /**
+     * Deletes the retired nodes of a record that are in no hazard slot.
+     *
+     * @param[in] record
+     *     The record of the calling thread.
+     */
+    void scan(Record & record);
+
+    /**
+     * The records of the threads, by index.
+     */
+    Record m_records[MAX_THREADS];
+};
+
+
+template<class Node>
+HazardPointers<Node>::HazardPointers()
+{
+    for (int i = 0; i < MAX_THREADS; i++)
+        for (int s = 0; s < SLOTS; s++)
+            m_records[i].hazards[s].store(0);
+}
+
+
+template<class Node>
+HazardPointers<Node>::~HazardPointers()
+{
+    for (int i = 0; i < MAX_THREADS; i++)
+        for (size_t j = 0; j < m_records[i].retired.size(); j++)
+            delete m_records[i].retired[j];
+}
+
+
+template<class Node>
+Node * HazardPointers<Node>::protect(int slot, const std::atomic<Node *> & source)
+{
+    std::atomic<Node *> & hazard = m_records[thread_index()].hazards[slot];
+    Node * node = source.load();
+
+    for (;;) {
+        hazard.store(node);
+        Node * again = source.load();
+        if (again == node)
+            return node;
+        node = again;
+    }
+}
+
+
+template<class Node>
+void HazardPointers<Node>::set(int slot, Node * node)
+{
+    m_records[thread_index()].hazards[slot].store(node);
+}
+
+
+template<class Node>
+void HazardPointers<Node>::clear()
+{
+    Record & record = m_records[thread_index()];
+
+    for (int s = 0; s < SLOTS; s++)
+        record.hazards[s].store(0, std::memory_order_release);
+}
+
+
+template<class Node>
+void HazardPointers<Node>::retire(Node * node)
+{
+    Record & record = m_records[thread_index()];
+
+    record.retired.push_back(node);
+    if ((int) record.retired.size() >= SCAN_THRESHOLD)
+        scan(record);
+}
+
+
+template<class Node>
+void HazardPointers<Node>::scan(Record & record)
+{
+    // Every retired node was unlinked before this point, so a thread that
+    // publishes one of them from now on fails its reachability check.
+    std::vector<Node *> hazards;
+    int threads = watermark().load();
+    for (int i = 0; i < threads; i++) {
+        for (int s = 0; s < SLOTS; s++) {
+            Node * node = m_records[i].hazards[s].load();
+            if (node != 0)
+                hazards.push_back(node);
+        }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    size_t kept = 0;
+    for (size_t j = 0; j < record.retired.size(); j++) {
+        Node * node = record.retired[j];
+        if (std::binary_search(hazards.begin(), hazards.end(), node))
+            record.retired[kept++] = node;
+        else
+            delete node;
+    }
+    record.retired.resize(kept);
+}
+
+
+template<class Node>
+int HazardPointers<Node>::thread_index()
+{
+    static thread_local ThreadIndex current;
+    return current.index;
+}
+
+
+template<class Node>
+std::atomic<bool> * HazardPointers<Node>::claimed()
+{
+    static std::atomic<bool> flags[MAX_THREADS];
+    return flags;
+}
+
+
+template<class Node>
+std::atomic<int> & HazardPointers<Node>::watermark()
+{
+    static std::atomic<int> high(0);
+    return high;
+}
+
+
+template<class Node>
+HazardPointers<Node>::ThreadIndex::ThreadIndex()
+    : index(-1)
+{
+    std::atomic<bool> * flags = claimed();
+
+    while (index < 0) {
+        for (int i = 0; i < MAX_THREADS && index < 0; i++) {
+            bool expected = false;
+            if (!flags[i].load() && flags[i].compare_exchange_strong(expected, true))
+                index = i;
+        }
+        if (index < 0)
+            std::this_thread::yield();
+    }
+
+    int high = watermark().load();
+    while (high < index + 1 && !watermark().compare_exchange_weak(high, index + 1))
+        ;
+}
+
+
+template<class Node>
+HazardPointers<Node>::ThreadIndex::~ThreadIndex()
+{
+    claimed()[index].store(false);
+}
+
+#endif /* HAZARDPOINTERS_H_ */
@@ -0,0 +1,14 @@
+/**
+ * @class LockFreeListNode
+ *
+ * @file lockfreelistnode.cpp
+ *
+ * @brief Lock-free list node class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "lockfreelistnode.h"
+
+// Empty due to template implementation.
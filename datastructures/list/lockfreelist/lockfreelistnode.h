@@ -0,0 +1,124 @@
+#ifndef LOCKFREELISTNODE_H_
+#define LOCKFREELISTNODE_H_
+
+#include <atomic>
+
+/**
+ * @class LockFreeListNode
+ *
+ * @file lockfreelistnode.h
+ *
+ * Lock-free list node class definition.
+ *
+ * The node of LockFreeStack and LockFreeQueue. It mirrors
+ * SinglyLinkedListNode, except that the next pointer is an atomic, so that
+ * threads can follow it and swing it with a compare-and-swap while others
+ * do the same. The data never changes once the node is constructed.
+ *
+ * @see singlylinkedlistnode.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class LockFreeListNode {
+public:
+    /**
+     * Default constructor. Used for the sentinel of LockFreeQueue.
+     */
+    LockFreeListNode();
+
+    /**
+     * Constructor.
+     *
+     * This constructor initializes the data with the given data and defaults
+     * the next pointer to <code>null</code>.
+     *
+     * @param[in] data
+     *     The data with which to initialize the new node.
+     */
+    LockFreeListNode(T data);
+
+    /**
+     * Destructor.
+     */
+    virtual ~LockFreeListNode();
+
+    // -- getter methods
+
+    /**
+     * Getter for the node's next pointer.
+     *
+     * @return A pointer to the next node.
+     */
+    inline LockFreeListNode * next() const { return m_next.load(); }
+
+    /**
+     * Getter for the node's data.
+     *
+     * @return The data of the node.
+     */
+    inline const T & data() const { return m_data; }
+
+    // -- setter methods
+
+    /**
+     * Setter for the node's pointer to the next node. Only for a node that
+     * no other thread can see yet.
+     *
+     * @param[in] next
+     *     A pointer to the node which we want set as next.
+     */
+    inline void set_next(LockFreeListNode * next) { m_next.store(next, std::memory_order_relaxed); }
+
+    // -- public methods
+
+    /**
+     * Sets the next pointer if it still holds the expected value.
+     *
+     * @param[in] expected
+     *     The value the next pointer is expected to hold.
+     * @param[in] next
+     *     A pointer to the node which we want set as next.
+     *
+     * @return <code>true</code> if the next pointer was set;
+     *         <code>false</code> if it held another value.
+     */
+    inline bool cas_next(LockFreeListNode * expected, LockFreeListNode * next)
+    {
+        return m_next.compare_exchange_strong(expected, next);
+    }
+protected:
+private:
+    /**
+     * The data of the node.
+     */
+    const T m_data;
+
+    /**
+     * A pointer to the next node in the list sequence.
+     */
+    std::atomic<LockFreeListNode *> m_next;
+};
+
+
+template<class T>
+LockFreeListNode<T>::LockFreeListNode()
+    : m_data(), m_next(0)
+{
+}
+
+
+template<class T>
+LockFreeListNode<T>::LockFreeListNode(T data)
+    : m_data(data), m_next(0)
+{
+}
+
+
+template<class T>
+LockFreeListNode<T>::~LockFreeListNode()
+{
+}
+
+#endif /* LOCKFREELISTNODE_H_ */
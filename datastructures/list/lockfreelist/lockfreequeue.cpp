@@ -0,0 +1,14 @@
+/**
+ * @class LockFreeQueue
+ *
+ * @file lockfreequeue.cpp
+ *
+ * @brief Lock-free queue class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "lockfreequeue.h"
+
+// Empty due to template implementation.
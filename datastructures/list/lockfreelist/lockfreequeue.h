@@ -0,0 +1,217 @@
+#ifndef LOCKFREEQUEUE_H_
+#define LOCKFREEQUEUE_H_
+
+#include "hazardpointers.h"
+#include "lockfreelistnode.h"
+
+#include <atomic>
+
+/**
+ * @class LockFreeQueue
+ *
+ * @file lockfreequeue.h
+ *
+ * Lock-free queue class definition.
+ *
+ * <p>
+ * A FIFO queue that any number of producers and consumers can use at once
+ * without a lock (M. M. Michael and M. L. Scott, "Simple, fast, and practical
+ * non-blocking and blocking concurrent queue algorithms", 1996). The queue
+ * is a singly linked list of LockFreeListNode that always starts with a
+ * sentinel node: the head points to the sentinel, whose successor holds the
+ * first element, and the tail points to the last node or, for a moment, to
+ * the one before it.
+ *
+ * An enqueue links a new node after the last one with a compare-and-swap on
+ * its next pointer and then swings the tail to it. A thread that finds the
+ * tail lagging behind swings it forward itself before it retries, so no
+ * thread ever waits for another one to finish. A dequeue reads the element
+ * of the sentinel's successor and swings the head to that successor, which
+ * becomes the new sentinel; the old one is retired. Producers and consumers
+ * thus work on different ends and mostly on different cache lines.
+ *
+ * Nodes are dereferenced only under hazard pointers and reclaimed through
+ * them (see hazardpointers.h), which also protects the compare-and-swaps on
+ * the head and the tail from the ABA problem.
+ *
+ * Elements enqueued by the same thread are dequeued in the order they were
+ * enqueued. All operations take O(1) time, plus the retries under
+ * contention.
+ *
+ * @see lockfreestack.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class LockFreeQueue {
+public:
+    /**
+     * Default constructor.
+     */
+    LockFreeQueue();
+
+    /**
+     * Destructor. Deletes all the nodes.
+     *
+     * Must not run concurrently with any other operation on the queue.
+     */
+    virtual ~LockFreeQueue();
+
+    // -- getter methods
+
+    /**
+     * Checks whether the queue is empty. The answer may be outdated as soon
+     * as it is returned, if other threads are using the queue.
+     *
+     * @return <code>true</code> if the queue has no elements;
+     *         <code>false</code> otherwise.
+     */
+    bool empty();
+
+    // -- public methods
+
+    /**
+     * Appends an element to the back of the queue.
+     *
+     * @param[in] data
+     *     The element to be enqueued.
+     */
+    void enqueue(T data);
+
+    /**
+     * Removes the element at the front of the queue.
+     *
+     * @param[out] data
+     *     Set to the dequeued element if the queue was not empty.
+     *
+     * @return <code>true</code> if an element was dequeued;
+     *         <code>false</code> if the queue was empty.
+     */
+    bool dequeue(T & data);
+protected:
+private:
+    typedef LockFreeListNode<T> Node;
+
+    /**
+     * Pointer to the sentinel node.
+     */
+    std::atomic<Node *> m_head;
+
+    /**
+     * Keeps the head and the tail on cache lines of their own.
+     */
+    char m_head_padding[64 - sizeof(std::atomic<Node *>)];
+
+    /**
+     * Pointer to the last node, or to the one before it.
+     */
+    std::atomic<Node *> m_tail;
+
+    /**
+     * Keeps the tail and the hazard records apart.
+     */
+    char m_tail_padding[64 - sizeof(std::atomic<Node *>)];
+
+    /**
+     * Protects the nodes being used and reclaims the dequeued ones.
+     */
+    HazardPointers<Node> m_hazards;
+};
+
+
+template<class T>
+LockFreeQueue<T>::LockFreeQueue()
+{
+    Node * sentinel = new Node();
+
+    m_head.store(sentinel);
+    m_tail.store(sentinel);
+}
+
+
+template<class T>
+LockFreeQueue<T>::~LockFreeQueue()
+{
+    Node * node = m_head.load();
+
+    while (node != 0) {
+        Node * del = node;
+        node = node->next();
+        delete del;
+    }
+}
+
+
+template<class T>
+bool LockFreeQueue<T>::empty()
+{
+    Node * head = m_hazards.protect(0, m_head);
+    bool empty = head->next() == 0;
+
+    m_hazards.clear();
+    return empty;
+}
+
+
+template<class T>
+void LockFreeQueue<T>::enqueue(T data)
+{
+    Node * node = new Node(data);
+
+    for (;;) {
+        Node * tail = m_hazards.protect(0, m_tail);
+        Node * next = tail->next();
+
+        if (next != 0) {
+            // The tail is lagging behind; help the enqueue in progress.
+            m_tail.compare_exchange_weak(tail, next);
+            continue;
+        }
+
+        if (tail->cas_next(0, node)) {
+            // Failing is fine: some other thread has moved the tail on.
+            m_tail.compare_exchange_strong(tail, node);
+            break;
+        }
+    }
+
+    m_hazards.clear();
+}
+
+
+template<class T>
+bool LockFreeQueue<T>::dequeue(T & data)
+{
+    for (;;) {
+        Node * head = m_hazards.protect(0, m_head);
+        Node * tail = m_tail.load();
+        Node * next = head->next();
+
+        // The successor of a node that is still the sentinel cannot have
+        // been retired, so publishing it and checking the head keeps it.
+        m_hazards.set(1, next);
+        if (head != m_head.load())
+            continue;
+
+        if (next == 0) {
+            m_hazards.clear();
+            return false;
+        }
+
+        if (head == tail) {
+            // Do not let the head pass the tail.
+            m_tail.compare_exchange_weak(tail, next);
+            continue;
+        }
+
+        if (m_head.compare_exchange_weak(head, next)) {
+            data = next->data();
+            m_hazards.clear();
+            m_hazards.retire(head);
+            return true;
+        }
+    }
+}
+
+#endif /* LOCKFREEQUEUE_H_ */
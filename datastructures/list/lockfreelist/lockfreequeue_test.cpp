@@ -0,0 +1,212 @@
+/**
+ * @file lockfreequeue_test.cpp
+ *
+ * Test unit for the lock-free queue class.
+ *
+ * @see lockfreequeue.h lockfreequeue.cpp lockfreelistnode.h
+ * lockfreelistnode.cpp hazardpointers.h hazardpointers.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "lockfreequeue.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void test_enqueue_dequeue();
+void test_concurrent_enqueue_dequeue();
+void test_contention_timing();
+
+int main (int argc, char** argv)
+{
+    test_enqueue_dequeue();
+    test_concurrent_enqueue_dequeue();
+    test_contention_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Dequeues the head of a SinglyLinkedList used as a queue behind a mutex.
+ */
+bool locked_dequeue(SinglyLinkedList<int> & list, std::mutex & mutex, int & data)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    if (list.head() == 0)
+        return false;
+
+    // The head is the first node with its data, so this is O(1).
+    data = list.head()->data();
+    list.remove(data);
+    return true;
+}
+
+
+// test functions
+
+
+void test_enqueue_dequeue()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    LockFreeQueue<int> queue;
+    for (int i = 0; i < 10; i++)
+        queue.enqueue(i);
+
+    std::cout << "Enqueued 0..9, dequeued:";
+    int data;
+    while (queue.dequeue(data))
+        std::cout << " " << data;
+    std::cout << std::endl;
+    std::cout << "Queue is " << (queue.empty() ? "empty" : "NOT empty") << std::endl;
+
+    // Leave some nodes behind for the destructor.
+    for (int i = 0; i < 5; i++)
+        queue.enqueue(i);
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Producers enqueue increasing values of their own while consumers dequeue
+ * them. Every value must be dequeued exactly once, and every consumer must
+ * see the values of each producer in increasing order.
+ */
+void test_concurrent_enqueue_dequeue()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 100000;
+    const int total = producers * per_producer;
+
+    LockFreeQueue<int> queue;
+    std::atomic<int> dequeued(0);
+    std::vector<std::vector<int> > seen(consumers);
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(std::thread([&queue, p]() {
+            for (int i = 0; i < per_producer; i++)
+                queue.enqueue(p * per_producer + i);
+        }));
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.push_back(std::thread([&queue, &dequeued, &seen, c]() {
+            int data;
+            while (dequeued.load() < total) {
+                if (queue.dequeue(data)) {
+                    seen[c].push_back(data);
+                    dequeued++;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    std::vector<int> times(total, 0);
+    bool ok = true;
+    for (int c = 0; c < consumers; c++) {
+        std::vector<int> last(producers, -1);
+        for (size_t i = 0; i < seen[c].size(); i++) {
+            int data = seen[c][i];
+            times[data]++;
+            ok = ok && data > last[data / per_producer];
+            last[data / per_producer] = data;
+        }
+    }
+    for (int i = 0; i < total; i++)
+        ok = ok && times[i] == 1;
+
+    std::cout << producers << " producers, " << consumers << " consumers, " << total
+            << " values dequeued exactly once and in order: " << (ok && queue.empty() ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Every thread enqueues and dequeues in turn, on the lock-free queue and on
+ * a SinglyLinkedList behind a global mutex, the way a shared work queue is
+ * used by workers that also produce work.
+ */
+void test_contention_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int total_pairs = 1 << 19;
+    int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+    std::cout << "threads\tlock-free (Mops/s)\tglobal mutex (Mops/s)" << std::endl;
+
+    for (int t = 0; t < 7; t++) {
+        int threads = thread_counts[t];
+        int pairs = total_pairs / threads;
+
+        LockFreeQueue<int> queue;
+        std::vector<std::thread> workers;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int w = 0; w < threads; w++) {
+            workers.push_back(std::thread([&queue, pairs]() {
+                int data;
+                for (int i = 0; i < pairs; i++) {
+                    queue.enqueue(i);
+                    queue.dequeue(data);
+                }
+            }));
+        }
+        for (int w = 0; w < threads; w++)
+            workers[w].join();
+        double lsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        SinglyLinkedList<int> list;
+        std::mutex mutex;
+        workers.clear();
+        start = std::chrono::steady_clock::now();
+        for (int w = 0; w < threads; w++) {
+            workers.push_back(std::thread([&list, &mutex, pairs]() {
+                int data;
+                for (int i = 0; i < pairs; i++) {
+                    {
+                        std::lock_guard<std::mutex> guard(mutex);
+                        list.append(new SinglyLinkedListNode<int>(i));
+                    }
+                    locked_dequeue(list, mutex, data);
+                }
+            }));
+        }
+        for (int w = 0; w < threads; w++)
+            workers[w].join();
+        double msecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        list.clear();
+
+        double done = 2.0 * pairs * threads / 1e6;
+        std::cout << threads << "\t" << done / lsecs << "\t\t\t" << done / msecs << std::endl;
+    }
+
+    std::cout << std::endl;
+}
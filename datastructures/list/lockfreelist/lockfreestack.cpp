@@ -0,0 +1,14 @@
+/**
+ * @class LockFreeStack
+ *
+ * @file lockfreestack.cpp
+ *
+ * @brief Lock-free stack class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "lockfreestack.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,161 @@
+#ifndef LOCKFREESTACK_H_
+#define LOCKFREESTACK_H_
+
+#include "hazardpointers.h"
+#include "lockfreelistnode.h"
+
+#include <atomic>
+
+/**
+ * @class LockFreeStack
+ *
+ * @file lockfreestack.h
+ *
+ * Lock-free stack class definition.
+ *
+ * <p>
+ * A LIFO stack that any number of threads can push to and pop from at once
+ * without a lock (R. K. Treiber, "Systems programming: coping with
+ * parallelism", 1986). The stack is a singly linked list of
+ * LockFreeListNode; a push links a new node in front of the head it has read
+ * and swings the head to it with a compare-and-swap, a pop swings the head
+ * to the next node the same way. A compare-and-swap fails only if another
+ * thread changed the head in the meantime, that is if another operation
+ * succeeded, so some thread always makes progress.
+ *
+ * A pop reads the next pointer of the head before swinging it, while another
+ * thread may have popped that head already. The head is therefore protected
+ * by a hazard pointer first, and popped nodes are retired rather than
+ * deleted (see hazardpointers.h). This also keeps a popped node's address
+ * from being reused while a slower thread still expects it at the head, so
+ * its compare-and-swap cannot succeed with a stale next pointer.
+ *
+ * All operations take O(1) time, plus the retries under contention. The
+ * single head pointer is still a point of contention: under heavy load
+ * every operation competes for the same cache line.
+ *
+ * @see lockfreequeue.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class LockFreeStack {
+public:
+    /**
+     * Default constructor.
+     */
+    LockFreeStack();
+
+    /**
+     * Destructor. Deletes all the nodes.
+     *
+     * Must not run concurrently with any other operation on the stack.
+     */
+    virtual ~LockFreeStack();
+
+    // -- getter methods
+
+    /**
+     * Checks whether the stack is empty. The answer may be outdated as soon
+     * as it is returned, if other threads are using the stack.
+     *
+     * @return <code>true</code> if the stack has no elements;
+     *         <code>false</code> otherwise.
+     */
+    inline bool empty() const { return m_head.load() == 0; }
+
+    // -- public methods
+
+    /**
+     * Pushes an element on the stack.
+     *
+     * @param[in] data
+     *     The element to be pushed.
+     */
+    void push(T data);
+
+    /**
+     * Pops the element on the top of the stack.
+     *
+     * @param[out] data
+     *     Set to the popped element if the stack was not empty.
+     *
+     * @return <code>true</code> if an element was popped;
+     *         <code>false</code> if the stack was empty.
+     */
+    bool pop(T & data);
+protected:
+private:
+    typedef LockFreeListNode<T> Node;
+
+    /**
+     * Pointer to the node on the top of the stack.
+     */
+    std::atomic<Node *> m_head;
+
+    /**
+     * Keeps the head on a cache line of its own.
+     */
+    char m_padding[64 - sizeof(std::atomic<Node *>)];
+
+    /**
+     * Protects the nodes being popped and reclaims the popped ones.
+     */
+    HazardPointers<Node> m_hazards;
+};
+
+
+template<class T>
+LockFreeStack<T>::LockFreeStack()
+    : m_head(0)
+{
+}
+
+
+template<class T>
+LockFreeStack<T>::~LockFreeStack()
+{
+    Node * node = m_head.load();
+
+    while (node != 0) {
+        Node * del = node;
+        node = node->next();
+        delete del;
+    }
+}
+
+
+template<class T>
+void LockFreeStack<T>::push(T data)
+{
+    Node * node = new Node(data);
+    Node * head = m_head.load(std::memory_order_relaxed);
+
+    // Nothing is dereferenced here, so no protection is needed.
+    do {
+        node->set_next(head);
+    } while (!m_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+
+template<class T>
+bool LockFreeStack<T>::pop(T & data)
+{
+    for (;;) {
+        Node * head = m_hazards.protect(0, m_head);
+        if (head == 0) {
+            m_hazards.clear();
+            return false;
+        }
+
+        if (m_head.compare_exchange_weak(head, head->next())) {
+            m_hazards.clear();
+            data = head->data();
+            m_hazards.retire(head);
+            return true;
+        }
+    }
+}
+
+#endif /* LOCKFREESTACK_H_ */
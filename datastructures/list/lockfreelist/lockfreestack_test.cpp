@@ -0,0 +1,204 @@
+/**
+ * @file lockfreestack_test.cpp
+ *
+ * Test unit for the lock-free stack class.
+ *
+ * @see lockfreestack.h lockfreestack.cpp lockfreelistnode.h
+ * lockfreelistnode.cpp hazardpointers.h hazardpointers.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "lockfreestack.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void test_push_pop();
+void test_concurrent_push_pop();
+void test_contention_timing();
+
+int main (int argc, char** argv)
+{
+    test_push_pop();
+    test_concurrent_push_pop();
+    test_contention_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Pops the head of a SinglyLinkedList used as a stack behind a mutex.
+ */
+bool locked_pop(SinglyLinkedList<int> & list, std::mutex & mutex, int & data)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    if (list.head() == 0)
+        return false;
+
+    // The head is the first node with its data, so this is O(1).
+    data = list.head()->data();
+    list.remove(data);
+    return true;
+}
+
+
+// test functions
+
+
+void test_push_pop()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    LockFreeStack<int> stack;
+    for (int i = 0; i < 10; i++)
+        stack.push(i);
+
+    std::cout << "Pushed 0..9, popped:";
+    int data;
+    while (stack.pop(data))
+        std::cout << " " << data;
+    std::cout << std::endl;
+    std::cout << "Stack is " << (stack.empty() ? "empty" : "NOT empty") << std::endl;
+
+    // Leave some nodes behind for the destructor.
+    for (int i = 0; i < 5; i++)
+        stack.push(i);
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Producers push disjoint ranges of values while consumers pop them. Every
+ * value must be popped exactly once.
+ */
+void test_concurrent_push_pop()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 100000;
+    const int total = producers * per_producer;
+
+    LockFreeStack<int> stack;
+    std::atomic<int> popped(0);
+    std::vector<std::vector<int> > seen(consumers);
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(std::thread([&stack, p]() {
+            for (int i = 0; i < per_producer; i++)
+                stack.push(p * per_producer + i);
+        }));
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.push_back(std::thread([&stack, &popped, &seen, c]() {
+            int data;
+            while (popped.load() < total) {
+                if (stack.pop(data)) {
+                    seen[c].push_back(data);
+                    popped++;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    std::vector<int> times(total, 0);
+    bool ok = true;
+    for (int c = 0; c < consumers; c++)
+        for (size_t i = 0; i < seen[c].size(); i++)
+            times[seen[c][i]]++;
+    for (int i = 0; i < total; i++)
+        ok = ok && times[i] == 1;
+
+    std::cout << producers << " producers, " << consumers << " consumers, " << total
+            << " values popped exactly once: " << (ok && stack.empty() ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Every thread pushes and pops in turn, on the lock-free stack and on a
+ * SinglyLinkedList behind a global mutex.
+ */
+void test_contention_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int total_pairs = 1 << 19;
+    int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+    std::cout << "threads\tlock-free (Mops/s)\tglobal mutex (Mops/s)" << std::endl;
+
+    for (int t = 0; t < 7; t++) {
+        int threads = thread_counts[t];
+        int pairs = total_pairs / threads;
+
+        LockFreeStack<int> stack;
+        std::vector<std::thread> workers;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int w = 0; w < threads; w++) {
+            workers.push_back(std::thread([&stack, pairs]() {
+                int data;
+                for (int i = 0; i < pairs; i++) {
+                    stack.push(i);
+                    stack.pop(data);
+                }
+            }));
+        }
+        for (int w = 0; w < threads; w++)
+            workers[w].join();
+        double lsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        SinglyLinkedList<int> list;
+        std::mutex mutex;
+        workers.clear();
+        start = std::chrono::steady_clock::now();
+        for (int w = 0; w < threads; w++) {
+            workers.push_back(std::thread([&list, &mutex, pairs]() {
+                int data;
+                for (int i = 0; i < pairs; i++) {
+                    {
+                        std::lock_guard<std::mutex> guard(mutex);
+                        list.prepend(new SinglyLinkedListNode<int>(i));
+                    }
+                    locked_pop(list, mutex, data);
+                }
+            }));
+        }
+        for (int w = 0; w < threads; w++)
+            workers[w].join();
+        double msecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        list.clear();
+
+        double done = 2.0 * pairs * threads / 1e6;
+        std::cout << threads << "\t" << done / lsecs << "\t\t\t" << done / msecs << std::endl;
+    }
+
+    std::cout << std::endl;
+}
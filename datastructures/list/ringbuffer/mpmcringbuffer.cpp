@@ -0,0 +1,14 @@
+/**
+ * @class MpmcRingBuffer
+ *
+ * @file mpmcringbuffer.cpp
+ *
+ * @brief Multi-producer/multi-consumer ring buffer class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "mpmcringbuffer.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,399 @@
+#ifndef MPMCRINGBUFFER_H_
+#define MPMCRINGBUFFER_H_
+
+#include "waitstrategy.h"
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class MpmcRingBuffer
+ *
+ * @file mpmcringbuffer.h
+ *
+ * Multi-producer/multi-consumer ring buffer class definition.
+ *
+ * <p>
+ * A bounded FIFO queue that any number of producers and consumers can use
+ * at once, stored in a contiguous array used circularly (D. Vyukov, "Bounded
+ * MPMC queue", 2010). Every slot carries a sequence number that says whose
+ * turn it is: a slot at position p (reduced modulo the capacity) is free for
+ * the producer of position p when its sequence is p, and holds the element
+ * for the consumer of position p when its sequence is p + 1. A producer
+ * claims a position by advancing the enqueue position with a
+ * compare-and-swap, writes its element and then sets the sequence to p + 1;
+ * a consumer claims a position the same way on the dequeue position, reads
+ * the element and sets the sequence to p + capacity, freeing the slot for
+ * the producer of the next round.
+ *
+ * Producers contend only on the enqueue position and consumers only on the
+ * dequeue position, each padded to a cache line of its own; a slot is
+ * touched by one producer and one consumer per round. No slot is ever
+ * reused by the wrong round, since its sequence keeps counting up, so there
+ * is no ABA problem. Nothing is allocated after construction.
+ *
+ * The queue is not lock-free in the strict sense: a thread stalled between
+ * claiming a position and setting its sequence holds up the consumers (or
+ * producers) of that slot, though not the other slots. The batch operations
+ * claim several consecutive positions with one compare-and-swap, which is
+ * the operation under contention. The blocking operations wait according to
+ * the wait strategy, a SpinWait by default (see waitstrategy.h).
+ *
+ * @see spscringbuffer.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T, class Wait = SpinWait>
+class MpmcRingBuffer {
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] capacity
+     *     The least number of elements the buffer must hold; rounded up to a
+     *     power of two, and at least 2.
+     */
+    MpmcRingBuffer(int capacity);
+
+    /**
+     * Destructor.
+     */
+    virtual ~MpmcRingBuffer();
+
+    // -- getter methods
+
+    /**
+     * Getter for the capacity.
+     *
+     * @return The number of elements the buffer can hold.
+     */
+    inline int capacity() const { return (int) m_mask + 1; }
+
+    // -- public methods
+
+    /**
+     * Appends an element, if the buffer is not full.
+     *
+     * @param[in] data
+     *     The element to be enqueued.
+     *
+     * @return <code>true</code> if the element was enqueued;
+     *         <code>false</code> if the buffer was full.
+     */
+    bool try_enqueue(const T & data);
+
+    /**
+     * Removes the element at the front, if the buffer is not empty.
+     *
+     * @param[out] data
+     *     Set to the dequeued element if the buffer was not empty.
+     *
+     * @return <code>true</code> if an element was dequeued;
+     *         <code>false</code> if the buffer was empty.
+     */
+    bool try_dequeue(T & data);
+
+    /**
+     * Appends an element, waiting while the buffer is full.
+     *
+     * @param[in] data
+     *     The element to be enqueued.
+     */
+    void enqueue(const T & data);
+
+    /**
+     * Removes the element at the front, waiting while the buffer is empty.
+     *
+     * @param[out] data
+     *     Set to the dequeued element.
+     */
+    void dequeue(T & data);
+
+    /**
+     * Appends as many elements of an array as there are consecutive free
+     * slots. The elements enqueued are consecutive in the queue.
+     *
+     * @param[in] data
+     *     The elements to be enqueued.
+     * @param[in] n
+     *     The number of elements in the array.
+     *
+     * @return The number of elements enqueued, from the start of the array.
+     */
+    int enqueue_batch(const T * data, int n);
+
+    /**
+     * Removes up to a number of consecutive elements from the front.
+     *
+     * @param[out] data
+     *     The array the dequeued elements are written to.
+     * @param[in] n
+     *     The size of the array.
+     *
+     * @return The number of elements dequeued.
+     */
+    int dequeue_batch(T * data, int n);
+protected:
+private:
+    /**
+     * Appends an element, if the buffer is not full, without notifying the
+     * wait strategy.
+     */
+    bool push(const T & data);
+
+    /**
+     * Removes the element at the front, if the buffer is not empty, without
+     * notifying the wait strategy.
+     */
+    bool pop(T & data);
+
+    /**
+     * A slot: the element and the sequence number that says whose turn it
+     * is.
+     */
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    /**
+     * Claims up to a number of consecutive positions whose cells are ready.
+     *
+     * @param[in] position
+     *     The enqueue or dequeue position.
+     * @param[in] ready
+     *     0 to claim free cells for producers; 1 to claim full cells for
+     *     consumers.
+     * @param[in] n
+     *     The most positions to claim.
+     * @param[out] first
+     *     Set to the first claimed position.
+     *
+     * @return The number of positions claimed.
+     */
+    int claim(std::atomic<size_t> & position, size_t ready, int n, size_t & first);
+
+    /**
+     * Rounds up to a power of two, at least 2.
+     */
+    static size_t round_capacity(int capacity);
+
+    /**
+     * Keeps the enqueue position off the line of whatever precedes the
+     * buffer.
+     */
+    char m_padding0[64];
+
+    /**
+     * The next position to enqueue at.
+     */
+    std::atomic<size_t> m_enqueue_position;
+
+    /**
+     * Keeps the producers' position and the consumers' apart.
+     */
+    char m_padding1[64];
+
+    /**
+     * The next position to dequeue from.
+     */
+    std::atomic<size_t> m_dequeue_position;
+
+    /**
+     * Keeps the consumers' position and the read-only fields apart.
+     */
+    char m_padding2[64];
+
+    /**
+     * The capacity minus one.
+     */
+    const size_t m_mask;
+
+    /**
+     * The slots.
+     */
+    Cell * m_cells;
+
+    /**
+     * How the blocking operations wait.
+     */
+    Wait m_wait;
+};
+
+
+template<class T, class Wait>
+MpmcRingBuffer<T, Wait>::MpmcRingBuffer(int capacity)
+    : m_enqueue_position(0), m_dequeue_position(0),
+      m_mask(round_capacity(capacity) - 1)
+{
+    m_cells = new Cell[m_mask + 1];
+    for (size_t i = 0; i <= m_mask; i++)
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+
+template<class T, class Wait>
+MpmcRingBuffer<T, Wait>::~MpmcRingBuffer()
+{
+    delete [] m_cells;
+}
+
+
+template<class T, class Wait>
+bool MpmcRingBuffer<T, Wait>::push(const T & data)
+{
+    size_t position;
+
+    if (claim(m_enqueue_position, 0, 1, position) == 0)
+        return false;
+
+    Cell & cell = m_cells[position & m_mask];
+    cell.data = data;
+    cell.sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+
+template<class T, class Wait>
+bool MpmcRingBuffer<T, Wait>::pop(T & data)
+{
+    size_t position;
+
+    if (claim(m_dequeue_position, 1, 1, position) == 0)
+        return false;
+
+    Cell & cell = m_cells[position & m_mask];
+    data = cell.data;
+    cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+    return true;
+}
+
+
+template<class T, class Wait>
+bool MpmcRingBuffer<T, Wait>::try_enqueue(const T & data)
+{
+    if (!push(data))
+        return false;
+
+    m_wait.notify();
+    return true;
+}
+
+
+template<class T, class Wait>
+bool MpmcRingBuffer<T, Wait>::try_dequeue(T & data)
+{
+    if (!pop(data))
+        return false;
+
+    m_wait.notify();
+    return true;
+}
+
+
+template<class T, class Wait>
+void MpmcRingBuffer<T, Wait>::enqueue(const T & data)
+{
+    // The attempts must not notify: a blocking wait makes them while it
+    // holds its mutex.
+    if (!push(data))
+        m_wait.wait([this, &data]() { return push(data); });
+    m_wait.notify();
+}
+
+
+template<class T, class Wait>
+void MpmcRingBuffer<T, Wait>::dequeue(T & data)
+{
+    if (!pop(data))
+        m_wait.wait([this, &data]() { return pop(data); });
+    m_wait.notify();
+}
+
+
+template<class T, class Wait>
+int MpmcRingBuffer<T, Wait>::enqueue_batch(const T * data, int n)
+{
+    size_t first;
+    int claimed = claim(m_enqueue_position, 0, n, first);
+
+    for (int i = 0; i < claimed; i++) {
+        Cell & cell = m_cells[(first + i) & m_mask];
+        cell.data = data[i];
+        cell.sequence.store(first + i + 1, std::memory_order_release);
+    }
+
+    if (claimed > 0)
+        m_wait.notify();
+    return claimed;
+}
+
+
+template<class T, class Wait>
+int MpmcRingBuffer<T, Wait>::dequeue_batch(T * data, int n)
+{
+    size_t first;
+    int claimed = claim(m_dequeue_position, 1, n, first);
+
+    for (int i = 0; i < claimed; i++) {
+        Cell & cell = m_cells[(first + i) & m_mask];
+        data[i] = cell.data;
+        cell.sequence.store(first + i + m_mask + 1, std::memory_order_release);
+    }
+
+    if (claimed > 0)
+        m_wait.notify();
+    return claimed;
+}
+
+
+template<class T, class Wait>
+int MpmcRingBuffer<T, Wait>::claim(std::atomic<size_t> & position, size_t ready, int n, size_t & first)
+{
+    first = position.load(std::memory_order_relaxed);
+    if (n <= 0)
+        return 0;
+
+    for (;;) {
+        // Count the ready cells from the position on. Their sequences can
+        // only be advanced by the owners of their positions, so they stay
+        // ready until claimed.
+        int count = 0;
+        while (count < n) {
+            size_t sequence = m_cells[(first + count) & m_mask].sequence.load(std::memory_order_acquire);
+            if (sequence != first + count + ready)
+                break;
+            count++;
+        }
+
+        if (count == 0) {
+            size_t sequence = m_cells[first & m_mask].sequence.load(std::memory_order_acquire);
+            // A sequence behind the position means a slot of the previous
+            // round is still taken: the buffer is full (or empty).
+            if ((ptrdiff_t) (sequence - (first + ready)) < 0)
+                return 0;
+            // Otherwise another thread has claimed the position already.
+            first = position.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (position.compare_exchange_weak(first, first + count, std::memory_order_relaxed))
+            return count;
+    }
+}
+
+
+template<class T, class Wait>
+size_t MpmcRingBuffer<T, Wait>::round_capacity(int capacity)
+{
+    size_t rounded = 2;
+
+    while (rounded < (size_t) capacity)
+        rounded <<= 1;
+
+    return rounded;
+}
+
+#endif /* MPMCRINGBUFFER_H_ */
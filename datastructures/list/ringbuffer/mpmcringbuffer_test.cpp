@@ -0,0 +1,315 @@
+/**
+ * @file mpmcringbuffer_test.cpp
+ *
+ * Test unit for the multi-producer/multi-consumer ring buffer class.
+ *
+ * @see mpmcringbuffer.h mpmcringbuffer.cpp waitstrategy.h waitstrategy.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "mpmcringbuffer.h"
+#include "../lockfreelist/lockfreequeue.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void test_try_enqueue_dequeue();
+void test_against_deque();
+void test_producers_consumers();
+void test_contention_timing();
+
+int main (int argc, char** argv)
+{
+    test_try_enqueue_dequeue();
+    test_against_deque();
+    test_producers_consumers();
+    test_contention_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Producers enqueue increasing values of their own, one or a batch at a
+ * time, while consumers dequeue them. Checks that every value is dequeued
+ * exactly once, and that every consumer sees the values of each producer in
+ * increasing order.
+ */
+template<class Wait>
+bool exchange(int producers, int consumers, int per_producer, int capacity, int batch)
+{
+    MpmcRingBuffer<int, Wait> buffer(capacity);
+    const int total = producers * per_producer;
+    std::atomic<int> dequeued(0);
+    std::vector<std::vector<int> > seen(consumers);
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(std::thread([&buffer, p, per_producer, batch]() {
+            std::vector<int> data(batch);
+            for (int i = 0; i < per_producer; ) {
+                int k = std::min(batch, per_producer - i);
+                if (k == 1) {
+                    buffer.enqueue(p * per_producer + i);
+                    i++;
+                    continue;
+                }
+                for (int j = 0; j < k; j++)
+                    data[j] = p * per_producer + i + j;
+                int moved = buffer.enqueue_batch(&data[0], k);
+                if (moved == 0)
+                    std::this_thread::yield();
+                i += moved;
+            }
+        }));
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.push_back(std::thread([&buffer, &dequeued, &seen, c, total, batch]() {
+            std::vector<int> data(batch);
+            while (dequeued.load() < total) {
+                int moved = buffer.dequeue_batch(&data[0], batch);
+                if (moved == 0)
+                    std::this_thread::yield();
+                seen[c].insert(seen[c].end(), data.begin(), data.begin() + moved);
+                dequeued += moved;
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    std::vector<int> times(total, 0);
+    bool ok = true;
+    for (int c = 0; c < consumers; c++) {
+        std::vector<int> last(producers, -1);
+        for (size_t i = 0; i < seen[c].size(); i++) {
+            int data = seen[c][i];
+            times[data]++;
+            ok = ok && data > last[data / per_producer];
+            last[data / per_producer] = data;
+        }
+    }
+    for (int i = 0; i < total; i++)
+        ok = ok && times[i] == 1;
+
+    int data;
+    return ok && !buffer.try_dequeue(data);
+}
+
+
+/**
+ * Dequeues the head of a SinglyLinkedList used as a queue behind a mutex.
+ */
+bool locked_dequeue(SinglyLinkedList<int> & list, std::mutex & mutex, int & data)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    if (list.head() == 0)
+        return false;
+
+    data = list.head()->data();
+    list.remove(data);
+    return true;
+}
+
+
+// test functions
+
+
+void test_try_enqueue_dequeue()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    MpmcRingBuffer<int> buffer(1);
+    std::cout << "Asked for 1 element, capacity is " << buffer.capacity() << std::endl;
+
+    MpmcRingBuffer<int> other(6);
+    int enqueued = 0;
+    while (other.try_enqueue(enqueued))
+        enqueued++;
+    std::cout << "Enqueued " << enqueued << " elements in a buffer of " << other.capacity()
+            << " before it was full" << std::endl;
+
+    std::cout << "Dequeued:";
+    int data;
+    while (other.try_dequeue(data))
+        std::cout << " " << data;
+    std::cout << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Runs random single and batch operations on one thread, against a
+ * std::deque.
+ */
+void test_against_deque()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    MpmcRingBuffer<int> buffer(16);
+    std::deque<int> expected;
+    int next = 0;
+    int data[16];
+    bool ok = true;
+
+    srand(4);
+    for (int step = 0; step < 20000 && ok; step++) {
+        int n = rand() % 17;
+        int room = buffer.capacity() - (int) expected.size();
+        switch (rand() % 4) {
+        case 0:
+            ok = buffer.try_enqueue(next) == (room > 0);
+            if (room > 0)
+                expected.push_back(next++);
+            break;
+        case 1:
+            for (int i = 0; i < n; i++)
+                data[i] = next + i;
+            ok = buffer.enqueue_batch(data, n) == std::min(n, room);
+            for (int i = 0; i < std::min(n, room); i++)
+                expected.push_back(next++);
+            break;
+        case 2:
+            if (buffer.try_dequeue(data[0])) {
+                ok = !expected.empty() && data[0] == expected.front();
+                if (ok)
+                    expected.pop_front();
+            }
+            else {
+                ok = expected.empty();
+            }
+            break;
+        default:
+            int moved = buffer.dequeue_batch(data, n);
+            ok = moved == std::min(n, (int) expected.size());
+            for (int i = 0; i < moved && ok; i++) {
+                ok = data[i] == expected.front();
+                expected.pop_front();
+            }
+            break;
+        }
+    }
+
+    std::cout << "20000 random operations, " << next << " elements through a buffer of "
+            << buffer.capacity() << ": " << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_producers_consumers()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    std::cout << "4 producers, 4 consumers, spinning, one at a time:   "
+            << (exchange<SpinWait>(4, 4, 100000, 64, 1) ? "ok" : "WRONG") << std::endl;
+    std::cout << "4 producers, 4 consumers, spinning, batches of 7:    "
+            << (exchange<SpinWait>(4, 4, 100000, 64, 7) ? "ok" : "WRONG") << std::endl;
+    std::cout << "8 producers, 2 consumers, blocking, tiny buffer:     "
+            << (exchange<BlockingWait>(8, 2, 20000, 2, 1) ? "ok" : "WRONG") << std::endl;
+    std::cout << "2 producers, 8 consumers, blocking, batches of 5:    "
+            << (exchange<BlockingWait>(2, 8, 50000, 16, 5) ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Every thread enqueues and dequeues in turn, on the ring buffer, on the
+ * linked LockFreeQueue and on a SinglyLinkedList behind a global mutex.
+ */
+void test_contention_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int total_pairs = 1 << 19;
+    int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+    std::cout << "threads\tring buffer (Mops/s)\tLockFreeQueue (Mops/s)\tglobal mutex (Mops/s)" << std::endl;
+
+    for (int t = 0; t < 7; t++) {
+        int threads = thread_counts[t];
+        int pairs = total_pairs / threads;
+
+        MpmcRingBuffer<int> buffer(1024);
+        std::vector<std::thread> workers;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int w = 0; w < threads; w++) {
+            workers.push_back(std::thread([&buffer, pairs]() {
+                int data;
+                for (int i = 0; i < pairs; i++) {
+                    buffer.enqueue(i);
+                    buffer.try_dequeue(data);
+                }
+            }));
+        }
+        for (int w = 0; w < threads; w++)
+            workers[w].join();
+        double rsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        LockFreeQueue<int> queue;
+        workers.clear();
+        start = std::chrono::steady_clock::now();
+        for (int w = 0; w < threads; w++) {
+            workers.push_back(std::thread([&queue, pairs]() {
+                int data;
+                for (int i = 0; i < pairs; i++) {
+                    queue.enqueue(i);
+                    queue.dequeue(data);
+                }
+            }));
+        }
+        for (int w = 0; w < threads; w++)
+            workers[w].join();
+        double qsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        SinglyLinkedList<int> list;
+        std::mutex mutex;
+        workers.clear();
+        start = std::chrono::steady_clock::now();
+        for (int w = 0; w < threads; w++) {
+            workers.push_back(std::thread([&list, &mutex, pairs]() {
+                int data;
+                for (int i = 0; i < pairs; i++) {
+                    {
+                        std::lock_guard<std::mutex> guard(mutex);
+                        list.append(new SinglyLinkedListNode<int>(i));
+                    }
+                    locked_dequeue(list, mutex, data);
+                }
+            }));
+        }
+        for (int w = 0; w < threads; w++)
+            workers[w].join();
+        double msecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        list.clear();
+
+        double done = 2.0 * pairs * threads / 1e6;
+        std::cout << threads << "\t" << done / rsecs << "\t\t\t" << done / qsecs
+                << "\t\t\t" << done / msecs << std::endl;
+    }
+
+    std::cout << std::endl;
+}
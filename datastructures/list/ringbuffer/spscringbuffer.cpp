@@ -0,0 +1,14 @@
+/**
+ * @class SpscRingBuffer
+ *
+ * @file spscringbuffer.cpp
+ *
+ * @brief Single-producer/single-consumer ring buffer class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "spscringbuffer.h"
+
+// Empty due to template implementation.
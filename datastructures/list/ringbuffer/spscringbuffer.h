@@ -0,0 +1,405 @@
+#ifndef SPSCRINGBUFFER_H_
+#define SPSCRINGBUFFER_H_
+
+#include "waitstrategy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class SpscRingBuffer
+ *
+ * @file spscringbuffer.h
+ *
+ * Single-producer/single-consumer ring buffer class definition.
+ *
+ * <p>
+ * A bounded FIFO queue for exactly one producer thread and one consumer
+ * thread, stored in a contiguous array used circularly. Unlike a linked
+ * queue, it allocates nothing per element, and consecutive elements share
+ * cache lines.
+ *
+ * The producer owns the tail index and the consumer the head index; both
+ * count up forever and are reduced modulo the capacity, a power of two, with
+ * a mask. Each side writes only its own index, with a release store after
+ * it has written or read the slots, and reads the other side's index with an
+ * acquire load; no read-modify-write instruction is needed. Reading the
+ * other side's index still pulls in a cache line the other side keeps
+ * writing, so each side caches the last value it read and reloads it only
+ * when the cached value says the buffer is full (for the producer) or empty
+ * (for the consumer). While the buffer is neither, the two threads do not
+ * touch each other's cache lines at all.
+ *
+ * The indices, the cached copies and the read-only fields are separated by
+ * a whole cache line of padding, so that they never share a line however
+ * the buffer is aligned in memory (<em>false sharing</em>).
+ *
+ * The batch operations move as many elements as they can with one index
+ * update, which amortizes the cache line transfer of the index over the
+ * batch. The blocking operations wait according to the wait strategy, a
+ * SpinWait by default (see waitstrategy.h).
+ *
+ * @see mpmcringbuffer.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T, class Wait = SpinWait>
+class SpscRingBuffer {
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] capacity
+     *     The least number of elements the buffer must hold; rounded up to a
+     *     power of two.
+     */
+    SpscRingBuffer(int capacity);
+
+    /**
+     * Destructor.
+     */
+    virtual ~SpscRingBuffer();
+
+    // -- getter methods
+
+    /**
+     * Getter for the capacity.
+     *
+     * @return The number of elements the buffer can hold.
+     */
+    inline int capacity() const { return (int) m_mask + 1; }
+
+    /**
+     * Getter for the number of elements. Exact only when neither side is
+     * running.
+     *
+     * @return The number of elements in the buffer.
+     */
+    inline int size() const { return (int) (m_tail.load() - m_head.load()); }
+
+    // -- public methods
+
+    /**
+     * Appends an element, if the buffer is not full. Producer only.
+     *
+     * @param[in] data
+     *     The element to be enqueued.
+     *
+     * @return <code>true</code> if the element was enqueued;
+     *         <code>false</code> if the buffer was full.
+     */
+    bool try_enqueue(const T & data);
+
+    /**
+     * Removes the element at the front, if the buffer is not empty.
+     * Consumer only.
+     *
+     * @param[out] data
+     *     Set to the dequeued element if the buffer was not empty.
+     *
+     * @return <code>true</code> if an element was dequeued;
+     *         <code>false</code> if the buffer was empty.
+     */
+    bool try_dequeue(T & data);
+
+    /**
+     * Appends an element, waiting while the buffer is full. Producer only.
+     *
+     * @param[in] data
+     *     The element to be enqueued.
+     */
+    void enqueue(const T & data);
+
+    /**
+     * Removes the element at the front, waiting while the buffer is empty.
+     * Consumer only.
+     *
+     * @param[out] data
+     *     Set to the dequeued element.
+     */
+    void dequeue(T & data);
+
+    /**
+     * Appends as many elements of an array as fit. Producer only.
+     *
+     * @param[in] data
+     *     The elements to be enqueued.
+     * @param[in] n
+     *     The number of elements in the array.
+     *
+     * @return The number of elements enqueued, from the start of the array;
+     *         0 if n is not positive.
+     */
+    int enqueue_batch(const T * data, int n);
+
+    /**
+     * Removes up to a number of elements from the front. Consumer only.
+     *
+     * @param[out] data
+     *     The array the dequeued elements are written to.
+     * @param[in] n
+     *     The size of the array.
+     *
+     * @return The number of elements dequeued; 0 if n is not positive.
+     */
+    int dequeue_batch(T * data, int n);
+protected:
+private:
+    /**
+     * Appends an element, if the buffer is not full, without notifying the
+     * wait strategy.
+     */
+    bool push(const T & data);
+
+    /**
+     * Removes the element at the front, if the buffer is not empty, without
+     * notifying the wait strategy.
+     */
+    bool pop(T & data);
+
+    /**
+     * Rounds up to a power of two.
+     */
+    static size_t round_capacity(int capacity);
+
+    /**
+     * Copies elements into the slots from a position on, wrapping around.
+     */
+    void copy_in(size_t position, const T * data, int n);
+
+    /**
+     * Copies elements out of the slots from a position on, wrapping around.
+     */
+    void copy_out(size_t position, T * data, int n);
+
+    /**
+     * Keeps the consumer's fields off the line of whatever precedes the
+     * buffer.
+     */
+    char m_padding0[64];
+
+    /**
+     * The position of the next element to dequeue. Written by the consumer.
+     */
+    std::atomic<size_t> m_head;
+
+    /**
+     * The consumer's copy of the tail.
+     */
+    size_t m_tail_cache;
+
+    /**
+     * Keeps the consumer's fields and the producer's apart.
+     */
+    char m_padding1[64];
+
+    /**
+     * The position of the next element to enqueue. Written by the producer.
+     */
+    std::atomic<size_t> m_tail;
+
+    /**
+     * The producer's copy of the head.
+     */
+    size_t m_head_cache;
+
+    /**
+     * Keeps the producer's fields and the read-only ones apart.
+     */
+    char m_padding2[64];
+
+    /**
+     * The capacity minus one.
+     */
+    const size_t m_mask;
+
+    /**
+     * The slots.
+     */
+    T * m_buffer;
+
+    /**
+     * How the blocking operations wait.
+     */
+    Wait m_wait;
+};
+
+
+template<class T, class Wait>
+SpscRingBuffer<T, Wait>::SpscRingBuffer(int capacity)
+    : m_head(0), m_tail_cache(0), m_tail(0), m_head_cache(0),
+      m_mask(round_capacity(capacity) - 1)
+{
+    m_buffer = new T[m_mask + 1];
+}
+
+
+template<class T, class Wait>
+SpscRingBuffer<T, Wait>::~SpscRingBuffer()
+{
+    delete [] m_buffer;
+}
+
+
+template<class T, class Wait>
+bool SpscRingBuffer<T, Wait>::push(const T & data)
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+
+    if (tail - m_head_cache > m_mask) {
+        m_head_cache = m_head.load(std::memory_order_acquire);
+        if (tail - m_head_cache > m_mask)
+            return false;
+    }
+
+    m_buffer[tail & m_mask] = data;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+
+template<class T, class Wait>
+bool SpscRingBuffer<T, Wait>::pop(T & data)
+{
+    size_t head = m_head.load(std::memory_order_relaxed);
+
+    if (head == m_tail_cache) {
+        m_tail_cache = m_tail.load(std::memory_order_acquire);
+        if (head == m_tail_cache)
+            return false;
+    }
+
+    data = m_buffer[head & m_mask];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+
+template<class T, class Wait>
+bool SpscRingBuffer<T, Wait>::try_enqueue(const T & data)
+{
+    if (!push(data))
+        return false;
+
+    m_wait.notify();
+    return true;
+}
+
+
+template<class T, class Wait>
+bool SpscRingBuffer<T, Wait>::try_dequeue(T & data)
+{
+    if (!pop(data))
+        return false;
+
+    m_wait.notify();
+    return true;
+}
+
+
+template<class T, class Wait>
+void SpscRingBuffer<T, Wait>::enqueue(const T & data)
+{
+    // The attempts must not notify: a blocking wait makes them while it
+    // holds its mutex.
+    if (!push(data))
+        m_wait.wait([this, &data]() { return push(data); });
+    m_wait.notify();
+}
+
+
+template<class T, class Wait>
+void SpscRingBuffer<T, Wait>::dequeue(T & data)
+{
+    if (!pop(data))
+        m_wait.wait([this, &data]() { return pop(data); });
+    m_wait.notify();
+}
+
+
+template<class T, class Wait>
+int SpscRingBuffer<T, Wait>::enqueue_batch(const T * data, int n)
+{
+    if (n <= 0)
+        return 0;
+
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t room = m_mask + 1 - (tail - m_head_cache);
+
+    if (room < (size_t) n) {
+        m_head_cache = m_head.load(std::memory_order_acquire);
+        room = m_mask + 1 - (tail - m_head_cache);
+    }
+
+    n = (int) std::min(room, (size_t) n);
+    if (n == 0)
+        return 0;
+
+    copy_in(tail, data, n);
+    m_tail.store(tail + n, std::memory_order_release);
+    m_wait.notify();
+    return n;
+}
+
+
+template<class T, class Wait>
+int SpscRingBuffer<T, Wait>::dequeue_batch(T * data, int n)
+{
+    if (n <= 0)
+        return 0;
+
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t used = m_tail_cache - head;
+
+    if (used < (size_t) n) {
+        m_tail_cache = m_tail.load(std::memory_order_acquire);
+        used = m_tail_cache - head;
+    }
+
+    n = (int) std::min(used, (size_t) n);
+    if (n == 0)
+        return 0;
+
+    copy_out(head, data, n);
+    m_head.store(head + n, std::memory_order_release);
+    m_wait.notify();
+    return n;
+}
+
+
+template<class T, class Wait>
+void SpscRingBuffer<T, Wait>::copy_in(size_t position, const T * data, int n)
+{
+    size_t start = position & m_mask;
+    size_t first = std::min((size_t) n, m_mask + 1 - start);
+
+    std::copy(data, data + first, m_buffer + start);
+    std::copy(data + first, data + n, m_buffer);
+}
+
+
+template<class T, class Wait>
+void SpscRingBuffer<T, Wait>::copy_out(size_t position, T * data, int n)
+{
+    size_t start = position & m_mask;
+    size_t first = std::min((size_t) n, m_mask + 1 - start);
+
+    std::copy(m_buffer + start, m_buffer + start + first, data);
+    std::copy(m_buffer, m_buffer + (n - first), data + first);
+}
+
+
+template<class T, class Wait>
+size_t SpscRingBuffer<T, Wait>::round_capacity(int capacity)
+{
+    size_t rounded = 1;
+
+    while (rounded < (size_t) capacity)
+        rounded <<= 1;
+
+    return rounded;
+}
+
+#endif /* SPSCRINGBUFFER_H_ */
@@ -0,0 +1,243 @@
+/**
+ * @file spscringbuffer_test.cpp
+ *
+ * Test unit for the single-producer/single-consumer ring buffer class.
+ *
+ * @see spscringbuffer.h spscringbuffer.cpp waitstrategy.h waitstrategy.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "spscringbuffer.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void test_try_enqueue_dequeue();
+void test_batch_wraparound();
+void test_producer_consumer();
+void test_throughput_timing();
+
+int main (int argc, char** argv)
+{
+    test_try_enqueue_dequeue();
+    test_batch_wraparound();
+    test_producer_consumer();
+    test_throughput_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Streams 0..n-1 from a producer thread to a consumer thread, one element or
+ * a batch at a time, and checks that the consumer gets them in order.
+ *
+ * @return The time taken in seconds, or a negative number if the consumer
+ *         got a wrong element.
+ */
+template<class Wait>
+double stream(int n, int capacity, int batch)
+{
+    SpscRingBuffer<int, Wait> buffer(capacity);
+    bool ok = true;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::thread producer([&buffer, n, batch]() {
+        if (batch == 1) {
+            for (int i = 0; i < n; i++)
+                buffer.enqueue(i);
+            return;
+        }
+        std::vector<int> data(batch);
+        for (int i = 0; i < n; ) {
+            int k = std::min(batch, n - i);
+            for (int j = 0; j < k; j++)
+                data[j] = i + j;
+            int sent = 0;
+            while (sent < k) {
+                int moved = buffer.enqueue_batch(&data[sent], k - sent);
+                if (moved == 0)
+                    std::this_thread::yield();
+                sent += moved;
+            }
+            i += k;
+        }
+    });
+    std::thread consumer([&buffer, &ok, n, batch]() {
+        int expected = 0;
+        if (batch == 1) {
+            int data;
+            for (int i = 0; i < n; i++) {
+                buffer.dequeue(data);
+                ok = ok && data == expected++;
+            }
+            return;
+        }
+        std::vector<int> data(batch);
+        while (expected < n) {
+            int moved = buffer.dequeue_batch(&data[0], batch);
+            if (moved == 0)
+                std::this_thread::yield();
+            for (int j = 0; j < moved; j++)
+                ok = ok && data[j] == expected++;
+        }
+    });
+    producer.join();
+    consumer.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return ok && buffer.size() == 0 ? secs : -1.0;
+}
+
+
+// test functions
+
+
+void test_try_enqueue_dequeue()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    SpscRingBuffer<int> buffer(5);
+    std::cout << "Asked for 5 elements, capacity is " << buffer.capacity() << std::endl;
+
+    int enqueued = 0;
+    while (buffer.try_enqueue(enqueued))
+        enqueued++;
+    std::cout << "Enqueued " << enqueued << " elements before the buffer was full" << std::endl;
+
+    std::cout << "Dequeued:";
+    int data;
+    while (buffer.try_dequeue(data))
+        std::cout << " " << data;
+    std::cout << std::endl;
+    std::cout << "Buffer size is " << buffer.size() << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Moves batches of odd sizes through a small buffer, so that they keep
+ * wrapping around its end.
+ */
+void test_batch_wraparound()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    SpscRingBuffer<int> buffer(16);
+    int in[16];
+    int out[16];
+    int next_in = 0;
+    int next_out = 0;
+    bool ok = true;
+
+    srand(3);
+    for (int round = 0; round < 10000 && ok; round++) {
+        int n = rand() % 17;
+        for (int i = 0; i < n; i++)
+            in[i] = next_in + i;
+        int room = buffer.capacity() - buffer.size();
+        int moved = buffer.enqueue_batch(in, n);
+        ok = moved == std::min(n, room);
+        next_in += moved;
+
+        n = rand() % 17;
+        int size = buffer.size();
+        moved = buffer.dequeue_batch(out, n);
+        ok = ok && moved == std::min(n, size);
+        for (int i = 0; i < moved; i++)
+            ok = ok && out[i] == next_out++;
+    }
+
+    std::cout << "10000 rounds of random batches, " << next_out << " elements through a buffer of "
+            << buffer.capacity() << ": " << (ok ? "ok" : "WRONG") << std::endl;
+
+    int size = buffer.size();
+    ok = buffer.enqueue_batch(in, -1) == 0 && buffer.dequeue_batch(out, -1) == 0 && buffer.size() == size;
+    std::cout << "Batches of -1 elements: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_producer_consumer()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1000000;
+
+    std::cout << "Spinning, one at a time:  " << (stream<SpinWait>(n, 64, 1) >= 0 ? "ok" : "WRONG") << std::endl;
+    std::cout << "Spinning, batches of 13:  " << (stream<SpinWait>(n, 64, 13) >= 0 ? "ok" : "WRONG") << std::endl;
+    std::cout << "Blocking, one at a time:  " << (stream<BlockingWait>(n, 64, 1) >= 0 ? "ok" : "WRONG") << std::endl;
+    std::cout << "Blocking, tiny buffer:    " << (stream<BlockingWait>(n, 2, 1) >= 0 ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Streams integers through the ring buffer and through a SinglyLinkedList
+ * behind a mutex, which allocates a node per element.
+ */
+void test_throughput_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1 << 24;
+    const int capacity = 1 << 12;
+
+    double single = stream<SpinWait>(n, capacity, 1);
+    double batched = stream<SpinWait>(n, capacity, 64);
+    double blocking = stream<BlockingWait>(n, capacity, 1);
+
+    SinglyLinkedList<int> list;
+    std::mutex mutex;
+    const int list_n = n / 8;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::thread producer([&list, &mutex, list_n]() {
+        for (int i = 0; i < list_n; i++) {
+            std::lock_guard<std::mutex> guard(mutex);
+            list.append(new SinglyLinkedListNode<int>(i));
+        }
+    });
+    std::thread consumer([&list, &mutex, list_n]() {
+        for (int i = 0; i < list_n; ) {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (list.head() != 0) {
+                list.remove(list.head()->data());
+                i++;
+            }
+        }
+    });
+    producer.join();
+    consumer.join();
+    double locked = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Elements streamed through a buffer of " << capacity << " (Mops/s, an op being an"
+            << " enqueue or a dequeue):" << std::endl;
+    std::cout << "SpscRingBuffer, spinning, one at a time:  " << 2.0 * n / single / 1e6 << std::endl;
+    std::cout << "SpscRingBuffer, spinning, batches of 64:  " << 2.0 * n / batched / 1e6 << std::endl;
+    std::cout << "SpscRingBuffer, blocking, one at a time:  " << 2.0 * n / blocking / 1e6 << std::endl;
+    std::cout << "SinglyLinkedList behind a mutex:          " << 2.0 * list_n / locked / 1e6 << std::endl;
+
+    std::cout << std::endl;
+}
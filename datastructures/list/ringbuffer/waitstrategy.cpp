@@ -0,0 +1,15 @@
+/**
+ * @class SpinWait
+ * @class BlockingWait
+ *
+ * @file waitstrategy.cpp
+ *
+ * @brief Wait strategy class implementations.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "waitstrategy.h"
+
+// Empty due to the inline implementation.
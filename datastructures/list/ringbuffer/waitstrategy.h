@@ -0,0 +1,144 @@
+#ifndef WAITSTRATEGY_H_
+#define WAITSTRATEGY_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class SpinWait
+ *
+ * @file waitstrategy.h
+ *
+ * Wait strategy class definitions.
+ *
+ * A wait strategy decides what a thread does while a ring buffer is full
+ * (for a producer) or empty (for a consumer). It has two methods:
+ * <code>wait(attempt)</code> calls the attempt, a functor that tries the
+ * operation once and returns whether it succeeded, until it succeeds, and
+ * <code>notify()</code> is called after every successful operation, so that
+ * a thread waiting on the other side can retry.
+ *
+ * SpinWait keeps retrying, and yields the processor after a number of failed
+ * attempts so that the other side gets to run when the threads share a
+ * core. It gives the lowest latency and costs nothing on the fast path, but
+ * a waiting thread burns its core.
+ *
+ * @see spscringbuffer.h mpmcringbuffer.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+class SpinWait {
+public:
+    /**
+     * Retries an operation until it succeeds.
+     *
+     * @param[in] attempt
+     *     Tries the operation once; returns <code>true</code> on success.
+     */
+    template<class Attempt>
+    void wait(Attempt attempt)
+    {
+        for (int spins = 0; !attempt(); spins++) {
+            if (spins >= SPINS)
+                std::this_thread::yield();
+        }
+    }
+
+    /**
+     * Does nothing: nobody sleeps.
+     */
+    inline void notify() {}
+protected:
+private:
+    /**
+     * The number of attempts before a waiting thread starts yielding.
+     */
+    static const int SPINS = 64;
+};
+
+
+/**
+ * @class BlockingWait
+ *
+ * Puts a waiting thread to sleep on a condition variable after a short spin,
+ * and wakes it when the other side makes progress. Waiting costs no
+ * processor time, at the price of a fence on every successful operation and
+ * a system call to wake a sleeper.
+ *
+ * A sleeper registers itself before it tries the operation for the last
+ * time, and <code>notify()</code> looks for sleepers only after the
+ * operation has been published; the fences between them make sure that
+ * either the sleeper sees the operation or the notifier sees the sleeper, so
+ * no wake-up is lost.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+class BlockingWait {
+public:
+    /**
+     * Default constructor.
+     */
+    BlockingWait() : m_sleepers(0) {}
+
+    /**
+     * Retries an operation until it succeeds, sleeping in between.
+     *
+     * @param[in] attempt
+     *     Tries the operation once; returns <code>true</code> on success.
+     */
+    template<class Attempt>
+    void wait(Attempt attempt)
+    {
+        for (int spins = 0; spins < SPINS; spins++) {
+            if (attempt())
+                return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_sleepers++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!attempt())
+            m_wakeup.wait(lock);
+        m_sleepers--;
+    }
+
+    /**
+     * Wakes the sleeping threads, if any.
+     */
+    inline void notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleepers.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_wakeup.notify_all();
+        }
+    }
+protected:
+private:
+    /**
+     * The number of attempts before a waiting thread goes to sleep.
+     */
+    static const int SPINS = 64;
+
+    /**
+     * The number of threads sleeping or about to sleep.
+     */
+    std::atomic<int> m_sleepers;
+
+    /**
+     * Guards the sleep, so that a wake-up cannot slip in between a failed
+     * attempt and the sleep.
+     */
+    std::mutex m_mutex;
+
+    /**
+     * Signalled when the other side makes progress.
+     */
+    std::condition_variable m_wakeup;
+};
+
+#endif /* WAITSTRATEGY_H_ */
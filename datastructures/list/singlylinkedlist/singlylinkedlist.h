@@ -2,8 +2,11 @@
 #define SINGLYLINKEDLIST_H_
 
 #include "singlylinkedlistnode.h"
+#include "singlylinkedlistnodepool.h"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 /**
  * @class SinglyLinkedList
@@ -105,6 +108,45 @@
  * but not the benefits of binary search, like in arrays, since we cannot
  * access the median element without traversing all the elements before it.
  *
+ * The list keeps a pointer to its last node and a count of its nodes, so
+ * that <tt>append</tt> takes constant time and a list of n elements can be
+ * built in O(n) time from either end.
+ *
+ * <h3>Node ownership</h3>
+ *
+ * A list constructed by default takes the nodes it is given: the caller
+ * allocates every node with <code>new</code>, and <tt>remove</tt> and
+ * <tt>clear</tt> <code>delete</code> them one by one. A list constructed
+ * with a slab size, or with a SinglyLinkedListNodePool, allocates its nodes
+ * itself, from a pool of its own or from the given one (typically the
+ * thread's own pool, SinglyLinkedListNodePool::local()). Such a list is
+ * filled with <tt>push_front</tt> and <tt>push_back</tt>, which take the
+ * data rather than a node, and emptied with <tt>pop_front</tt>,
+ * <tt>remove</tt> or <tt>clear</tt>, which give the nodes back to the pool.
+ * Once a pool has grown to the largest size the list reaches, pushes and
+ * pops do no heap allocation at all, and <tt>clear</tt> frees the slabs of a
+ * list's own pool in bulk, or hands the whole chain back to a shared pool in
+ * O(1) time.
+ *
+ * <h3>Batched lookups</h3>
+ *
+ * Looking up m keys with <tt>find_iterative</tt> walks the list m times, in
+ * O(nm) time. <tt>find_batch</tt> and <tt>predecessor_batch</tt> walk it
+ * once for all the keys instead: the keys are sorted into a probe set, which
+ * every node's data is looked up in by binary search, in O((n + m) log m)
+ * time; the walk stops as soon as every key has been found. They give the
+ * same answers as their one-key counterparts, provided that two data that
+ * are neither smaller than the other compare equal.
+ *
+ * A walk through a list is a chain of loads, each of which needs the
+ * address loaded before it. <tt>traverse</tt> requests the next node as soon
+ * as its address is known, so that fetching it overlaps with the work done
+ * on the current node, though an out-of-order core mostly does as much by
+ * itself. Given an array of nodes whose addresses are all known, such as
+ * those found by a batched lookup, it requests them PREFETCH_DISTANCE nodes
+ * ahead, which keeps several fetches in flight however long the work on
+ * each node takes.
+ *
  * @created Dec 11, 2012
  * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
  */
@@ -112,12 +154,37 @@ template<class T>
 class SinglyLinkedList {
 public:
     /**
-     * Default constructor.
+     * How many nodes ahead <tt>traverse</tt> requests the nodes of an array;
+     * enough to cover a memory access with the work on the nodes between.
+     */
+    static const int PREFETCH_DISTANCE = 8;
+
+    /**
+     * Default constructor. The caller allocates the nodes.
      */
     SinglyLinkedList();
 
     /**
-     * Destructor.
+     * Constructor for a list that allocates its nodes from a pool of its
+     * own.
+     *
+     * @param[in] slab_size
+     *     The number of nodes the pool allocates at a time.
+     */
+    explicit SinglyLinkedList(int slab_size);
+
+    /**
+     * Constructor for a list that allocates its nodes from a shared pool.
+     *
+     * @param[in] pool
+     *     The pool; must outlive the list, and be used by one thread at a
+     *     time.
+     */
+    explicit SinglyLinkedList(SinglyLinkedListNodePool<T> & pool);
+
+    /**
+     * Destructor. A list that allocates its nodes gives them back; a list
+     * that was given its nodes leaves them alone.
      */
     virtual ~SinglyLinkedList();
 
@@ -130,11 +197,36 @@ public:
      */
     inline SinglyLinkedListNode<T> * head() { return m_head; }
 
+    /**
+     * Getter for the list's tail.
+     *
+     * @return The list's last node; <code>null</code> if the list is empty.
+     */
+    inline SinglyLinkedListNode<T> * tail() { return m_tail; }
+
+    /**
+     * Getter for the list's size.
+     *
+     * @return The number of nodes in the list.
+     */
+    inline int size() { return m_size; }
+
+    /**
+     * Getter for the list's node pool.
+     *
+     * @return The pool the list's nodes are allocated from;
+     *         <code>null</code> if the caller allocates them.
+     */
+    inline SinglyLinkedListNodePool<T> * pool() { return m_pool; }
+
     // -- setter methods
     // -- public methods
 
     /**
      * Clear list.
+     *
+     * Exactly size() nodes are deleted, so this also works on a list that
+     * has been circulized.
      */
     void clear();
 
@@ -147,13 +239,46 @@ public:
     void prepend(SinglyLinkedListNode<T> * node);
 
     /**
-     * Appends the node given to the list's tail.
+     * Appends the node given to the list's tail. Takes O(1) time.
      *
      * @param[in] node
      *     The list node to be appended.
      */
     void append(SinglyLinkedListNode<T> * node);
 
+    /**
+     * Prepends a node with the given data, allocated from the list's pool.
+     * Takes O(1) time.
+     *
+     * @param[in] data
+     *     The data to be prepended.
+     *
+     * @return The new node.
+     */
+    SinglyLinkedListNode<T> * push_front(T data);
+
+    /**
+     * Appends a node with the given data, allocated from the list's pool.
+     * Takes O(1) time.
+     *
+     * @param[in] data
+     *     The data to be appended.
+     *
+     * @return The new node.
+     */
+    SinglyLinkedListNode<T> * push_back(T data);
+
+    /**
+     * Removes the head of the list. Takes O(1) time.
+     *
+     * @param[out] data
+     *     Set to the data of the head if the list is not empty.
+     *
+     * @return <code>true</code> if the head was removed;
+     *         <code>false</code> if the list was empty.
+     */
+    bool pop_front(T & data);
+
     /**
      * Finds the first node in the list that matches the data given.
      *
@@ -182,6 +307,22 @@ public:
      */
     SinglyLinkedListNode<T> * find_recursive(SinglyLinkedListNode<T> * head, T data);
 
+    /**
+     * Finds the first node that matches each of a number of data, in a
+     * single walk through the list.
+     *
+     * @param[in] keys
+     *     The data to search.
+     * @param[in] n
+     *     The number of data.
+     * @param[out] found
+     *     Set to what <tt>find_iterative</tt> returns for each of the data,
+     *     in the same order.
+     *
+     * @return The number of data found.
+     */
+    int find_batch(const T * keys, int n, SinglyLinkedListNode<T> ** found);
+
     SinglyLinkedListNode<T> * successor_iterative(T data);
     SinglyLinkedListNode<T> * successor_recursive(T data);
 
@@ -215,6 +356,20 @@ public:
      */
     SinglyLinkedListNode<T> * predecessor_recursive(SinglyLinkedListNode<T> * head, T data);
 
+    /**
+     * Finds the predecessor of the first node that matches each of a number
+     * of data, in a single walk through the list.
+     *
+     * @param[in] keys
+     *     The data to search for.
+     * @param[in] n
+     *     The number of data.
+     * @param[out] preds
+     *     Set to what <tt>predecessor_iterative</tt> returns for each of the
+     *     data, in the same order.
+     */
+    void predecessor_batch(const T * keys, int n, SinglyLinkedListNode<T> ** preds);
+
     /**
      * Removes the first element found with the given data.
      *
@@ -232,10 +387,34 @@ public:
     void revert();
 
     /**
-     * Sorts the list.
+     * Sorts the list. Takes O(n log n) time and O(1) extra space.
+     *
+     * This is a bottom-up merge sort on the links of the nodes. The nodes
+     * are taken off the head one by one and kept in a fixed array of sorted
+     * runs, the i-th of which is either empty or 2<sup>i</sup> nodes long,
+     * much like the digits of a binary counter: a new node is merged with
+     * run 0, the result with run 1 if that is taken, and so on, up to the
+     * first empty slot. At the end the runs are merged together. There is no
+     * recursion and no auxiliary storage besides the 64 slots, and the short
+     * runs are merged while their nodes are still in the cache. Since of two
+     * equal elements the one from the earlier run is always taken first, the
+     * sort is stable. Nodes are only relinked, never copied or reallocated.
      */
     void sort();
 
+    /**
+     * Sorts the list through an array of node pointers. Takes O(n log n)
+     * time and O(n) extra space.
+     *
+     * The nodes are gathered into an array, the array is sorted with
+     * <code>std::stable_sort</code> and the nodes are relinked in its order.
+     * Every node is visited twice, in list order; all the other accesses go
+     * to the contiguous array instead of chasing links, which pays off on
+     * long lists whose nodes are scattered across the heap, at the cost of
+     * an array of n pointers.
+     */
+    void sort_array();
+
     /**
      * Checks if the list is circular.
      *
@@ -254,19 +433,121 @@ public:
 
     /**
      * Find the <it>N</it>-th to last element in the list.
+     *
+     * Since the size of the list is known, this walks size() - n - 1 nodes
+     * from the head, once.
      */
     SinglyLinkedListNode<T> * nth_to_last(int n);
 
+    /**
+     * Calls a visitor on every node, in list order, requesting each node
+     * before the visitor is called on the one before it.
+     *
+     * @param[in] visit
+     *     Called with a pointer to each node.
+     */
+    template<class Visitor>
+    void traverse(Visitor visit);
+
+    /**
+     * Calls a visitor on the nodes of an array, in array order, requesting
+     * each node PREFETCH_DISTANCE nodes ahead.
+     *
+     * @param[in] nodes
+     *     The nodes; <code>null</code> entries are skipped.
+     * @param[in] n
+     *     The number of nodes.
+     * @param[in] visit
+     *     Called with a pointer to each node.
+     */
+    template<class Visitor>
+    static void traverse(SinglyLinkedListNode<T> * const * nodes, int n, Visitor visit);
+
     /**
      * Prints the list.
      */
     void print();
 protected:
 private:
+    /**
+     * Copy constructor; a list owns its nodes, and its pool if it made one.
+     */
+    SinglyLinkedList(const SinglyLinkedList<T> & other);
+
+    /**
+     * Assignment operator; a list owns its nodes, and its pool if it made
+     * one.
+     */
+    SinglyLinkedList<T> & operator=(const SinglyLinkedList<T> & other);
+
+    /**
+     * Merges two sorted lists, taking from the first one on ties.
+     *
+     * @param[in] left
+     *     The head of the first list.
+     * @param[in] right
+     *     The head of the second list.
+     *
+     * @return The head of the merged list.
+     */
+    static SinglyLinkedListNode<T> * merge(SinglyLinkedListNode<T> * left, SinglyLinkedListNode<T> * right);
+
+    /**
+     * Finds the first node that matches each of a number of data, and its
+     * predecessor, in a single walk; see <tt>find_batch</tt>. Either output
+     * may be <code>null</code>.
+     */
+    int lookup_batch(const T * keys, int n, SinglyLinkedListNode<T> ** found, SinglyLinkedListNode<T> ** preds);
+
+    /**
+     * Asks for the cache line of a node to be fetched, without waiting for
+     * it.
+     */
+    static inline void prefetch(const SinglyLinkedListNode<T> * node)
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(node);
+#else
+        (void) node;
+#endif
+    }
+
+    /**
+     * Allocates a node, from the pool if the list has one.
+     */
+    SinglyLinkedListNode<T> * create_node(T data);
+
+    /**
+     * Disposes of a node: back to the pool if the list has one, deleted
+     * otherwise.
+     */
+    void destroy_node(SinglyLinkedListNode<T> * node);
+
     /**
      * Pointer to the list's head.
      */
     SinglyLinkedListNode<T> * m_head;
+
+    /**
+     * Pointer to the list's last node.
+     */
+    SinglyLinkedListNode<T> * m_tail;
+
+    /**
+     * The number of nodes in the list.
+     */
+    int m_size;
+
+    /**
+     * The pool the nodes are allocated from; <code>null</code> if the caller
+     * allocates them.
+     */
+    SinglyLinkedListNodePool<T> * m_pool;
+
+    /**
+     * Whether the pool belongs to this list alone.
+     */
+    bool m_owns_pool;
 };
 
 
@@ -274,23 +555,67 @@ template<class T>
 SinglyLinkedList<T>::SinglyLinkedList()
 {
     m_head = 0;
+    m_tail = 0;
+    m_size = 0;
+    m_pool = 0;
+    m_owns_pool = false;
+}
+
+
+template<class T>
+SinglyLinkedList<T>::SinglyLinkedList(int slab_size)
+{
+    m_head = 0;
+    m_tail = 0;
+    m_size = 0;
+    m_pool = new SinglyLinkedListNodePool<T>(slab_size);
+    m_owns_pool = true;
+}
+
+
+template<class T>
+SinglyLinkedList<T>::SinglyLinkedList(SinglyLinkedListNodePool<T> & pool)
+{
+    m_head = 0;
+    m_tail = 0;
+    m_size = 0;
+    m_pool = &pool;
+    m_owns_pool = false;
 }
 
 
 template<class T>
 SinglyLinkedList<T>::~SinglyLinkedList()
 {
+    if (m_owns_pool)
+        delete m_pool;
+    else if (m_pool != 0)
+        clear();
 }
 
 
 template<class T>
 void SinglyLinkedList<T>::clear()
 {
-    while (m_head != 0) {
-        SinglyLinkedListNode<T> * del = m_head;
-        m_head = del->next();
-        delete del;
+    if (m_owns_pool) {
+        // Every node of the pool belongs to this list.
+        m_pool->reset();
+    }
+    else if (m_pool != 0) {
+        if (m_head != 0)
+            m_pool->release(m_head, m_tail);
+    }
+    else {
+        for (; m_size > 0; m_size--) {
+            SinglyLinkedListNode<T> * del = m_head;
+            m_head = del->next();
+            delete del;
+        }
     }
+
+    m_head = 0;
+    m_tail = 0;
+    m_size = 0;
 }
 
 
@@ -299,29 +624,62 @@ void SinglyLinkedList<T>::prepend(SinglyLinkedListNode<T> * node)
 {
     node->set_next(m_head);
     m_head = node;
+    if (m_tail == 0)
+        m_tail = node;
+    m_size++;
 }
 
 
 template<class T>
 void SinglyLinkedList<T>::append(SinglyLinkedListNode<T> * node)
 {
-    if (m_head == 0) {
-        node->set_next(0);
+    node->set_next(0);
+
+    if (m_tail == 0)
         m_head = node;
-        return;
-    }
+    else
+        m_tail->set_next(node);
 
-    SinglyLinkedListNode<T> * lln = m_head;
+    m_tail = node;
+    m_size++;
+}
 
-    while (lln != 0) {
-        if (lln->next() == 0) {
-            break;
-        }
-        lln = lln->next();
-    }
 
-    node->set_next(0);
-    lln->set_next(node);
+template<class T>
+SinglyLinkedListNode<T> * SinglyLinkedList<T>::push_front(T data)
+{
+    SinglyLinkedListNode<T> * node = create_node(data);
+
+    prepend(node);
+    return node;
+}
+
+
+template<class T>
+SinglyLinkedListNode<T> * SinglyLinkedList<T>::push_back(T data)
+{
+    SinglyLinkedListNode<T> * node = create_node(data);
+
+    append(node);
+    return node;
+}
+
+
+template<class T>
+bool SinglyLinkedList<T>::pop_front(T & data)
+{
+    if (m_head == 0)
+        return false;
+
+    SinglyLinkedListNode<T> * node = m_head;
+    data = node->data();
+    m_head = node->next();
+    if (node == m_tail)
+        m_tail = 0;
+    m_size--;
+
+    destroy_node(node);
+    return true;
 }
 
 
@@ -356,6 +714,13 @@ SinglyLinkedListNode<T> * SinglyLinkedList<T>::find_recursive(SinglyLinkedListNo
 }
 
 
+template<class T>
+int SinglyLinkedList<T>::find_batch(const T * keys, int n, SinglyLinkedListNode<T> ** found)
+{
+    return lookup_batch(keys, n, found, 0);
+}
+
+
 template<class T>
 SinglyLinkedListNode<T> * SinglyLinkedList<T>::successor_iterative(T data)
 {
@@ -395,6 +760,72 @@ SinglyLinkedListNode<T> * SinglyLinkedList<T>::predecessor_iterative(T data)
 }
 
 
+template<class T>
+void SinglyLinkedList<T>::predecessor_batch(const T * keys, int n, SinglyLinkedListNode<T> ** preds)
+{
+    lookup_batch(keys, n, 0, preds);
+}
+
+
+template<class T>
+int SinglyLinkedList<T>::lookup_batch(const T * keys, int n, SinglyLinkedListNode<T> ** found, SinglyLinkedListNode<T> ** preds)
+{
+    // The probe set: the distinct keys in order, each with the range of
+    // positions in <code>order</code> of the queries that ask for it.
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [keys](int one, int another) { return keys[one] < keys[another]; });
+
+    std::vector<T> probes;
+    std::vector<int> starts;
+    for (int i = 0; i < n; i++) {
+        if (i == 0 || keys[order[i - 1]] < keys[order[i]]) {
+            probes.push_back(keys[order[i]]);
+            starts.push_back(i);
+        }
+    }
+    starts.push_back(n);
+
+    for (int i = 0; i < n; i++) {
+        if (found != 0)
+            found[i] = 0;
+        if (preds != 0)
+            preds[i] = 0;
+    }
+
+    std::vector<char> done(probes.size(), 0);
+    int left = (int) probes.size();
+    int hits = 0;
+    SinglyLinkedListNode<T> * prev = 0;
+
+    for (SinglyLinkedListNode<T> * lln = m_head; lln != 0 && left > 0; prev = lln, lln = lln->next()) {
+        prefetch(lln->next());
+
+        T data = lln->data();
+        typename std::vector<T>::iterator it = std::lower_bound(probes.begin(), probes.end(), data);
+        if (it == probes.end() || data < *it)
+            continue;
+
+        int p = (int) (it - probes.begin());
+        if (done[p])
+            continue;
+        done[p] = 1;
+        left--;
+
+        for (int i = starts[p]; i < starts[p + 1]; i++) {
+            if (found != 0)
+                found[order[i]] = lln;
+            if (preds != 0)
+                preds[order[i]] = prev;
+            hits++;
+        }
+    }
+
+    return hits;
+}
+
+
 template<class T>
 SinglyLinkedListNode<T> * SinglyLinkedList<T>::predecessor_recursive(SinglyLinkedListNode<T> * head, T data)
 {
@@ -428,8 +859,11 @@ bool SinglyLinkedList<T>::remove(T data)
                 // to the next element...
                 m_head = curr->next();
             }
+            if (curr == m_tail)
+                m_tail = prev;
+            m_size--;
             // Delete the pointer to the node to be deleted.
-            delete curr;
+            destroy_node(curr);
             return true;
         }
         prev = curr;
@@ -458,6 +892,7 @@ void SinglyLinkedList<T>::revert()
         curr = step;
     }
 
+    m_tail = m_head;
     m_head = prev;
 }
 
@@ -468,35 +903,141 @@ void SinglyLinkedList<T>::sort()
     if (m_head == 0 || m_head->next() == 0)
         return;
 
-    bool swap = false;
-    do {
-        SinglyLinkedListNode<T> * prev = 0;
-        SinglyLinkedListNode<T> * curr = m_head;
-        SinglyLinkedListNode<T> * next = m_head->next();
-        swap = false;
-        while (next != 0) {
-            if (curr->data() > next->data()) {
-                swap = true;
-                curr->set_next(next->next());
-                next->set_next(curr);
-                if (prev != 0) {
-                    prev->set_next(next);
-                }
-                else {
-                    m_head = next;
-                }
-
-                SinglyLinkedListNode<T> * tmp = curr;
-                curr = next;
-                next = tmp;
-            }
+    // runs[i] is empty or a sorted run of 2^i nodes; the higher the slot,
+    // the earlier in the list its nodes were.
+    SinglyLinkedListNode<T> * runs[64] = { 0 };
+
+    while (m_head != 0) {
+        SinglyLinkedListNode<T> * run = m_head;
+        m_head = run->next();
+        run->set_next(0);
+
+        int i = 0;
+        for (; runs[i] != 0; i++) {
+            run = merge(runs[i], run);
+            runs[i] = 0;
+        }
+        runs[i] = run;
+    }
+
+    for (int i = 0; i < 64; i++) {
+        if (runs[i] != 0)
+            m_head = merge(runs[i], m_head);
+    }
+
+    // The merges do not report where the list ends.
+    m_tail = m_head;
+    while (m_tail->next() != 0)
+        m_tail = m_tail->next();
+}
+
+
+template<class T>
+template<class Visitor>
+void SinglyLinkedList<T>::traverse(Visitor visit)
+{
+    SinglyLinkedListNode<T> * lln = m_head;
+
+    while (lln != 0) {
+        SinglyLinkedListNode<T> * next = lln->next();
+        prefetch(next);
+        visit(lln);
+        lln = next;
+    }
+}
+
+
+template<class T>
+template<class Visitor>
+void SinglyLinkedList<T>::traverse(SinglyLinkedListNode<T> * const * nodes, int n, Visitor visit)
+{
+    for (int i = 0; i < n && i < PREFETCH_DISTANCE; i++)
+        if (nodes[i] != 0)
+            prefetch(nodes[i]);
+
+    for (int i = 0; i < n; i++) {
+        if (i + PREFETCH_DISTANCE < n && nodes[i + PREFETCH_DISTANCE] != 0)
+            prefetch(nodes[i + PREFETCH_DISTANCE]);
+        if (nodes[i] != 0)
+            visit(nodes[i]);
+    }
+}
+
+
+template<class T>
+void SinglyLinkedList<T>::sort_array()
+{
+    if (m_head == 0 || m_head->next() == 0)
+        return;
+
+    std::vector<SinglyLinkedListNode<T> *> nodes;
+    for (SinglyLinkedListNode<T> * lln = m_head; lln != 0; lln = lln->next())
+        nodes.push_back(lln);
+
+    std::stable_sort(nodes.begin(), nodes.end(),
+            [](SinglyLinkedListNode<T> * one, SinglyLinkedListNode<T> * another) {
+                return one->data() < another->data();
+            });
+
+    for (size_t i = 0; i + 1 < nodes.size(); i++)
+        nodes[i]->set_next(nodes[i + 1]);
+    nodes.back()->set_next(0);
+    m_head = nodes.front();
+    m_tail = nodes.back();
+}
 
-            prev = curr;
-            curr = next;
-            next = next->next();
 
+template<class T>
+SinglyLinkedListNode<T> * SinglyLinkedList<T>::merge(SinglyLinkedListNode<T> * left, SinglyLinkedListNode<T> * right)
+{
+    SinglyLinkedListNode<T> * head = 0;
+    SinglyLinkedListNode<T> * tail = 0;
+
+    while (left != 0 && right != 0) {
+        SinglyLinkedListNode<T> * node;
+        if (right->data() < left->data()) {
+            node = right;
+            right = right->next();
         }
-    } while (swap);
+        else {
+            node = left;
+            left = left->next();
+        }
+
+        if (tail != 0)
+            tail->set_next(node);
+        else
+            head = node;
+        tail = node;
+    }
+
+    SinglyLinkedListNode<T> * rest = left != 0 ? left : right;
+    if (tail != 0)
+        tail->set_next(rest);
+    else
+        head = rest;
+
+    return head;
+}
+
+
+template<class T>
+SinglyLinkedListNode<T> * SinglyLinkedList<T>::create_node(T data)
+{
+    if (m_pool != 0)
+        return m_pool->allocate(data);
+
+    return new SinglyLinkedListNode<T>(data);
+}
+
+
+template<class T>
+void SinglyLinkedList<T>::destroy_node(SinglyLinkedListNode<T> * node)
+{
+    if (m_pool != 0)
+        m_pool->release(node);
+    else
+        delete node;
 }
 
 
@@ -531,49 +1072,23 @@ bool SinglyLinkedList<T>::isCircular()
 template<class T>
 void SinglyLinkedList<T>::circulize()
 {
-    if (m_head)
-    {
-        SinglyLinkedListNode<T> * lln = m_head;
-
-        while(lln->next())
-        {
-            lln = lln->next();
-        }
-
-        lln->set_next(m_head);
-    }
+    if (m_tail)
+        m_tail->set_next(m_head);
 }
 
 
 template<class T>
 SinglyLinkedListNode<T> * SinglyLinkedList<T>::nth_to_last(int n)
 {
-    if (!m_head || n < 0)
+    if (n < 0 || n >= m_size)
         return 0;
 
-    SinglyLinkedListNode<T> * driver = m_head;
-    SinglyLinkedListNode<T> * sentinel = 0;
+    SinglyLinkedListNode<T> * lln = m_head;
 
-    while (n != 0 && driver->next())
-    {
-        driver = driver->next();
-        n--;
-    }
+    for (int i = m_size - n - 1; i > 0; i--)
+        lln = lln->next();
 
-    if (n == 0)
-    {
-        sentinel = m_head;
-        while (driver->next())
-        {
-            driver = driver->next();
-            sentinel = sentinel->next();
-        }
-        return sentinel;
-    }
-    else
-    {
-        return 0;
-    }
+    return lln;
 }
 
 
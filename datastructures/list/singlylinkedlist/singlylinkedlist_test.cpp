@@ -4,7 +4,8 @@
  * Test unit for the singly linked list class.
  *
  * @see singlylinkedlist.h singlylinkedlist.cpp singlylinkedlistnode.h
- * singlylinkedlistnode.cpp
+ * singlylinkedlistnode.cpp singlylinkedlistnodepool.h
+ * singlylinkedlistnodepool.cpp
  *
  * @created Dec 11, 2012
  * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
@@ -15,6 +16,8 @@
 #include <cstdlib>
 #include <iostream>
 #include <ctime>
+#include <chrono>
+#include <vector>
 
 void init_list_random();
 void init_list_std();
@@ -26,11 +29,21 @@ void test_find_iterative();
 void test_find_recursive();
 void test_predecessor_iterative();
 void test_predecessor_recursive();
+void test_find_batch();
+void test_find_batch_timing();
 void test_remove();
 void test_revert();
 void test_sort();
-//void test_isCircular();
+void test_sort_array();
+void test_sort_stable();
+void test_sort_timing();
+void test_isCircular();
 //void test_circulize();
+void test_size_tail();
+void test_append_timing();
+void test_node_pool();
+void test_node_pool_timing();
+void test_traverse_timing();
 void test_nth_to_last();
 void test_print();
 
@@ -45,11 +58,21 @@ int main (int argc, char** argv)
     test_find_recursive();
     test_predecessor_iterative();
     test_predecessor_recursive();
+    test_find_batch();
+    test_find_batch_timing();
     test_remove();
     test_revert();
     test_sort();
-//    test_isCircular();
+    test_sort_array();
+    test_sort_stable();
+    test_sort_timing();
+    test_isCircular();
 //    test_circulize();
+    test_size_tail();
+    test_append_timing();
+    test_node_pool();
+    test_node_pool_timing();
+    test_traverse_timing();
     test_nth_to_last();
     test_print();
 
@@ -104,6 +127,70 @@ void finalize_list()
 }
 
 
+/**
+ * Job with a priority to sort on and an id that tells equal jobs apart.
+ */
+struct Job
+{
+    int priority;
+    int id;
+
+    bool operator<(const Job & other) const
+    {
+        return priority < other.priority;
+    }
+};
+
+
+/**
+ * Checks that a list of jobs is sorted by priority, equal jobs in id order.
+ */
+bool is_sorted_stable(SinglyLinkedList<Job> & jobs)
+{
+    for (SinglyLinkedListNode<Job> * lln = jobs.head(); lln != 0 && lln->next() != 0; lln = lln->next()) {
+        Job one = lln->data();
+        Job another = lln->next()->data();
+        if (another.priority < one.priority
+                || (another.priority == one.priority && another.id < one.id))
+            return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * Checks that the size and the tail of a list match its nodes.
+ */
+bool is_consistent(SinglyLinkedList<int> & numbers)
+{
+    int count = 0;
+    SinglyLinkedListNode<int> * last = 0;
+    for (SinglyLinkedListNode<int> * lln = numbers.head(); lln != 0; lln = lln->next()) {
+        last = lln;
+        count++;
+    }
+
+    return count == numbers.size() && last == numbers.tail();
+}
+
+
+/**
+ * Checks that a list is sorted and returns the sum of its elements.
+ */
+bool is_sorted(SinglyLinkedList<int> & numbers, long & sum)
+{
+    sum = 0;
+    for (SinglyLinkedListNode<int> * lln = numbers.head(); lln != 0; lln = lln->next()) {
+        sum += lln->data();
+        if (lln->next() != 0 && lln->next()->data() < lln->data())
+            return false;
+    }
+
+    return true;
+}
+
+
 // test functions
 
 
@@ -378,6 +465,94 @@ void test_predecessor_recursive()
 }
 
 
+/**
+ * Compares batched lookups with one lookup per key, on a list with repeated
+ * data, for keys that repeat, are missing or are at the head.
+ */
+void test_find_batch()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    SinglyLinkedList<int> batched(64);
+    srand(12);
+    for (int i = 0; i < 2000; i++)
+        batched.push_back(rand() % 1500);
+
+    std::vector<int> keys;
+    keys.push_back(batched.head()->data());
+    keys.push_back(batched.tail()->data());
+    for (int i = 0; i < 3000; i++)
+        keys.push_back(rand() % 2000 - 100);
+    const int n = (int) keys.size();
+
+    std::vector<SinglyLinkedListNode<int> *> found(n);
+    std::vector<SinglyLinkedListNode<int> *> preds(n);
+    int hits = batched.find_batch(&keys[0], n, &found[0]);
+    batched.predecessor_batch(&keys[0], n, &preds[0]);
+
+    bool ok = true;
+    int expected_hits = 0;
+    for (int i = 0; i < n; i++) {
+        SinglyLinkedListNode<int> * one = batched.find_iterative(keys[i]);
+        expected_hits += one != 0;
+        ok = ok && found[i] == one && preds[i] == batched.predecessor_iterative(keys[i]);
+    }
+    std::cout << n << " keys looked up in one walk, " << hits << " found"
+            << (ok && hits == expected_hits ? " (ok)" : " (WRONG)") << std::endl;
+
+    SinglyLinkedList<int> empty(16);
+    ok = empty.find_batch(&keys[0], n, &found[0]) == 0 && found[0] == 0 && found[n - 1] == 0;
+    ok = ok && batched.find_batch(&keys[0], 0, &found[0]) == 0;
+    std::cout << "Empty list, no keys" << (ok ? " (ok)" : " (WRONG)") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Looks up every key of a reconciliation batch in the same list, one walk
+ * per key and in one walk for all.
+ */
+void test_find_batch_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    int sizes[] = { 1000, 10000, 30000 };
+
+    std::cout << "size/keys\tfind_iterative (s)\tfind_batch (s)" << std::endl;
+
+    for (int s = 0; s < 3; s++) {
+        const int n = sizes[s];
+        SinglyLinkedList<int> ledger(1024);
+        srand(13);
+        for (int i = 0; i < n; i++)
+            ledger.push_back(rand() % (2 * n));
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; i++)
+            keys[i] = rand() % (2 * n);
+
+        std::vector<SinglyLinkedListNode<int> *> one(n);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; i++)
+            one[i] = ledger.find_iterative(keys[i]);
+        double isecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<SinglyLinkedListNode<int> *> all(n);
+        start = std::chrono::steady_clock::now();
+        ledger.find_batch(&keys[0], n, &all[0]);
+        double bsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << n << "\t\t" << isecs << "\t\t" << bsecs << (one == all ? "" : " WRONG") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+
 void test_remove()
 {
     std::cout << "########################################" << std::endl;
@@ -454,26 +629,116 @@ void test_sort()
 }
 
 
-// ATTENTION: Broken finalization. KEEP DISABLED!
-//void test_isCircular()
-//{
-//    std::cout << "########################################" << std::endl;
-//    std::cout << __FUNCTION__ << std::endl;
-//    std::cout << "########################################" << std::endl;
-//
-//    init_list_std();
-//    std::cout << "isCirular = " << (list->isCircular() ? "yes" : "no") << std::endl;
-//    finalize_list();
-//
-//    init_list_random_circular();
-//    std::cout << "isCirular = " << (list->isCircular() ? "yes" : "no") << std::endl;
-//
-//    finalize_list();
-//    std::cout << std::endl;
-//}
+void test_sort_array()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    init_list_random();
+
+    std::cout << "Original list:" << std::endl;
+    list->print();
+
+    std::cout << "Sorted list:" << std::endl;
+    list->sort_array();
+    list->print();
+
+    finalize_list();
+    std::cout << std::endl;
+}
+
+
+void test_sort_stable()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    srand(5);
+    for (int mode = 0; mode < 2; mode++) {
+        bool ok = true;
+        for (int n = 0; n < 100 && ok; n++) {
+            SinglyLinkedList<Job> jobs;
+            for (int i = n - 1; i >= 0; i--) {
+                Job job = { rand() % 5, i };
+                jobs.prepend(new SinglyLinkedListNode<Job>(job));
+            }
+
+            if (mode == 0)
+                jobs.sort();
+            else
+                jobs.sort_array();
+
+            int count = 0;
+            for (SinglyLinkedListNode<Job> * lln = jobs.head(); lln != 0; lln = lln->next())
+                count++;
+            ok = count == n && is_sorted_stable(jobs);
+            jobs.clear();
+        }
+        std::cout << (mode == 0 ? "sort:       " : "sort_array: ")
+                << (ok ? "stable" : "NOT stable") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+
+void test_sort_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1000000;
+
+    for (int mode = 0; mode < 2; mode++) {
+        SinglyLinkedList<int> numbers;
+        long expected = 0;
+        srand(1);
+        for (int i = 0; i < n; i++) {
+            int random = rand();
+            expected += random;
+            numbers.prepend(new SinglyLinkedListNode<int>(random));
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (mode == 0)
+            numbers.sort();
+        else
+            numbers.sort_array();
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        long sum = 0;
+        bool sorted = is_sorted(numbers, sum);
+        std::cout << (mode == 0 ? "sort:       " : "sort_array: ") << n << " nodes in " << secs << "s"
+                << ((sorted && sum == expected) ? " (sorted)" : " (WRONG)") << std::endl;
+        numbers.clear();
+    }
+
+    std::cout << std::endl;
+}
+
+
+void test_isCircular()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    init_list_std();
+    std::cout << "isCirular = " << (list->isCircular() ? "yes" : "no") << std::endl;
+    finalize_list();
+
+    init_list_random_circular();
+    std::cout << "isCirular = " << (list->isCircular() ? "yes" : "no") << std::endl;
+
+    finalize_list();
+    std::cout << std::endl;
+}
 
 
-// ATTENTION: Broken finalization. KEEP DISABLED!
+// ATTENTION: print() never ends on a circular list. KEEP DISABLED!
 //void test_circulize()
 //{
 //    std::cout << "########################################" << std::endl;
@@ -490,6 +755,252 @@ void test_sort()
 //}
 
 
+void test_size_tail()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    init_list_std();
+    std::cout << "Prepended 11 nodes: size " << list->size() << ", tail " << list->tail()->data()
+            << (is_consistent(*list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    list->append(new SinglyLinkedListNode<int>(42));
+    std::cout << "Appended 42: size " << list->size() << ", tail " << list->tail()->data()
+            << (is_consistent(*list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    list->remove(42);
+    std::cout << "Removed tail: size " << list->size() << ", tail " << list->tail()->data()
+            << (is_consistent(*list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    list->remove(10);
+    list->remove(5);
+    std::cout << "Removed head and middle: size " << list->size() << ", tail " << list->tail()->data()
+            << (is_consistent(*list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    list->revert();
+    std::cout << "Reverted: size " << list->size() << ", tail " << list->tail()->data()
+            << (is_consistent(*list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    list->sort();
+    std::cout << "Sorted: size " << list->size() << ", tail " << list->tail()->data()
+            << (is_consistent(*list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    list->revert();
+    list->sort_array();
+    std::cout << "Sorted through an array: size " << list->size() << ", tail " << list->tail()->data()
+            << (is_consistent(*list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    list->clear();
+    std::cout << "Cleared: size " << list->size()
+            << ((list->head() == 0 && list->tail() == 0) ? " (ok)" : " (WRONG)") << std::endl;
+
+    list->append(new SinglyLinkedListNode<int>(1));
+    list->remove(1);
+    list->append(new SinglyLinkedListNode<int>(2));
+    std::cout << "Append to an emptied list: size " << list->size()
+            << (is_consistent(*list) ? " (ok)" : " (WRONG)") << std::endl;
+
+    finalize_list();
+    std::cout << std::endl;
+}
+
+
+void test_append_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1000000;
+    SinglyLinkedList<int> numbers;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+        numbers.append(new SinglyLinkedListNode<int>(i));
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << n << " appends in " << secs << "s: size " << numbers.size()
+            << ", 10-th to last " << numbers.nth_to_last(10)->data()
+            << (is_consistent(numbers) ? " (ok)" : " (WRONG)") << std::endl;
+    numbers.clear();
+
+    std::cout << std::endl;
+}
+
+
+void test_node_pool()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    SinglyLinkedList<int> own(16);
+    for (int i = 0; i < 10; i++)
+        own.push_back(i);
+    for (int i = 0; i < 10; i++)
+        own.push_front(-i);
+    own.remove(0);
+    own.remove(9);
+    own.print();
+
+    int data = 0;
+    bool ok = is_consistent(own);
+    for (int i = 9; i > 0; i--)
+        ok = ok && own.pop_front(data) && data == -i;
+    std::cout << "Popped -9..-1 from the front" << (ok && is_consistent(own) ? " (ok)" : " (WRONG)") << std::endl;
+    own.clear();
+    std::cout << "Cleared: size " << own.size() << (is_consistent(own) && !own.pop_front(data) ? " (ok)" : " (WRONG)")
+            << std::endl;
+
+    // Two lists sharing a pool: after a first round, the nodes one of them
+    // gives back are all the other one needs.
+    SinglyLinkedListNodePool<int> pool(64);
+    SinglyLinkedList<int> first(pool);
+    SinglyLinkedList<int> second(pool);
+    for (int i = 0; i < 1000; i++)
+        first.push_back(i);
+    int slabs = pool.slabs();
+    for (int round = 0; round < 100; round++) {
+        SinglyLinkedList<int> & from = round % 2 == 0 ? first : second;
+        SinglyLinkedList<int> & to = round % 2 == 0 ? second : first;
+        while (from.pop_front(data))
+            to.push_back(data);
+        ok = ok && is_consistent(to) && to.size() == 1000 && to.head()->data() == 0 && to.tail()->data() == 999;
+    }
+    std::cout << "100 rounds of moving 1000 nodes between lists on a shared pool: " << slabs << " slabs before, "
+            << pool.slabs() << " after" << (ok && slabs == pool.slabs() ? " (ok)" : " (WRONG)") << std::endl;
+
+    // The last round left the nodes in the first list.
+    first.clear();
+    for (int i = 0; i < 1000; i++)
+        second.push_front(i);
+    std::cout << "Cleared one list, refilled the other: " << pool.slabs() << " slabs"
+            << (pool.slabs() == slabs ? " (ok)" : " (WRONG)") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Runs a queue through cycles of pushes and pops, and builds and clears a
+ * long list, with nodes from the heap, from a pool of the list's own and
+ * from the thread's pool.
+ */
+void test_node_pool_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1000000;
+    const int cycles = 10;
+    const int depth = 1000;
+    const char * names[] = { "new/delete", "own pool", "thread pool" };
+
+    for (int mode = 0; mode < 3; mode++) {
+        SinglyLinkedList<int> * queue = mode == 0 ? new SinglyLinkedList<int>()
+                : mode == 1 ? new SinglyLinkedList<int>(256)
+                : new SinglyLinkedList<int>(SinglyLinkedListNodePool<int>::local());
+        long sum = 0;
+        int data;
+
+        // Keep depth elements queued, pushing one and popping one.
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < depth; i++)
+            queue->push_back(i);
+        for (int i = 0; i < cycles * n; i++) {
+            queue->push_back(i);
+            queue->pop_front(data);
+            sum += data;
+        }
+        double queue_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        queue->clear();
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < cycles; round++) {
+            for (int i = 0; i < n; i++)
+                queue->push_back(i);
+            queue->clear();
+        }
+        double build_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << names[mode] << ":\t" << cycles * n << " push/pop in " << queue_secs << "s, "
+                << cycles << " builds and clears of " << n << " in " << build_secs << "s (" << sum << ")" << std::endl;
+        delete queue;
+    }
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Does some work on every node of a list whose nodes are scattered by
+ * sorting it, with a plain walk and with traverse, and on the same nodes
+ * shuffled into an array, with a plain loop and with traverse.
+ */
+void test_traverse_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1 << 22;
+    SinglyLinkedList<int> scattered(4096);
+    srand(14);
+    for (int i = 0; i < n; i++)
+        scattered.push_back(rand());
+    scattered.sort();
+
+    // Stands for the work done on a node; a few dependent multiplications.
+    auto work = [](int data) {
+        unsigned int h = (unsigned int) data;
+        for (int k = 0; k < 32; k++)
+            h = h * 2654435761u + 1;
+        return h;
+    };
+
+    unsigned int plain_sum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (SinglyLinkedListNode<int> * node = scattered.head(); node != 0; node = node->next())
+        plain_sum += work(node->data());
+    double psecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    unsigned int prefetched_sum = 0;
+    start = std::chrono::steady_clock::now();
+    scattered.traverse([&](SinglyLinkedListNode<int> * node) { prefetched_sum += work(node->data()); });
+    double tsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Walking " << n << " scattered nodes:   " << psecs << "s" << std::endl;
+    std::cout << "Traversing with prefetching:      " << tsecs << "s"
+            << (plain_sum == prefetched_sum ? "" : " WRONG") << std::endl;
+
+    std::vector<SinglyLinkedListNode<int> *> nodes;
+    for (SinglyLinkedListNode<int> * node = scattered.head(); node != 0; node = node->next())
+        nodes.push_back(node);
+    srand(15);
+    for (int i = n - 1; i > 0; i--)
+        std::swap(nodes[i], nodes[rand() % (i + 1)]);
+
+    plain_sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+        plain_sum += work(nodes[i]->data());
+    psecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    prefetched_sum = 0;
+    start = std::chrono::steady_clock::now();
+    SinglyLinkedList<int>::traverse(&nodes[0], n, [&](SinglyLinkedListNode<int> * node) { prefetched_sum += work(node->data()); });
+    tsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Visiting " << n << " nodes in random order:  " << psecs << "s" << std::endl;
+    std::cout << "Visiting them with prefetching:   " << tsecs << "s"
+            << (plain_sum == prefetched_sum ? "" : " WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
 void test_nth_to_last()
 {
     std::cout << "########################################" << std::endl;
@@ -0,0 +1,14 @@
+/**
+ * @class SinglyLinkedListNodePool
+ *
+ * @file singlylinkedlistnodepool.cpp
+ *
+ * @brief Singly linked list node pool class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "singlylinkedlistnodepool.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,250 @@
+#ifndef SINGLYLINKEDLISTNODEPOOL_H_
+#define SINGLYLINKEDLISTNODEPOOL_H_
+
+#include "singlylinkedlistnode.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+template<class T>
+class ListRanker;
+
+/**
+ * @class SinglyLinkedListNodePool
+ *
+ * @file singlylinkedlistnodepool.h
+ *
+ * Singly linked list node pool class definition.
+ *
+ * Allocates SinglyLinkedListNode objects from <em>slabs</em>, blocks of
+ * memory holding many nodes each, and recycles the released nodes through
+ * a <em>free list</em> threaded through their own next pointers. A steady
+ * stream of allocations and releases thus runs off the free list without
+ * touching the heap; the heap is asked for a new slab only when the free
+ * list is empty and the last slab is used up, so n nodes cost n / S heap
+ * allocations for slabs of S nodes. The slabs are given back to the heap
+ * only all at once, by <tt>reset</tt> or by the destructor.
+ *
+ * Since the free list is linked through the nodes' next pointers, a whole
+ * chain of nodes, such as a list, is released in O(1) time by linking its
+ * last node to the free list. Released nodes are therefore kept constructed,
+ * data included, until they are reused or the pool is reset; a node is
+ * reconstructed with its new data when it is handed out again.
+ *
+ * A pool is not thread-safe. Every thread can have a pool of its own,
+ * <tt>local()</tt>, which is destroyed when the thread exits.
+ *
+ * @see singlylinkedlist.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class SinglyLinkedListNodePool {
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] slab_size
+     *     The number of nodes in a slab.
+     */
+    explicit SinglyLinkedListNodePool(int slab_size = 256);
+
+    /**
+     * Destructor. Destroys all the nodes and frees all the slabs; nodes
+     * still in use become invalid.
+     */
+    virtual ~SinglyLinkedListNodePool();
+
+    // -- getter methods
+
+    /**
+     * Getter for the number of slabs.
+     *
+     * @return The number of slabs allocated from the heap.
+     */
+    inline int slabs() const { return (int) m_slabs.size(); }
+
+    /**
+     * Getter for the slab size.
+     *
+     * @return The number of nodes in a slab.
+     */
+    inline int slab_size() const { return m_slab_size; }
+
+    // -- public methods
+
+    /**
+     * Hands out a node. Takes O(1) time.
+     *
+     * @param[in] data
+     *     The data of the node.
+     *
+     * @return A node holding the data, with a <code>null</code> next
+     *         pointer.
+     */
+    SinglyLinkedListNode<T> * allocate(T data);
+
+    /**
+     * Takes a node back. Takes O(1) time.
+     *
+     * @param[in] node
+     *     A node handed out by this pool.
+     */
+    void release(SinglyLinkedListNode<T> * node);
+
+    /**
+     * Takes a chain of nodes back. Takes O(1) time.
+     *
+     * @param[in] first
+     *     The first node of the chain.
+     * @param[in] last
+     *     The last node of the chain, reachable from the first one; its next
+     *     pointer is overwritten.
+     */
+    void release(SinglyLinkedListNode<T> * first, SinglyLinkedListNode<T> * last);
+
+    /**
+     * Destroys all the nodes and frees all the slabs. Takes O(n / S) heap
+     * deallocations for n nodes handed out in slabs of S; nodes still in use
+     * become invalid.
+     */
+    void reset();
+
+    /**
+     * The calling thread's pool, created on first use and destroyed when the
+     * thread exits.
+     *
+     * @return The pool of the calling thread.
+     */
+    static SinglyLinkedListNodePool<T> & local();
+protected:
+private:
+    /**
+     * Numbers the nodes of a pool through its slabs; see listranker.h.
+     */
+    friend class ListRanker<T>;
+
+    /**
+     * Getter for a slab.
+     *
+     * @param[in] i
+     *     The index of the slab, in [0, slabs()).
+     *
+     * @return The first node of the slab.
+     */
+    inline SinglyLinkedListNode<T> * slab(int i) const { return m_slabs[i]; }
+
+    /**
+     * Getter for the number of nodes of a slab that have been handed out.
+     * These nodes are constructed, whether they are in use or free, so
+     * their next pointers can be read; the rest of the slab is raw memory.
+     *
+     * @param[in] i
+     *     The index of the slab, in [0, slabs()).
+     *
+     * @return slab_size() for every slab but the last one.
+     */
+    inline int carved(int i) const { return i + 1 < slabs() ? m_slab_size : m_carved; }
+
+    /**
+     * Pointer to the first free node.
+     */
+    SinglyLinkedListNode<T> * m_free;
+
+    /**
+     * The slabs, each of m_slab_size nodes.
+     */
+    std::vector<SinglyLinkedListNode<T> *> m_slabs;
+
+    /**
+     * The number of nodes of the last slab that have been handed out.
+     */
+    int m_carved;
+
+    /**
+     * The number of nodes in a slab.
+     */
+    const int m_slab_size;
+};
+
+
+template<class T>
+SinglyLinkedListNodePool<T>::SinglyLinkedListNodePool(int slab_size)
+    : m_free(0), m_carved(0), m_slab_size(slab_size > 0 ? slab_size : 1)
+{
+}
+
+
+template<class T>
+SinglyLinkedListNodePool<T>::~SinglyLinkedListNodePool()
+{
+    reset();
+}
+
+
+template<class T>
+SinglyLinkedListNode<T> * SinglyLinkedListNodePool<T>::allocate(T data)
+{
+    SinglyLinkedListNode<T> * node = m_free;
+
+    if (node != 0) {
+        m_free = node->next();
+        node->~SinglyLinkedListNode<T>();
+    }
+    else {
+        if (m_slabs.empty() || m_carved == m_slab_size) {
+            void * slab = ::operator new(sizeof(SinglyLinkedListNode<T>) * m_slab_size);
+            m_slabs.push_back(static_cast<SinglyLinkedListNode<T> *>(slab));
+            m_carved = 0;
+        }
+        node = m_slabs.back() + m_carved++;
+    }
+
+    return new (node) SinglyLinkedListNode<T>(data);
+}
+
+
+template<class T>
+void SinglyLinkedListNodePool<T>::release(SinglyLinkedListNode<T> * node)
+{
+    node->set_next(m_free);
+    m_free = node;
+}
+
+
+template<class T>
+void SinglyLinkedListNodePool<T>::release(SinglyLinkedListNode<T> * first, SinglyLinkedListNode<T> * last)
+{
+    last->set_next(m_free);
+    m_free = first;
+}
+
+
+template<class T>
+void SinglyLinkedListNodePool<T>::reset()
+{
+    // Every node that was ever handed out is constructed, whether it is in
+    // use or on the free list.
+    for (size_t i = 0; i < m_slabs.size(); i++) {
+        int constructed = i + 1 < m_slabs.size() ? m_slab_size : m_carved;
+        for (int j = 0; j < constructed; j++)
+            m_slabs[i][j].~SinglyLinkedListNode<T>();
+        ::operator delete(m_slabs[i]);
+    }
+
+    m_slabs.clear();
+    m_free = 0;
+    m_carved = 0;
+}
+
+
+template<class T>
+SinglyLinkedListNodePool<T> & SinglyLinkedListNodePool<T>::local()
+{
+    static thread_local SinglyLinkedListNodePool<T> pool;
+    return pool;
+}
+
+#endif /* SINGLYLINKEDLISTNODEPOOL_H_ */
@@ -0,0 +1,14 @@
+/**
+ * @class ConcurrentSkipList
+ *
+ * @file concurrentskiplist.cpp
+ *
+ * @brief Concurrent skip list class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "concurrentskiplist.h"
+
+// Empty due to template implementation.
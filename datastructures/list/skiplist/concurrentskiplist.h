@@ -0,0 +1,309 @@
+#ifndef CONCURRENTSKIPLIST_H_
+#define CONCURRENTSKIPLIST_H_
+
+#include "skiplistnode.h"
+
+#include <atomic>
+
+/**
+ * @class ConcurrentSkipList
+ *
+ * @file concurrentskiplist.h
+ *
+ * Concurrent skip list class definition.
+ *
+ * <p>
+ * An ordered map of keys to values, like SkipList, that any number of
+ * threads can insert into and read from at once without a lock; the shape
+ * of an in-memory table that takes writes until it is full and is then
+ * dropped as a whole. Keys can be added but not removed, and a key's value
+ * is fixed once it is in: nodes are freed only by the destructor, so a
+ * reader never follows a link to freed memory and no reclamation scheme is
+ * needed.
+ *
+ * A node is published with a compare-and-swap on the level 0 link of its
+ * predecessor, after its own links have been set; from then on the key is
+ * in the list. It is linked into its higher levels bottom-up, one
+ * compare-and-swap each, searching again for the level's predecessor when
+ * another insert got there first. A reader that reaches a node on some level
+ * finds it on all the levels below, so searches, which only ever read,
+ * always see a well-formed list. Two inserts of the same key race on the
+ * same level 0 link; the loser finds the key on retrying, and returns
+ * <code>false</code>.
+ *
+ * Every thread draws node heights from a generator of its own. The level in
+ * use is raised with a compare-and-swap after linking; a search that reads
+ * a stale level starts lower down and only walks further.
+ *
+ * @see skiplist.h skiplistnode.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class K, class V>
+class ConcurrentSkipList {
+public:
+    /**
+     * The most levels a node can have; enough for 4^(MAX_LEVEL - 1) keys.
+     */
+    static const int MAX_LEVEL = 16;
+
+    /**
+     * Default constructor.
+     */
+    ConcurrentSkipList();
+
+    /**
+     * Destructor. Destroys all the nodes; no thread may be using the list.
+     */
+    virtual ~ConcurrentSkipList();
+
+    // -- getter methods
+
+    /**
+     * Getter for the list's size.
+     *
+     * @return The number of keys in the list; while inserts are running, a
+     *         number that was right a moment ago.
+     */
+    inline int size() const { return m_size.load(std::memory_order_relaxed); }
+
+    /**
+     * Getter for the list's level.
+     *
+     * @return The number of levels in use; at least 1.
+     */
+    inline int level() const { return m_level.load(std::memory_order_relaxed); }
+
+    /**
+     * Getter for the node with the smallest key; the walk on level 0 through
+     * <tt>next(0)</tt> visits the keys in increasing order, including some
+     * or all of those inserted while it runs.
+     *
+     * @return The first node; <code>null</code> if the list is empty.
+     */
+    inline SkipListNode<K, V> * first() const { return m_head->next(0); }
+
+    // -- public methods
+
+    /**
+     * Maps a key to a value, if the key is not in the list. Takes O(log n)
+     * expected time without contention; lock-free.
+     *
+     * @param[in] key
+     *     The key.
+     * @param[in] value
+     *     The value.
+     *
+     * @return <code>true</code> if the key was added; <code>false</code> if
+     *         it was in the list already, in which case its value is kept.
+     */
+    bool insert(const K & key, const V & value);
+
+    /**
+     * Finds the value of a key. Takes O(log n) expected time; wait-free.
+     *
+     * @param[in] key
+     *     The key.
+     *
+     * @return A pointer to the key's value; <code>null</code> if the key is
+     *         not in the list.
+     */
+    const V * find(const K & key) const;
+
+    /**
+     * Finds the first node whose key is not smaller than a given key, where
+     * an ordered walk over a range of keys starts. Takes O(log n) expected
+     * time; wait-free.
+     *
+     * @param[in] key
+     *     The key.
+     *
+     * @return The node; <code>null</code> if all the keys are smaller.
+     */
+    SkipListNode<K, V> * lower_bound(const K & key) const;
+protected:
+private:
+    /**
+     * Copy constructor; a list owns its nodes.
+     */
+    ConcurrentSkipList(const ConcurrentSkipList<K, V> & other);
+
+    /**
+     * Assignment operator; a list owns its nodes.
+     */
+    ConcurrentSkipList<K, V> & operator=(const ConcurrentSkipList<K, V> & other);
+
+    /**
+     * Searches for the first node whose key is not smaller than a given key.
+     *
+     * @param[in] key
+     *     The key.
+     * @param[in] top
+     *     The number of levels to search, from the highest down.
+     * @param[out] preds
+     *     If not <code>null</code>, set to the last node before the key on
+     *     each of the levels searched, the head if there is none.
+     * @param[out] succs
+     *     If not <code>null</code>, set to the node after preds[i] on each of
+     *     the levels searched.
+     *
+     * @return The node; <code>null</code> if all the keys are smaller.
+     */
+    SkipListNode<K, V> * find_greater_or_equal(const K & key, int top,
+            SkipListNode<K, V> ** preds, SkipListNode<K, V> ** succs) const;
+
+    /**
+     * Draws a node height from the calling thread's generator: 1, plus 1
+     * with probability 1/4 for every level up to MAX_LEVEL.
+     */
+    static int random_level();
+
+    /**
+     * The head sentinel, on all MAX_LEVEL levels; its key and value are
+     * unused.
+     */
+    SkipListNode<K, V> * const m_head;
+
+    /**
+     * The number of levels in use.
+     */
+    std::atomic<int> m_level;
+
+    /**
+     * The number of keys in the list.
+     */
+    std::atomic<int> m_size;
+};
+
+
+template<class K, class V>
+ConcurrentSkipList<K, V>::ConcurrentSkipList()
+    : m_head(SkipListNode<K, V>::create(K(), V(), MAX_LEVEL)), m_level(1), m_size(0)
+{
+}
+
+
+template<class K, class V>
+ConcurrentSkipList<K, V>::~ConcurrentSkipList()
+{
+    SkipListNode<K, V> * node = m_head;
+
+    while (node != 0) {
+        SkipListNode<K, V> * next = node->next(0);
+        SkipListNode<K, V>::destroy(node);
+        node = next;
+    }
+}
+
+
+template<class K, class V>
+bool ConcurrentSkipList<K, V>::insert(const K & key, const V & value)
+{
+    SkipListNode<K, V> * preds[MAX_LEVEL];
+    SkipListNode<K, V> * succs[MAX_LEVEL];
+    SkipListNode<K, V> * node = 0;
+    int height = random_level();
+    int top = level() > height ? level() : height;
+
+    // Publish the node on level 0; from here on the key is in the list.
+    for (;;) {
+        SkipListNode<K, V> * found = find_greater_or_equal(key, top, preds, succs);
+        if (found != 0 && !(key < found->key())) {
+            if (node != 0)
+                SkipListNode<K, V>::destroy(node);
+            return false;
+        }
+
+        if (node == 0)
+            node = SkipListNode<K, V>::create(key, value, height);
+        for (int i = 0; i < height; i++)
+            node->set_next(i, succs[i]);
+
+        if (preds[0]->cas_next(0, succs[0], node))
+            break;
+    }
+    m_size.fetch_add(1, std::memory_order_relaxed);
+
+    // Link the higher levels bottom-up. A failed compare-and-swap means
+    // another node came in next to this one on that level; search again for
+    // the neighbours there, which no other insert of this key can take.
+    for (int i = 1; i < height; i++) {
+        while (!preds[i]->cas_next(i, succs[i], node)) {
+            find_greater_or_equal(key, height, preds, succs);
+            node->set_next(i, succs[i]);
+        }
+    }
+
+    int level = m_level.load(std::memory_order_relaxed);
+    while (level < height && !m_level.compare_exchange_weak(level, height, std::memory_order_relaxed))
+        ;
+
+    return true;
+}
+
+
+template<class K, class V>
+const V * ConcurrentSkipList<K, V>::find(const K & key) const
+{
+    SkipListNode<K, V> * node = find_greater_or_equal(key, level(), 0, 0);
+
+    if (node == 0 || key < node->key())
+        return 0;
+
+    return &node->value();
+}
+
+
+template<class K, class V>
+SkipListNode<K, V> * ConcurrentSkipList<K, V>::lower_bound(const K & key) const
+{
+    return find_greater_or_equal(key, level(), 0, 0);
+}
+
+
+template<class K, class V>
+SkipListNode<K, V> * ConcurrentSkipList<K, V>::find_greater_or_equal(const K & key, int top,
+        SkipListNode<K, V> ** preds, SkipListNode<K, V> ** succs) const
+{
+    SkipListNode<K, V> * pred = m_head;
+    SkipListNode<K, V> * next = 0;
+
+    for (int i = top - 1; i >= 0; i--) {
+        next = pred->next(i);
+        while (next != 0 && next->key() < key) {
+            pred = next;
+            next = pred->next(i);
+        }
+        if (preds != 0) {
+            preds[i] = pred;
+            succs[i] = next;
+        }
+    }
+
+    return next;
+}
+
+
+template<class K, class V>
+int ConcurrentSkipList<K, V>::random_level()
+{
+    static std::atomic<unsigned int> threads(0);
+    static thread_local unsigned int seed = (2463534242u + 2654435769u * threads.fetch_add(1)) | 1;
+
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    // Two bits per level: each pair of zeros is a 1/4 chance to go higher.
+    unsigned int bits = seed;
+    int height = 1;
+    while (height < MAX_LEVEL && (bits & 3) == 0) {
+        bits >>= 2;
+        height++;
+    }
+
+    return height;
+}
+
+#endif /* CONCURRENTSKIPLIST_H_ */
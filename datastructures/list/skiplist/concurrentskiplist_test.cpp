@@ -0,0 +1,263 @@
+/**
+ * @file concurrentskiplist_test.cpp
+ *
+ * Test unit for the concurrent skip list class.
+ *
+ * @see concurrentskiplist.h concurrentskiplist.cpp skiplistnode.h
+ * skiplistnode.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "concurrentskiplist.h"
+#include "skiplist.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void test_single_thread();
+void test_concurrent_inserts();
+void test_readers_during_inserts();
+void test_insert_timing();
+
+int main (int argc, char** argv)
+{
+    test_single_thread();
+    test_concurrent_inserts();
+    test_readers_during_inserts();
+    test_insert_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Checks that the keys are strictly increasing on every level, and that a
+ * node on a level is on all the levels below.
+ */
+bool is_sorted(ConcurrentSkipList<int, int> & list, int & count)
+{
+    count = 0;
+    for (SkipListNode<int, int> * node = list.first(); node != 0; node = node->next(0)) {
+        for (int i = 0; i < node->height(); i++) {
+            SkipListNode<int, int> * next = node->next(i);
+            if (next != 0 && (next->key() <= node->key() || next->height() <= i))
+                return false;
+        }
+        count++;
+    }
+
+    return true;
+}
+
+
+/**
+ * A scrambled but deterministic key for a number.
+ */
+int scramble(int i)
+{
+    unsigned int x = ((unsigned int) i * 2654435761u) & 0x7fffffff;
+
+    return (int) (x ^ (x >> 16));
+}
+
+
+// test functions
+
+
+void test_single_thread()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    ConcurrentSkipList<int, int> list;
+    for (int i = 0; i < 20; i++)
+        list.insert((i * 7) % 20 * 5, i);
+
+    std::cout << "HEAD -> ";
+    for (SkipListNode<int, int> * node = list.first(); node != 0; node = node->next(0))
+        std::cout << "| " << node->key() << " | -> ";
+    std::cout << "NULL" << std::endl;
+
+    std::cout << "Inserting 35 again: " << (list.insert(35, 99) ? "added" : "kept")
+            << ", value " << *list.find(35) << std::endl;
+    std::cout << "Finding 36: " << (list.find(36) ? "found" : "not found") << std::endl;
+    std::cout << "First key not below 36: " << list.lower_bound(36)->key() << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Threads insert overlapping ranges of keys at once; every key must be added
+ * exactly once, whichever thread wins it.
+ */
+void test_concurrent_inserts()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int threads = 8;
+    const int per_thread = 50000;
+    ConcurrentSkipList<int, int> list;
+    std::atomic<int> added(0);
+    std::vector<std::thread> workers;
+
+    // Thread t inserts numbers [t * per_thread / 2, (t + 2) * per_thread / 2),
+    // so every number but those of the ends is tried by two threads.
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(std::thread([&list, &added, t, per_thread]() {
+            int mine = 0;
+            for (int i = 0; i < per_thread; i++) {
+                int number = t * per_thread / 2 + i;
+                if (list.insert(scramble(number), number))
+                    mine++;
+            }
+            added += mine;
+        }));
+    }
+    for (int t = 0; t < threads; t++)
+        workers[t].join();
+
+    const int distinct = (threads + 1) * per_thread / 2;
+    int count;
+    bool ok = is_sorted(list, count) && count == distinct && list.size() == distinct && added == distinct;
+    for (int number = 0; number < distinct && ok; number++) {
+        const int * value = list.find(scramble(number));
+        ok = value != 0 && *value == number;
+    }
+
+    std::cout << threads << " threads, " << threads * per_thread << " inserts of " << distinct
+            << " keys, " << list.level() << " levels: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Readers walk the list and look up keys while writers insert; a reader must
+ * always see sorted keys, and find every key inserted before it started.
+ */
+void test_readers_during_inserts()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int writers = 4;
+    const int readers = 4;
+    const int per_writer = 50000;
+    const int preloaded = 10000;
+    ConcurrentSkipList<int, int> list;
+    std::atomic<int> running(writers);
+    std::atomic<bool> ok(true);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < preloaded; i++)
+        list.insert(scramble(i), i);
+
+    for (int w = 0; w < writers; w++) {
+        threads.push_back(std::thread([&list, &running, w, per_writer, preloaded]() {
+            for (int i = 0; i < per_writer; i++) {
+                int number = preloaded + w * per_writer + i;
+                list.insert(scramble(number), number);
+            }
+            running--;
+        }));
+    }
+    for (int r = 0; r < readers; r++) {
+        threads.push_back(std::thread([&list, &running, &ok, r, preloaded]() {
+            int probe = r;
+            while (running.load() > 0) {
+                int last = -1;
+                for (SkipListNode<int, int> * node = list.first(); node != 0; node = node->next(0)) {
+                    if (node->key() <= last || scramble(node->value()) != node->key())
+                        ok = false;
+                    last = node->key();
+                }
+                for (int i = 0; i < 1000; i++) {
+                    probe = (probe + 7919) % preloaded;
+                    const int * value = list.find(scramble(probe));
+                    if (value == 0 || *value != probe)
+                        ok = false;
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    int count;
+    std::cout << writers << " writers, " << readers << " readers: "
+            << (ok && is_sorted(list, count) && count == preloaded + writers * per_writer ? "ok" : "WRONG")
+            << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Every thread inserts keys of its own, into the concurrent list and into a
+ * SkipList behind a global mutex.
+ */
+void test_insert_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int total = 1 << 19;
+    int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+    std::cout << "threads\tConcurrentSkipList (Mops/s)\tglobal mutex (Mops/s)" << std::endl;
+
+    for (int t = 0; t < 7; t++) {
+        int threads = thread_counts[t];
+        int per_thread = total / threads;
+
+        ConcurrentSkipList<int, int> concurrent;
+        std::vector<std::thread> workers;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int w = 0; w < threads; w++) {
+            workers.push_back(std::thread([&concurrent, w, per_thread]() {
+                for (int i = 0; i < per_thread; i++)
+                    concurrent.insert(scramble(w * per_thread + i), i);
+            }));
+        }
+        for (int w = 0; w < threads; w++)
+            workers[w].join();
+        double csecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        SkipList<int, int> locked;
+        std::mutex mutex;
+        workers.clear();
+        start = std::chrono::steady_clock::now();
+        for (int w = 0; w < threads; w++) {
+            workers.push_back(std::thread([&locked, &mutex, w, per_thread]() {
+                for (int i = 0; i < per_thread; i++) {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    locked.insert(scramble(w * per_thread + i), i);
+                }
+            }));
+        }
+        for (int w = 0; w < threads; w++)
+            workers[w].join();
+        double msecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double done = (double) per_thread * threads / 1e6;
+        std::cout << threads << "\t" << done / csecs << "\t\t\t\t" << done / msecs << std::endl;
+    }
+
+    std::cout << std::endl;
+}
@@ -0,0 +1,14 @@
+/**
+ * @class SkipList
+ *
+ * @file skiplist.cpp
+ *
+ * @brief Skip list class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "skiplist.h"
+
+// Empty due to template implementation.
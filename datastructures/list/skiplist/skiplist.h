@@ -0,0 +1,326 @@
+#ifndef SKIPLIST_H_
+#define SKIPLIST_H_
+
+#include "skiplistnode.h"
+
+/**
+ * @class SkipList
+ *
+ * @file skiplist.h
+ *
+ * Skip list class definition.
+ *
+ * <p>
+ * An ordered map of keys to values kept as a sorted singly linked list with
+ * express lanes (W. Pugh, "Skip lists: a probabilistic alternative to
+ * balanced trees", 1990). Every node is on level 0, the list of all the
+ * nodes in key order; a node on level i is also on level i + 1 with
+ * probability 1/4, so level i links about n / 4^i nodes. A search starts on
+ * the highest level and drops a level whenever the next key is not smaller
+ * than the one sought, skipping past about three nodes per level on
+ * average; <tt>insert</tt>, <tt>find</tt> and <tt>remove</tt> take
+ * O(log n) expected time, against the O(n) of keeping a SinglyLinkedList
+ * sorted. Level 0 is walked in key order from <tt>first</tt>.
+ *
+ * The levels are chosen at random when the node is inserted, so no
+ * rebalancing is ever needed and the running time depends on the generator
+ * rather than on the order of the keys. The nodes keep their links inline
+ * (see skiplistnode.h), so following a link reads the key beside it.
+ *
+ * Keys are compared with <code>operator&lt;</code>; two keys are equal if
+ * neither is smaller. The list is not thread-safe; ConcurrentSkipList takes
+ * inserts from many threads at once.
+ *
+ * @see skiplistnode.h concurrentskiplist.h singlylinkedlist.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class K, class V>
+class SkipList {
+public:
+    /**
+     * The most levels a node can have; enough for 4^(MAX_LEVEL - 1) keys.
+     */
+    static const int MAX_LEVEL = 16;
+
+    /**
+     * Default constructor.
+     */
+    SkipList();
+
+    /**
+     * Destructor. Destroys all the nodes.
+     */
+    virtual ~SkipList();
+
+    // -- getter methods
+
+    /**
+     * Getter for the list's size.
+     *
+     * @return The number of keys in the list.
+     */
+    inline int size() const { return m_size; }
+
+    /**
+     * Getter for the list's level.
+     *
+     * @return The number of levels in use, the height of the tallest node;
+     *         at least 1.
+     */
+    inline int level() const { return m_level; }
+
+    /**
+     * Getter for the node with the smallest key; the walk on level 0 through
+     * <tt>next(0)</tt> visits the keys in increasing order.
+     *
+     * @return The first node; <code>null</code> if the list is empty.
+     */
+    inline SkipListNode<K, V> * first() const { return m_head->next(0); }
+
+    // -- public methods
+
+    /**
+     * Clear list.
+     */
+    void clear();
+
+    /**
+     * Maps a key to a value. Takes O(log n) expected time.
+     *
+     * @param[in] key
+     *     The key.
+     * @param[in] value
+     *     The value; replaces the key's value if the key is in the list.
+     *
+     * @return <code>true</code> if the key was added; <code>false</code> if
+     *         it was in the list already.
+     */
+    bool insert(const K & key, const V & value);
+
+    /**
+     * Finds the value of a key. Takes O(log n) expected time.
+     *
+     * @param[in] key
+     *     The key.
+     *
+     * @return A pointer to the key's value; <code>null</code> if the key is
+     *         not in the list.
+     */
+    V * find(const K & key);
+
+    /**
+     * Finds the first node whose key is not smaller than a given key, where
+     * an ordered walk over a range of keys starts. Takes O(log n) expected
+     * time.
+     *
+     * @param[in] key
+     *     The key.
+     *
+     * @return The node; <code>null</code> if all the keys are smaller.
+     */
+    SkipListNode<K, V> * lower_bound(const K & key);
+
+    /**
+     * Removes a key and its value. Takes O(log n) expected time.
+     *
+     * @param[in] key
+     *     The key.
+     *
+     * @return <code>true</code> if the key was in the list and has been
+     *         removed; <code>false</code> otherwise.
+     */
+    bool remove(const K & key);
+protected:
+private:
+    /**
+     * Copy constructor; a list owns its nodes.
+     */
+    SkipList(const SkipList<K, V> & other);
+
+    /**
+     * Assignment operator; a list owns its nodes.
+     */
+    SkipList<K, V> & operator=(const SkipList<K, V> & other);
+
+    /**
+     * Searches for the first node whose key is not smaller than a given key.
+     *
+     * @param[in] key
+     *     The key.
+     * @param[out] preds
+     *     If not <code>null</code>, set to the last node before the key on
+     *     each level in use, the head if there is none.
+     *
+     * @return The node; <code>null</code> if all the keys are smaller.
+     */
+    SkipListNode<K, V> * find_greater_or_equal(const K & key, SkipListNode<K, V> ** preds);
+
+    /**
+     * Draws a node height: 1, plus 1 with probability 1/4 for every level
+     * up to MAX_LEVEL.
+     */
+    int random_level();
+
+    /**
+     * The head sentinel, on all MAX_LEVEL levels; its key and value are
+     * unused.
+     */
+    SkipListNode<K, V> * m_head;
+
+    /**
+     * The number of levels in use.
+     */
+    int m_level;
+
+    /**
+     * The number of keys in the list.
+     */
+    int m_size;
+
+    /**
+     * The state of the level generator.
+     */
+    unsigned int m_seed;
+};
+
+
+template<class K, class V>
+SkipList<K, V>::SkipList()
+    : m_head(SkipListNode<K, V>::create(K(), V(), MAX_LEVEL)), m_level(1), m_size(0), m_seed(2463534242u)
+{
+}
+
+
+template<class K, class V>
+SkipList<K, V>::~SkipList()
+{
+    clear();
+    SkipListNode<K, V>::destroy(m_head);
+}
+
+
+template<class K, class V>
+void SkipList<K, V>::clear()
+{
+    SkipListNode<K, V> * node = m_head->next(0);
+
+    while (node != 0) {
+        SkipListNode<K, V> * next = node->next(0);
+        SkipListNode<K, V>::destroy(node);
+        node = next;
+    }
+
+    for (int i = 0; i < MAX_LEVEL; i++)
+        m_head->set_next(i, 0);
+    m_level = 1;
+    m_size = 0;
+}
+
+
+template<class K, class V>
+bool SkipList<K, V>::insert(const K & key, const V & value)
+{
+    SkipListNode<K, V> * preds[MAX_LEVEL];
+    SkipListNode<K, V> * node = find_greater_or_equal(key, preds);
+
+    if (node != 0 && !(key < node->key())) {
+        node->value() = value;
+        return false;
+    }
+
+    int height = random_level();
+    for (; m_level < height; m_level++)
+        preds[m_level] = m_head;
+
+    node = SkipListNode<K, V>::create(key, value, height);
+    for (int i = 0; i < height; i++) {
+        node->set_next(i, preds[i]->next(i));
+        preds[i]->set_next(i, node);
+    }
+    m_size++;
+
+    return true;
+}
+
+
+template<class K, class V>
+V * SkipList<K, V>::find(const K & key)
+{
+    SkipListNode<K, V> * node = find_greater_or_equal(key, 0);
+
+    if (node == 0 || key < node->key())
+        return 0;
+
+    return &node->value();
+}
+
+
+template<class K, class V>
+SkipListNode<K, V> * SkipList<K, V>::lower_bound(const K & key)
+{
+    return find_greater_or_equal(key, 0);
+}
+
+
+template<class K, class V>
+bool SkipList<K, V>::remove(const K & key)
+{
+    SkipListNode<K, V> * preds[MAX_LEVEL];
+    SkipListNode<K, V> * node = find_greater_or_equal(key, preds);
+
+    if (node == 0 || key < node->key())
+        return false;
+
+    for (int i = 0; i < node->height(); i++)
+        preds[i]->set_next(i, node->next(i));
+    SkipListNode<K, V>::destroy(node);
+    m_size--;
+
+    while (m_level > 1 && m_head->next(m_level - 1) == 0)
+        m_level--;
+
+    return true;
+}
+
+
+template<class K, class V>
+SkipListNode<K, V> * SkipList<K, V>::find_greater_or_equal(const K & key, SkipListNode<K, V> ** preds)
+{
+    SkipListNode<K, V> * pred = m_head;
+    SkipListNode<K, V> * next = 0;
+
+    for (int i = m_level - 1; i >= 0; i--) {
+        next = pred->next(i);
+        while (next != 0 && next->key() < key) {
+            pred = next;
+            next = pred->next(i);
+        }
+        if (preds != 0)
+            preds[i] = pred;
+    }
+
+    return next;
+}
+
+
+template<class K, class V>
+int SkipList<K, V>::random_level()
+{
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    // Two bits per level: each pair of zeros is a 1/4 chance to go higher.
+    unsigned int bits = m_seed;
+    int height = 1;
+    while (height < MAX_LEVEL && (bits & 3) == 0) {
+        bits >>= 2;
+        height++;
+    }
+
+    return height;
+}
+
+#endif /* SKIPLIST_H_ */
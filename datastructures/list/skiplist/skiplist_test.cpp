@@ -0,0 +1,240 @@
+/**
+ * @file skiplist_test.cpp
+ *
+ * Test unit for the skip list class.
+ *
+ * @see skiplist.h skiplist.cpp skiplistnode.h skiplistnode.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "skiplist.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+void test_insert_find_remove();
+void test_ordered_iteration();
+void test_against_map();
+void test_map_timing();
+
+int main (int argc, char** argv)
+{
+    test_insert_find_remove();
+    test_ordered_iteration();
+    test_against_map();
+    test_map_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Prints the keys of a list in order, with their heights.
+ */
+template<class K, class V>
+void print(SkipList<K, V> & list)
+{
+    std::cout << "HEAD -> ";
+    for (SkipListNode<K, V> * node = list.first(); node != 0; node = node->next(0))
+        std::cout << "| " << node->key() << " (" << node->height() << ") | -> ";
+    std::cout << "NULL" << std::endl;
+}
+
+
+/**
+ * Checks that a list holds exactly the entries of a map, in the same order,
+ * and that every level is a sorted sublist of the one below.
+ */
+bool matches(SkipList<int, int> & list, std::map<int, int> & expected)
+{
+    if (list.size() != (int) expected.size())
+        return false;
+
+    SkipListNode<int, int> * node = list.first();
+    for (std::map<int, int>::iterator it = expected.begin(); it != expected.end(); ++it) {
+        if (node == 0 || node->key() != it->first || node->value() != it->second)
+            return false;
+        for (int i = 1; i < node->height(); i++) {
+            SkipListNode<int, int> * next = node->next(i);
+            if (next != 0 && (next->key() <= node->key() || next->height() <= i))
+                return false;
+        }
+        node = node->next(0);
+    }
+
+    return node == 0;
+}
+
+
+// test functions
+
+
+void test_insert_find_remove()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    SkipList<std::string, int> list;
+    const char * words[] = { "pear", "apple", "fig", "kiwi", "banana", "cherry", "lime" };
+    for (int i = 0; i < 7; i++)
+        list.insert(words[i], i);
+    print(list);
+
+    std::cout << "Inserting \"fig\" again: " << (list.insert("fig", 70) ? "added" : "replaced")
+            << ", value " << *list.find("fig") << std::endl;
+    std::cout << "Finding \"kiwi\": " << (list.find("kiwi") ? "found" : "not found") << std::endl;
+    std::cout << "Finding \"grape\": " << (list.find("grape") ? "found" : "not found") << std::endl;
+
+    list.remove("apple");
+    list.remove("pear");
+    list.remove("fig");
+    std::cout << "Removed the first, the last and \"fig\":" << std::endl;
+    print(list);
+    std::cout << "Removing \"fig\" again: " << (list.remove("fig") ? "removed" : "not found") << std::endl;
+
+    list.clear();
+    std::cout << "Cleared: " << (list.size() == 0 && list.first() == 0 && list.level() == 1 ? "(ok)" : "(WRONG)")
+            << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_ordered_iteration()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    SkipList<int, int> list;
+    for (int i = 0; i < 20; i++)
+        list.insert((i * 7) % 20 * 5, i);
+    print(list);
+
+    std::cout << "Keys in [32, 61]:";
+    for (SkipListNode<int, int> * node = list.lower_bound(32); node != 0 && node->key() <= 61; node = node->next(0))
+        std::cout << " " << node->key();
+    std::cout << std::endl;
+    std::cout << "First key not below 96: " << (list.lower_bound(96) == 0 ? "none" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Runs random inserts, finds and removes against a std::map.
+ */
+void test_against_map()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    SkipList<int, int> list;
+    std::map<int, int> expected;
+    bool ok = true;
+
+    srand(5);
+    for (int step = 0; step < 200000 && ok; step++) {
+        int key = rand() % 5000;
+        switch (rand() % 3) {
+        case 0:
+            ok = list.insert(key, step) == (expected.find(key) == expected.end());
+            expected[key] = step;
+            break;
+        case 1:
+            ok = list.remove(key) == (expected.erase(key) == 1);
+            break;
+        default:
+            int * value = list.find(key);
+            ok = (value == 0) == (expected.find(key) == expected.end())
+                    && (value == 0 || *value == expected[key]);
+            break;
+        }
+        if (step % 10000 == 0)
+            ok = ok && matches(list, expected);
+    }
+    ok = ok && matches(list, expected);
+
+    std::cout << "200000 random operations, " << list.size() << " keys left, "
+            << list.level() << " levels: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Inserts keys in random order and looks them all up, in a SkipList, in a
+ * std::map and in a SinglyLinkedList, which has to search the list before
+ * every insert to keep the keys unique.
+ */
+void test_map_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    int sizes[] = { 1000, 10000, 40000, 1000000 };
+
+    std::cout << "keys\tSkipList (s)\tstd::map (s)\tSinglyLinkedList (s)" << std::endl;
+
+    for (int s = 0; s < 4; s++) {
+        int n = sizes[s];
+        long sum = 0;
+
+        srand(6);
+        SkipList<int, int> list;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; i++)
+            list.insert(rand(), i);
+        srand(6);
+        for (int i = 0; i < n; i++)
+            sum += *list.find(rand());
+        double ssecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        srand(6);
+        std::map<int, int> map;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; i++)
+            map[rand()] = i;
+        srand(6);
+        for (int i = 0; i < n; i++)
+            sum -= map.find(rand())->second;
+        double msecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << n << "\t" << ssecs << "\t" << msecs << "\t";
+
+        if (n > 40000) {
+            std::cout << "(skipped)" << (sum == 0 ? "" : " WRONG") << std::endl;
+            continue;
+        }
+
+        srand(6);
+        SinglyLinkedList<int> linked;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; i++) {
+            int key = rand();
+            if (linked.find_iterative(key) == 0)
+                linked.push_back(key);
+        }
+        srand(6);
+        for (int i = 0; i < n; i++)
+            sum += linked.find_iterative(rand()) != 0;
+        double lsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        linked.clear();
+
+        std::cout << lsecs << (sum == n ? "" : " WRONG") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
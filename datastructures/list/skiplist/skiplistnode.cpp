@@ -0,0 +1,14 @@
+/**
+ * @class SkipListNode
+ *
+ * @file skiplistnode.cpp
+ *
+ * @brief Skip list node class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "skiplistnode.h"
+
+// Empty due to template implementation.
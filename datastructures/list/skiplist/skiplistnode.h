@@ -0,0 +1,197 @@
+#ifndef SKIPLISTNODE_H_
+#define SKIPLISTNODE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+/**
+ * @class SkipListNode
+ *
+ * @file skiplistnode.h
+ *
+ * Skip list node class definition.
+ *
+ * A node holds a key, a value and one next pointer per level it takes part
+ * in, its <em>height</em>. The next pointers are stored inline, at the end
+ * of the node, rather than in a separate array: the node is allocated with
+ * exactly as much room as its height needs, so a search reads the key and
+ * the link it follows from the same block of memory, usually the same cache
+ * line, and the nodes of average height 4/3 take little more room than list
+ * nodes. Nodes are therefore made with <tt>create</tt> and disposed of with
+ * <tt>destroy</tt> rather than with <code>new</code> and
+ * <code>delete</code>.
+ *
+ * The links are atomics, so that ConcurrentSkipList can publish a node with
+ * a compare-and-swap while readers follow the links; loads acquire and
+ * stores release, which costs nothing extra on x86 and little elsewhere, so
+ * SkipList uses the same node.
+ *
+ * @see skiplist.h concurrentskiplist.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class K, class V>
+class SkipListNode {
+public:
+    /**
+     * Allocates and constructs a node with all its links <code>null</code>.
+     *
+     * @param[in] key
+     *     The key of the node.
+     * @param[in] value
+     *     The value of the node.
+     * @param[in] height
+     *     The number of levels of the node; at least 1.
+     *
+     * @return The new node.
+     */
+    static SkipListNode<K, V> * create(const K & key, const V & value, int height);
+
+    /**
+     * Destructs and frees a node made by <tt>create</tt>.
+     *
+     * @param[in] node
+     *     The node.
+     */
+    static void destroy(SkipListNode<K, V> * node);
+
+    // -- getter methods
+
+    /**
+     * Getter for the node's key.
+     *
+     * @return The key of the node.
+     */
+    inline const K & key() const { return m_key; }
+
+    /**
+     * Getter for the node's value.
+     *
+     * @return The value of the node.
+     */
+    inline V & value() { return m_value; }
+
+    /**
+     * Getter for the node's height.
+     *
+     * @return The number of levels the node takes part in.
+     */
+    inline int height() const { return m_height; }
+
+    /**
+     * Getter for the node's next pointer on a level.
+     *
+     * @param[in] level
+     *     The level, in [0, height()).
+     *
+     * @return A pointer to the next node on the level.
+     */
+    inline SkipListNode<K, V> * next(int level) const
+    {
+        return m_next[level].load(std::memory_order_acquire);
+    }
+
+    // -- setter methods
+
+    /**
+     * Setter for the node's next pointer on a level.
+     *
+     * @param[in] level
+     *     The level, in [0, height()).
+     * @param[in] next
+     *     A pointer to the node which we want set as next.
+     */
+    inline void set_next(int level, SkipListNode<K, V> * next)
+    {
+        m_next[level].store(next, std::memory_order_release);
+    }
+
+    // -- public methods
+
+    /**
+     * Sets the next pointer on a level if it still holds the expected value.
+     *
+     * @param[in] level
+     *     The level, in [0, height()).
+     * @param[in] expected
+     *     The value the next pointer is expected to hold.
+     * @param[in] next
+     *     A pointer to the node which we want set as next.
+     *
+     * @return <code>true</code> if the next pointer was set;
+     *         <code>false</code> if it held another value.
+     */
+    inline bool cas_next(int level, SkipListNode<K, V> * expected, SkipListNode<K, V> * next)
+    {
+        return m_next[level].compare_exchange_strong(expected, next);
+    }
+protected:
+private:
+    /**
+     * Constructor; see <tt>create</tt>.
+     */
+    SkipListNode(const K & key, const V & value, int height);
+
+    /**
+     * Destructor; see <tt>destroy</tt>.
+     */
+    ~SkipListNode();
+
+    /**
+     * The key of the node.
+     */
+    const K m_key;
+
+    /**
+     * The value of the node.
+     */
+    V m_value;
+
+    /**
+     * The number of levels of the node.
+     */
+    const int m_height;
+
+    /**
+     * The next pointers, one per level; the array runs on past the end of
+     * the object, into the room <tt>create</tt> allocates for it.
+     */
+    std::atomic<SkipListNode<K, V> *> m_next[1];
+};
+
+
+template<class K, class V>
+SkipListNode<K, V> * SkipListNode<K, V>::create(const K & key, const V & value, int height)
+{
+    size_t bytes = sizeof(SkipListNode<K, V>) + (height - 1) * sizeof(std::atomic<SkipListNode<K, V> *>);
+
+    return new (::operator new(bytes)) SkipListNode<K, V>(key, value, height);
+}
+
+
+template<class K, class V>
+void SkipListNode<K, V>::destroy(SkipListNode<K, V> * node)
+{
+    node->~SkipListNode<K, V>();
+    ::operator delete(node);
+}
+
+
+template<class K, class V>
+SkipListNode<K, V>::SkipListNode(const K & key, const V & value, int height)
+    : m_key(key), m_value(value), m_height(height)
+{
+    m_next[0].store(0, std::memory_order_relaxed);
+    for (int i = 1; i < height; i++)
+        new (&m_next[i]) std::atomic<SkipListNode<K, V> *>(0);
+}
+
+
+template<class K, class V>
+SkipListNode<K, V>::~SkipListNode()
+{
+}
+
+#endif /* SKIPLISTNODE_H_ */
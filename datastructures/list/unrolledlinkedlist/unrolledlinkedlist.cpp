@@ -0,0 +1,14 @@
+/**
+ * @class UnrolledLinkedList
+ *
+ * @file unrolledlinkedlist.cpp
+ *
+ * @brief Unrolled linked list class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "unrolledlinkedlist.h"
+
+// Empty due to template implementation.
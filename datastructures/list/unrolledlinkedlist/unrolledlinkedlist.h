@@ -0,0 +1,442 @@
+#ifndef UNROLLEDLINKEDLIST_H_
+#define UNROLLEDLINKEDLIST_H_
+
+#include "unrolledlinkedlistnode.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+/**
+ * @class UnrolledLinkedList
+ *
+ * @file unrolledlinkedlist.h
+ *
+ * Unrolled linked list class definition.
+ *
+ * An unrolled linked list is a singly linked list whose nodes hold a small
+ * array of elements each, instead of a single one (see
+ * unrolledlinkedlistnode.h). A node is sized to two cache lines, so a scan
+ * takes one cache miss per node rather than one per element, and pays for
+ * one next pointer per node; for small elements, scans run close to the
+ * speed of a scan over an array, while insertions and removals stay local
+ * to one node as in a linked list.
+ *
+ * Elements are added at either end: <tt>append</tt> fills the last node and
+ * starts a new one when it is full, <tt>prepend</tt> does the same with the
+ * first node, shifting its few elements to make room at the front. A removal
+ * shifts the rest of its node down; a node that drops below half full is
+ * merged with the next one if the two fit in one node, and otherwise takes
+ * elements from it until both are about equally full. Every removal thus
+ * costs O(n / B + B) time for nodes of B elements, and the nodes that see
+ * removals stay at least half full.
+ *
+ * The list owns its elements and its nodes; the operations take and return
+ * elements rather than nodes. A pointer to an element returned by a lookup
+ * stays valid until the next change to the list.
+ *
+ * @see singlylinkedlist.h
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class UnrolledLinkedList {
+public:
+    /**
+     * Default constructor.
+     */
+    UnrolledLinkedList();
+
+    /**
+     * Destructor. Deletes all the nodes.
+     */
+    virtual ~UnrolledLinkedList();
+
+    // -- getter methods
+
+    /**
+     * Getter for the list's first node.
+     *
+     * @return The list's first node; <code>null</code> if the list is empty.
+     */
+    inline UnrolledLinkedListNode<T> * head() { return m_head; }
+
+    /**
+     * Getter for the list's last node.
+     *
+     * @return The list's last node; <code>null</code> if the list is empty.
+     */
+    inline UnrolledLinkedListNode<T> * tail() { return m_tail; }
+
+    /**
+     * Getter for the list's size.
+     *
+     * @return The number of elements in the list.
+     */
+    inline int size() { return m_size; }
+
+    // -- setter methods
+    // -- public methods
+
+    /**
+     * Clear list.
+     */
+    void clear();
+
+    /**
+     * Prepends an element to the list. Takes O(B) time.
+     *
+     * @param[in] data
+     *     The element to be prepended.
+     */
+    void prepend(T data);
+
+    /**
+     * Appends an element to the list. Takes O(1) time.
+     *
+     * @param[in] data
+     *     The element to be appended.
+     */
+    void append(T data);
+
+    /**
+     * Finds the first element in the list that equals the data given.
+     *
+     * @param[in] data
+     *     The data to search.
+     *
+     * @return A pointer to the element first found to equal the data given;
+     *         <code>null</code> if no such element exists.
+     */
+    T * find_iterative(T data);
+
+    /**
+     * Removes the first element found with the given data.
+     *
+     * @param[in] data
+     *     The data to search for.
+     *
+     * @return <code>true</code> if the deletion was successful;
+     *         <code>false</code> otherwise.
+     */
+    bool remove(T data);
+
+    /**
+     * Reverts the list, by reverting the order of the nodes and the order
+     * of the elements within every node.
+     */
+    void revert();
+
+    /**
+     * Sorts the list. Takes O(n log n) time and O(n) extra space.
+     *
+     * The elements are copied into an array, sorted with
+     * <code>std::stable_sort</code> and written back into full nodes; the
+     * nodes left over are deleted. The sort is stable and leaves the list
+     * packed.
+     */
+    void sort();
+
+    /**
+     * Find the <it>N</it>-th to last element in the list. Takes O(n / B)
+     * time, skipping whole nodes.
+     *
+     * @param[in] n
+     *     The position from the end; 0 is the last element.
+     *
+     * @return A pointer to the element; <code>null</code> if n is not in
+     *         [0, size()).
+     */
+    T * nth_to_last(int n);
+
+    /**
+     * Prints the list.
+     */
+    void print();
+protected:
+private:
+    /**
+     * Copy constructor; a list owns its nodes.
+     */
+    UnrolledLinkedList(const UnrolledLinkedList<T> & other);
+
+    /**
+     * Assignment operator; a list owns its nodes.
+     */
+    UnrolledLinkedList<T> & operator=(const UnrolledLinkedList<T> & other);
+
+    /**
+     * Removes the element at a position of a node, and merges the node with
+     * or refills it from the next one if it drops below half full.
+     *
+     * @param[in] prev
+     *     The node before the given one; <code>null</code> for the head.
+     * @param[in] node
+     *     The node.
+     * @param[in] index
+     *     The position of the element in the node.
+     */
+    void remove_at(UnrolledLinkedListNode<T> * prev, UnrolledLinkedListNode<T> * node, int index);
+
+    /**
+     * Pointer to the list's first node.
+     */
+    UnrolledLinkedListNode<T> * m_head;
+
+    /**
+     * Pointer to the list's last node.
+     */
+    UnrolledLinkedListNode<T> * m_tail;
+
+    /**
+     * The number of elements in the list.
+     */
+    int m_size;
+};
+
+
+template<class T>
+UnrolledLinkedList<T>::UnrolledLinkedList()
+{
+    m_head = 0;
+    m_tail = 0;
+    m_size = 0;
+}
+
+
+template<class T>
+UnrolledLinkedList<T>::~UnrolledLinkedList()
+{
+    clear();
+}
+
+
+template<class T>
+void UnrolledLinkedList<T>::clear()
+{
+    while (m_head != 0) {
+        UnrolledLinkedListNode<T> * del = m_head;
+        m_head = del->next();
+        delete del;
+    }
+
+    m_tail = 0;
+    m_size = 0;
+}
+
+
+template<class T>
+void UnrolledLinkedList<T>::prepend(T data)
+{
+    if (m_head == 0 || m_head->count() == UnrolledLinkedListNode<T>::CAPACITY) {
+        UnrolledLinkedListNode<T> * node = new UnrolledLinkedListNode<T>();
+        node->set_next(m_head);
+        m_head = node;
+        if (m_tail == 0)
+            m_tail = node;
+    }
+
+    T * elements = m_head->data();
+    std::copy_backward(elements, elements + m_head->count(), elements + m_head->count() + 1);
+    elements[0] = data;
+    m_head->set_count(m_head->count() + 1);
+    m_size++;
+}
+
+
+template<class T>
+void UnrolledLinkedList<T>::append(T data)
+{
+    if (m_tail == 0 || m_tail->count() == UnrolledLinkedListNode<T>::CAPACITY) {
+        UnrolledLinkedListNode<T> * node = new UnrolledLinkedListNode<T>();
+        if (m_tail != 0)
+            m_tail->set_next(node);
+        else
+            m_head = node;
+        m_tail = node;
+    }
+
+    m_tail->data()[m_tail->count()] = data;
+    m_tail->set_count(m_tail->count() + 1);
+    m_size++;
+}
+
+
+template<class T>
+T * UnrolledLinkedList<T>::find_iterative(T data)
+{
+    for (UnrolledLinkedListNode<T> * node = m_head; node != 0; node = node->next()) {
+        // Plain pointers, so that the count is not reloaded after every
+        // comparison in case an element aliases it.
+        T * elements = node->data();
+        T * end = elements + node->count();
+        for (T * element = elements; element != end; ++element) {
+            if (*element == data)
+                return element;
+        }
+    }
+
+    return 0;
+}
+
+
+template<class T>
+bool UnrolledLinkedList<T>::remove(T data)
+{
+    UnrolledLinkedListNode<T> * prev = 0;
+
+    for (UnrolledLinkedListNode<T> * node = m_head; node != 0; node = node->next()) {
+        T * elements = node->data();
+        for (int i = 0; i < node->count(); i++) {
+            if (elements[i] == data) {
+                remove_at(prev, node, i);
+                return true;
+            }
+        }
+        prev = node;
+    }
+
+    return false;
+}
+
+
+template<class T>
+void UnrolledLinkedList<T>::remove_at(UnrolledLinkedListNode<T> * prev, UnrolledLinkedListNode<T> * node, int index)
+{
+    const int half = UnrolledLinkedListNode<T>::CAPACITY / 2;
+    T * elements = node->data();
+
+    std::copy(elements + index + 1, elements + node->count(), elements + index);
+    node->set_count(node->count() - 1);
+    m_size--;
+
+    UnrolledLinkedListNode<T> * next = node->next();
+    if (node->count() < half && next != 0) {
+        T * following = next->data();
+        if (node->count() + next->count() <= UnrolledLinkedListNode<T>::CAPACITY) {
+            // Both fit in this node: take all of the next one.
+            std::copy(following, following + next->count(), elements + node->count());
+            node->set_count(node->count() + next->count());
+            node->set_next(next->next());
+            if (next == m_tail)
+                m_tail = node;
+            delete next;
+        }
+        else {
+            // Take half of the difference, so that both end up about equally
+            // full, and at least half full.
+            int moved = (next->count() - node->count()) / 2;
+            std::copy(following, following + moved, elements + node->count());
+            std::copy(following + moved, following + next->count(), following);
+            node->set_count(node->count() + moved);
+            next->set_count(next->count() - moved);
+        }
+    }
+
+    // Only the last node, having no next one, can be left empty.
+    if (node->count() == 0) {
+        if (prev != 0)
+            prev->set_next(node->next());
+        else
+            m_head = node->next();
+        if (node == m_tail)
+            m_tail = prev;
+        delete node;
+    }
+}
+
+
+template<class T>
+void UnrolledLinkedList<T>::revert()
+{
+    UnrolledLinkedListNode<T> * prev = 0;
+    UnrolledLinkedListNode<T> * curr = m_head;
+    UnrolledLinkedListNode<T> * step = 0;
+
+    while (curr) {
+        step = curr->next();
+
+        std::reverse(curr->data(), curr->data() + curr->count());
+        curr->set_next(prev);
+        prev = curr;
+        curr = step;
+    }
+
+    m_tail = m_head;
+    m_head = prev;
+}
+
+
+template<class T>
+void UnrolledLinkedList<T>::sort()
+{
+    if (m_size < 2)
+        return;
+
+    std::vector<T> elements;
+    elements.reserve(m_size);
+    for (UnrolledLinkedListNode<T> * node = m_head; node != 0; node = node->next())
+        elements.insert(elements.end(), node->data(), node->data() + node->count());
+
+    std::stable_sort(elements.begin(), elements.end());
+
+    // Write the elements back into full nodes, and drop the rest.
+    UnrolledLinkedListNode<T> * node = m_head;
+    size_t i = 0;
+    for (;;) {
+        int count = (int) std::min(elements.size() - i, (size_t) UnrolledLinkedListNode<T>::CAPACITY);
+        std::copy(elements.begin() + i, elements.begin() + i + count, node->data());
+        node->set_count(count);
+        i += count;
+        if (i == elements.size())
+            break;
+        node = node->next();
+    }
+
+    m_tail = node;
+    UnrolledLinkedListNode<T> * rest = node->next();
+    node->set_next(0);
+    while (rest != 0) {
+        UnrolledLinkedListNode<T> * del = rest;
+        rest = rest->next();
+        delete del;
+    }
+}
+
+
+template<class T>
+T * UnrolledLinkedList<T>::nth_to_last(int n)
+{
+    if (n < 0 || n >= m_size)
+        return 0;
+
+    int index = m_size - n - 1;
+    UnrolledLinkedListNode<T> * node = m_head;
+
+    while (index >= node->count()) {
+        index -= node->count();
+        node = node->next();
+    }
+
+    return &node->data()[index];
+}
+
+
+template<class T>
+void UnrolledLinkedList<T>::print()
+{
+    std::cout << "HEAD -> ";
+
+    for (UnrolledLinkedListNode<T> * node = m_head; node != 0; node = node->next()) {
+        std::cout << "|";
+        for (int i = 0; i < node->count(); i++)
+            std::cout << " " << node->data()[i];
+        std::cout << " | -> ";
+    }
+
+    std::cout << "NULL" << std::endl;
+}
+
+
+#endif /* UNROLLEDLINKEDLIST_H_ */
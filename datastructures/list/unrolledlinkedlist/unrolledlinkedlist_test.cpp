@@ -0,0 +1,282 @@
+/**
+ * @file unrolledlinkedlist_test.cpp
+ *
+ * Test unit for the unrolled linked list class.
+ *
+ * @see unrolledlinkedlist.h unrolledlinkedlist.cpp unrolledlinkedlistnode.h
+ * unrolledlinkedlistnode.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "unrolledlinkedlist.h"
+#include "../singlylinkedlist/singlylinkedlist.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+void test_prepend_append();
+void test_remove();
+void test_revert_sort();
+void test_nth_to_last();
+void test_against_vector();
+void test_scan_timing();
+
+int main (int argc, char** argv)
+{
+    test_prepend_append();
+    test_remove();
+    test_revert_sort();
+    test_nth_to_last();
+    test_against_vector();
+    test_scan_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Checks the size, the tail and the node counts of a list, and that it holds
+ * the elements of a vector, in order.
+ */
+bool same_elements(UnrolledLinkedList<int> & list, const std::vector<int> & expected)
+{
+    std::vector<int> elements;
+    UnrolledLinkedListNode<int> * last = 0;
+    for (UnrolledLinkedListNode<int> * node = list.head(); node != 0; node = node->next()) {
+        if (node->count() < 1 || node->count() > UnrolledLinkedListNode<int>::CAPACITY)
+            return false;
+        elements.insert(elements.end(), node->data(), node->data() + node->count());
+        last = node;
+    }
+
+    return elements == expected && list.size() == (int) expected.size() && list.tail() == last;
+}
+
+
+/**
+ * Counts the nodes of a list.
+ */
+int count_nodes(UnrolledLinkedList<int> & list)
+{
+    int nodes = 0;
+    for (UnrolledLinkedListNode<int> * node = list.head(); node != 0; node = node->next())
+        nodes++;
+
+    return nodes;
+}
+
+
+// test functions
+
+
+void test_prepend_append()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    UnrolledLinkedList<int> list;
+    std::cout << UnrolledLinkedListNode<int>::CAPACITY << " ints per node, "
+            << sizeof(UnrolledLinkedListNode<int>) << " bytes per node" << std::endl;
+
+    for (int i = 0; i < 30; i++)
+        list.append(i);
+    for (int i = -1; i >= -30; i--)
+        list.prepend(i);
+
+    std::cout << "Prepended -1..-30 to an appended 0..29:" << std::endl;
+    list.print();
+    std::cout << list.size() << " elements in " << count_nodes(list) << " nodes" << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_remove()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    UnrolledLinkedList<int> list;
+    for (int i = 0; i < 100; i++)
+        list.append(i);
+
+    std::cout << "Original list:" << std::endl;
+    list.print();
+
+    for (int i = 0; i < 100; i += 3)
+        list.remove(i);
+    std::cout << "Removed the multiples of 3:" << std::endl;
+    list.print();
+
+    for (int i = 0; i < 100; i++)
+        if (i % 10 != 0)
+            list.remove(i);
+    std::cout << "Removed all but the multiples of 10:" << std::endl;
+    list.print();
+
+    std::cout << "Trying to remove non existent element 3: "
+            << (list.remove(3) ? "removed" : "not found") << std::endl;
+    std::cout << "Finding 70: " << (list.find_iterative(70) ? "found!" : "NOT found!") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_revert_sort()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    UnrolledLinkedList<int> list;
+    srand(1);
+    for (int i = 0; i < 40; i++)
+        list.append(rand() % 100);
+
+    std::cout << "Original list:" << std::endl;
+    list.print();
+
+    std::cout << "Reverted list:" << std::endl;
+    list.revert();
+    list.print();
+
+    std::cout << "Sorted list:" << std::endl;
+    list.sort();
+    list.print();
+
+    std::cout << std::endl;
+}
+
+
+void test_nth_to_last()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    UnrolledLinkedList<int> list;
+    for (int i = 0; i < 100; i++)
+        list.append(i);
+
+    int ns[] = { 0, 5, 50, 99, 100, -1 };
+    for (int i = 0; i < 6; i++) {
+        int * element = list.nth_to_last(ns[i]);
+        if (element)
+            std::cout << "The " << ns[i] << "-th to last is " << *element << "." << std::endl;
+        else
+            std::cout << "The " << ns[i] << "-th to last is \"undefined\"." << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+
+void test_against_vector()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    UnrolledLinkedList<int> list;
+    std::vector<int> expected;
+    bool ok = true;
+
+    srand(2);
+    for (int step = 0; step < 20000 && ok; step++) {
+        int op = rand() % 100;
+        int data = rand() % 500;
+
+        if (op < 30) {
+            list.append(data);
+            expected.push_back(data);
+        }
+        else if (op < 50) {
+            list.prepend(data);
+            expected.insert(expected.begin(), data);
+        }
+        else if (op < 95) {
+            std::vector<int>::iterator it = std::find(expected.begin(), expected.end(), data);
+            bool found = it != expected.end();
+            if (found)
+                expected.erase(it);
+            ok = list.remove(data) == found;
+        }
+        else if (op < 97) {
+            list.revert();
+            std::reverse(expected.begin(), expected.end());
+        }
+        else if (op < 98) {
+            list.sort();
+            std::stable_sort(expected.begin(), expected.end());
+        }
+        else {
+            int n = rand() % (expected.size() + 1);
+            int * element = list.nth_to_last(n);
+            ok = n < (int) expected.size()
+                    ? element != 0 && *element == expected[expected.size() - 1 - n]
+                    : element == 0;
+        }
+
+        ok = ok && same_elements(list, expected);
+    }
+
+    std::cout << "20000 random operations, " << list.size() << " elements in "
+            << count_nodes(list) << " nodes: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_scan_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 10000000;
+    const int rounds = 5;
+
+    std::vector<int> array(n);
+    UnrolledLinkedList<int> unrolled;
+    SinglyLinkedList<int> singly;
+    for (int i = 0; i < n; i++) {
+        array[i] = i;
+        unrolled.append(i);
+        singly.append(new SinglyLinkedListNode<int>(i));
+    }
+
+    // Look for an element that is not there, so that every scan is full.
+    int misses = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 1; r <= rounds; r++)
+        misses += std::find(array.begin(), array.end(), -r) == array.end();
+    double array_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 1; r <= rounds; r++)
+        misses += unrolled.find_iterative(-r) == 0;
+    double unrolled_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 1; r <= rounds; r++)
+        misses += singly.find_iterative(-r) == 0;
+    double singly_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << n << " elements, " << rounds << " full scans (" << misses << " misses)" << std::endl;
+    std::cout << "std::vector:         " << array_secs << "s" << std::endl;
+    std::cout << "UnrolledLinkedList:  " << unrolled_secs << "s" << std::endl;
+    std::cout << "SinglyLinkedList:    " << singly_secs << "s" << std::endl;
+
+    singly.clear();
+    std::cout << std::endl;
+}
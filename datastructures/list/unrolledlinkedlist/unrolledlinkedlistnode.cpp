@@ -0,0 +1,14 @@
+/**
+ * @class UnrolledLinkedListNode
+ *
+ * @file unrolledlinkedlistnode.cpp
+ *
+ * @brief Unrolled linked list node class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "unrolledlinkedlistnode.h"
+
+// Empty due to template implementation.
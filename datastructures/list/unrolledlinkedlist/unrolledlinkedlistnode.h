@@ -0,0 +1,116 @@
+#ifndef UNROLLEDLINKEDLISTNODE_H_
+#define UNROLLEDLINKEDLISTNODE_H_
+
+/**
+ * @class UnrolledLinkedListNode
+ *
+ * @file unrolledlinkedlistnode.h
+ *
+ * Unrolled linked list node class definition.
+ *
+ * A node holds up to <code>CAPACITY</code> elements in an array, followed in
+ * the list by the elements of the next node. The capacity is chosen so that
+ * a node, its header included, fills two 64-byte cache lines; at least two
+ * elements fit in a node, however large they are.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class UnrolledLinkedListNode {
+public:
+    /**
+     * The size a node aims at, in bytes.
+     */
+    static const int BYTES = 128;
+
+    /**
+     * The maximum number of elements in a node. The header is made of the
+     * virtual table pointer, the next pointer and the element count.
+     */
+    static const int CAPACITY = (BYTES - 3 * sizeof(void *)) / sizeof(T) > 2
+            ? (BYTES - 3 * sizeof(void *)) / sizeof(T) : 2;
+
+    /**
+     * Default constructor. Creates an empty node.
+     */
+    UnrolledLinkedListNode();
+
+    /**
+     * Destructor.
+     */
+    virtual ~UnrolledLinkedListNode();
+
+    // -- getter methods
+
+    /**
+     * Getter for the node's next pointer.
+     *
+     * @return A pointer to the next node.
+     */
+    inline UnrolledLinkedListNode * next() const { return m_next; }
+
+    /**
+     * Getter for the number of elements in the node.
+     *
+     * @return The number of elements.
+     */
+    inline int count() const { return m_count; }
+
+    /**
+     * Getter for the node's elements.
+     *
+     * @return A pointer to the first of the count() elements of the node.
+     */
+    inline T * data() { return m_data; }
+
+    // -- setter methods
+
+    /**
+     * Setter for the node's pointer to the next node.
+     *
+     * @param[in] next
+     *     A pointer to the node which we want set as next.
+     */
+    inline void set_next(UnrolledLinkedListNode * next) { m_next = next; }
+
+    /**
+     * Setter for the number of elements in the node.
+     *
+     * @param[in] count
+     *     The number of elements, in [0, CAPACITY].
+     */
+    inline void set_count(int count) { m_count = count; }
+protected:
+private:
+    /**
+     * A pointer to the next node in the list sequence.
+     */
+    UnrolledLinkedListNode * m_next;
+
+    /**
+     * The number of elements in the node.
+     */
+    int m_count;
+
+    /**
+     * The elements of the node; only the first m_count are in use.
+     */
+    T m_data[CAPACITY];
+};
+
+
+template<class T>
+UnrolledLinkedListNode<T>::UnrolledLinkedListNode()
+{
+    m_next = 0;
+    m_count = 0;
+}
+
+
+template<class T>
+UnrolledLinkedListNode<T>::~UnrolledLinkedListNode()
+{
+}
+
+#endif /* UNROLLEDLINKEDLISTNODE_H_ */
@@ -2,11 +2,20 @@
 #define BINARYTREE_H_
 
 #include "binarytreenode.h"
+#include "../../array/array.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <queue>
-#include <stack>
+#include <thread>
+#include <utility>
+#include <vector>
 
 /**
  * @class BinaryTree
@@ -106,6 +115,22 @@
  * which takes logarithmic time on a tree, and hence can be folded into the
  * cost of each deletion.
  *
+ * Every node also records the size of the subtree rooted at it, which the
+ * mutating operations keep up to date. This makes the tree an
+ * <em>order-statistic tree</em> (CLRS, chapter 14): the i-th smallest key and
+ * the rank of a key can be found in O(h) time instead of with an O(n) inorder
+ * walk.
+ *
+ * Next to the plain operations, which leave the shape of the tree to the
+ * order of the updates, the tree offers a <em>treap</em> mode (Seidel and
+ * Aragon, <em>Randomized Search Trees</em>, 1996): <code>insert_treap</code>
+ * draws a random priority for every node and rotates it up until the
+ * priorities form a max-heap, which makes the shape that of a binary search
+ * tree built by inserting the keys in random order, of expected height
+ * O(log n). A tree updated only through the treap operations also splits and
+ * merges in expected O(log n) time, so that whole key ranges can be cut out
+ * at once.
+ *
  * The example binary tree used for subsequent documentation will be based on
  * the ASCII drawn structure below:
  *
@@ -174,6 +199,15 @@ public:
      */
     BinaryTreeNode<T> *& root_ref();
 
+    /**
+     * Getter for the number of node blocks the tree refers to.
+     *
+     * @return
+     *     The number of contiguous node blocks, allocated by the bulk builds
+     *     or shared with other trees, that nodes of this tree may live in.
+     */
+    int blocks() const;
+
     // -- setter methods
 
     /**
@@ -186,6 +220,176 @@ public:
 
     // -- public methods
 
+    /**
+     * Builds a perfectly balanced binary search tree out of sorted keys.
+     * Takes Θ(n) time.
+     *
+     * Inserting n sorted keys one by one degenerates to a linked list and
+     * costs Θ(n<sup>2</sup>). Since the keys are already sorted, we can
+     * instead pick the median as the root and recursively build the left and
+     * right subtrees out of the keys on either side of it. Each key is
+     * touched exactly once and the heights of any two sibling subtrees differ
+     * by at most one.
+     *
+     * The nodes are allocated as a single contiguous block owned by the tree,
+     * the node holding <code>keys[i]</code> living in slot i, so an inorder
+     * walk of the result is a sequential sweep through memory. Block nodes
+     * are released together with the tree; <code>remove</code> and
+     * <code>destroy</code> simply unlink them.
+     *
+     * Any previous contents of the tree are destroyed.
+     *
+     * @param[in] keys
+     *     A pointer to the keys, sorted in non-decreasing order.
+     * @param[in] n
+     *     The number of keys.
+     */
+    void build_balanced(T * keys, int n);
+
+    /**
+     * Builds a perfectly balanced binary search tree out of a sorted array.
+     *
+     * @see build_balanced(T *, int)
+     *
+     * @param[in] sorted
+     *     The array of keys, sorted in non-decreasing order.
+     */
+    void build_balanced(const Array<T> & sorted);
+
+    /**
+     * Builds a perfectly balanced binary search tree out of a sorted
+     * iterator range.
+     *
+     * @see build_balanced(T *, int)
+     *
+     * @param[in] first
+     *     Random access iterator to the first key.
+     * @param[in] last
+     *     Random access iterator past the last key.
+     */
+    template<class RandomAccessIterator>
+    void build_balanced(RandomAccessIterator first, RandomAccessIterator last);
+
+    /**
+     * Builds a perfectly balanced binary search tree out of sorted keys,
+     * constructing the left and right subtrees concurrently.
+     *
+     * The two halves of the key range are independent and, because of the
+     * slot-per-key layout, so are the parts of the node block they write to.
+     * The top levels of the recursion therefore hand the left subtree to a
+     * new thread and build the right one themselves, until either the
+     * requested number of threads is in use or the subranges become too
+     * small to be worth a thread.
+     *
+     * @see build_balanced(T *, int)
+     *
+     * @param[in] keys
+     *     A pointer to the keys, sorted in non-decreasing order.
+     * @param[in] n
+     *     The number of keys.
+     * @param[in] threads
+     *     The maximum number of threads to use.
+     */
+    void build_balanced_parallel(T * keys, int n, int threads);
+
+    /**
+     * Splits the tree around a key. Takes O(h) time, on a tree of height h.
+     *
+     * The search path for the key is cut into the pieces hanging off its left
+     * and its right side, and each side is glued back together with
+     * <code>join</code>, from the bottom up. On a weight-balanced tree (a
+     * tree built by <code>build_balanced</code>, or by any sequence of
+     * <code>split</code>, <code>join</code> and set operations on such trees)
+     * both halves come out weight balanced.
+     *
+     * The tree is left empty. The node holding the key, if any, is released;
+     * should there be more keys equal to it, they may end up on either side.
+     *
+     * @param[in] key
+     *     The key to split around.
+     * @param[out] left
+     *     The tree that receives the keys smaller than the given key. Its
+     *     previous contents are destroyed.
+     * @param[out] right
+     *     The tree that receives the keys greater than the given key. Its
+     *     previous contents are destroyed.
+     *
+     * @return
+     *     <code>true</code> if the key was present in the tree;
+     *     <code>false</code> otherwise.
+     */
+    bool split(T key, BinaryTree<T> & left, BinaryTree<T> & right);
+
+    /**
+     * Joins two trees and a key lying between them. Takes
+     * O(|log(n<sub>left</sub>) - log(n<sub>right</sub>)|) time.
+     *
+     * <em>Join</em> is the one primitive that the weight-balanced trees of
+     * Blelloch, Ferizovic and Sun (<em>Just Join for Parallel Ordered
+     * Sets</em>, 2016) need: if the two trees are of similar weight (number
+     * of nodes plus one), the key simply becomes their common root;
+     * otherwise it descends the spine of the heavier tree, facing the lighter
+     * one, down to a subtree of similar weight, and is attached there. On the
+     * way back up, one or two rotations per level restore the balance.
+     *
+     * Any previous contents of this tree are destroyed; both argument trees
+     * are left empty.
+     *
+     * @param[in,out] left
+     *     The tree holding the keys smaller than the given key.
+     * @param[in] key
+     *     The key to put between the two trees.
+     * @param[in,out] right
+     *     The tree holding the keys greater than the given key.
+     */
+    void join(BinaryTree<T> & left, T key, BinaryTree<T> & right);
+
+    /**
+     * Adds the keys of another tree to this one. Takes
+     * O(m log(n/m + 1)) work, where m &lt;= n are the sizes of the two trees.
+     *
+     * The other tree is split around the key of this tree's root; the left
+     * parts and the right parts of the two trees are combined recursively
+     * and the results are joined back under the root. The two recursive
+     * calls touch disjoint subtrees, so the top levels of the recursion run
+     * them concurrently, much like <code>build_balanced_parallel</code>.
+     *
+     * Both trees are treated as sets: a key present in both appears once in
+     * the result. The other tree is left empty.
+     *
+     * @param[in,out] other
+     *     The tree to merge into this one.
+     * @param[in] threads
+     *     The maximum number of threads to use.
+     */
+    void set_union(BinaryTree<T> & other, int threads);
+
+    /**
+     * Keeps only the keys that are also present in another tree. Takes
+     * O(m log(n/m + 1)) work, where m &lt;= n are the sizes of the two trees.
+     *
+     * @see set_union
+     *
+     * @param[in,out] other
+     *     The tree to intersect with; left empty.
+     * @param[in] threads
+     *     The maximum number of threads to use.
+     */
+    void set_intersection(BinaryTree<T> & other, int threads);
+
+    /**
+     * Removes the keys that are present in another tree. Takes
+     * O(m log(n/m + 1)) work, where m &lt;= n are the sizes of the two trees.
+     *
+     * @see set_union
+     *
+     * @param[in,out] other
+     *     The tree whose keys to remove; left empty.
+     * @param[in] threads
+     *     The maximum number of threads to use.
+     */
+    void set_difference(BinaryTree<T> & other, int threads);
+
     /**
      * Destroy (a part of) the binary tree.
      *
@@ -214,10 +418,9 @@ public:
     /**
      * Function that calculates the height of an arbitrary binary tree.
      *
-     * The function is recursively called for each child of each node, so the
-     * function will be called once for each node in the tree. Since the
-     * operations on each node are constant time, the overall running time is
-     * O(n).
+     * The height of each node is computed from its children's once, in a
+     * postorder walk, so the overall running time is O(n). The walk keeps its
+     * own stack, so degenerate trees do not exhaust the call stack.
      *
      * @param[in] root
      *     A pointer to the root node of the (sub)tree.
@@ -227,12 +430,34 @@ public:
      */
     int height(BinaryTreeNode<T> * root);
 
+    /**
+     * Calculates the height of a binary tree on several threads.
+     *
+     * @see reduce
+     *
+     * @param[in] root
+     *     A pointer to the root node of the (sub)tree.
+     * @param[in] threads
+     *     The number of threads to use, the calling one included.
+     *
+     * @return
+     *     The height of the tree.
+     */
+    int height(BinaryTreeNode<T> * root, int threads);
+
     /**
      * Checks if the given binary tree is balanced.
      *
      * For a binary tree to be considered balanced, at each node, the heights of
      * the left and the right sub-trees have to differ at most by one.
      *
+     * Checking every node against the heights of its subtrees computed anew
+     * takes O(n log n) time on a balanced tree and O(n^2) on a degenerate
+     * one. Instead, a single postorder walk computes the height of each node
+     * from its children's, and marks the subtree as unbalanced as soon as
+     * two sibling heights differ by more than one; the overall running time
+     * is O(n).
+     *
      * @param[in] root
      *     A pointer to the root node of the (sub)tree.
      *
@@ -242,6 +467,23 @@ public:
      */
     bool is_balanced(BinaryTreeNode<T> * root);
 
+    /**
+     * Checks if the given binary tree is balanced, on several threads.
+     *
+     * @see is_balanced(BinaryTreeNode<T> *)
+     * @see reduce
+     *
+     * @param[in] root
+     *     A pointer to the root node of the (sub)tree.
+     * @param[in] threads
+     *     The number of threads to use, the calling one included.
+     *
+     * @return
+     *     <code>true</code> if the binary tree is balanced; <code>false</code>
+     *     otherwise.
+     */
+    bool is_balanced(BinaryTreeNode<T> * root, int threads);
+
     /**
      * Right rotation of the tree.
      *
@@ -289,7 +531,9 @@ public:
      * Check the documentation for right rotation for more details.
      *
      * Rotate left performs a fixed number of operations regardless of the
-     * size of the tree, so its run time complexity is O(1).
+     * size of the tree, so its run time complexity is O(1). Parent pointers
+     * and the subtree sizes of the two nodes that swap places are updated
+     * along the way.
      *
      * @param[in,out] root
      *     A reference to the root node pointer.
@@ -385,7 +629,9 @@ public:
      * we can safely apply the algorithm to any BST, even repeatedly.
      *
      * Rotate right performs a fixed number of operations regardless of the
-     * size of the tree, so its run time complexity is O(1).
+     * size of the tree, so its run time complexity is O(1). Parent pointers
+     * and the subtree sizes of the two nodes that swap places are updated
+     * along the way.
      *
      * @param[in,out] root
      *     A reference to the root node pointer.
@@ -401,7 +647,8 @@ public:
      *
      * This method implements a recursive algorithm, thus it needs a reference
      * to the pointer to the root node since the base case of the recursion
-     * dictates alternation of the root pointer.
+     * dictates alternation of the root pointer. The node's parent pointer is
+     * set on the way down, as in <code>insert_iterative</code>.
      *
      * @param[in,out] root
      *     A reference to the root node pointer.
@@ -472,6 +719,151 @@ public:
      */
     BinaryTreeNode<T> * search_iterative(BinaryTreeNode<T> * root, T key);
 
+    /**
+     * Self-adjusting lookup operation on the binary tree. Takes O(log n)
+     * amortized time.
+     *
+     * The node holding the key, or the last node visited if the key is not
+     * present, is <em>splayed</em> to the root (see <code>splay</code>).
+     * Frequently accessed keys therefore gather near the root, and a skewed
+     * stream of lookups, where a few hot keys get most of the traffic, ends
+     * up costing little more than O(1) per lookup for the hot keys.
+     *
+     * The tree has to have valid parent pointers, as it has when built with
+     * the insert methods or <code>build_balanced</code>.
+     *
+     * @param[in] key
+     *     The key to search.
+     *
+     * @return
+     *     A pointer to the node found to contain the key given (the new root
+     *     of the tree); <code>null</code> if no such node exists.
+     */
+    BinaryTreeNode<T> * search_splay(T key);
+
+    /**
+     * Splays a node to the root of the tree.
+     *
+     * The node is moved up with rotations, two levels at a time: if the node
+     * and its parent are both left (or both right) children, the grandparent
+     * is rotated first and then the parent (<em>zig-zig</em>); otherwise the
+     * parent is rotated first and then the grandparent (<em>zig-zag</em>). A
+     * single rotation (<em>zig</em>) finishes the job when the node is a child
+     * of the root. Besides moving the node to the root, zig-zig steps roughly
+     * halve the depth of every node on the access path, which is what gives
+     * splay trees their O(log n) amortized bound (Sleator and Tarjan, 1985).
+     *
+     * @param[in] node
+     *     The node to splay.
+     */
+    void splay(BinaryTreeNode<T> * node);
+
+    /**
+     * Finger search: lookup starting from the node accessed last.
+     *
+     * Instead of walking down from the root, the search climbs from the
+     * finger only as far as the lowest ancestor whose subtree can contain the
+     * key, and descends from there. The key range of a subtree is bounded by
+     * the ancestors at which the path to it turns, so the climb can stop as
+     * soon as it meets such an ancestor on the far side of the key. On a
+     * balanced tree, a lookup d positions away (in sorted order) from the
+     * previous one takes O(log d) time; repeating a lookup costs O(1). The
+     * tree is not restructured.
+     *
+     * The finger moves to the node found, or to the last node visited if the
+     * key is not present. The tree has to have valid parent pointers.
+     *
+     * @param[in] key
+     *     The key to search.
+     *
+     * @return
+     *     A pointer to the node found to contain the key given;
+     *     <code>null</code> if no such node exists.
+     */
+    BinaryTreeNode<T> * search_finger(T key);
+
+    /**
+     * Insertion of a node into a treap. Takes O(log n) expected time.
+     *
+     * The node is given a random priority and inserted as a leaf by
+     * <code>insert_iterative</code>; then, as long as its priority is higher
+     * than its parent's, it is rotated above its parent. The tree has to
+     * have been updated through the treap operations only.
+     *
+     * @param[in] node
+     *     The node to be inserted in the treap.
+     */
+    void insert_treap(BinaryTreeNode<T> * node);
+
+    /**
+     * Removal of a node from a treap. Takes O(log n) expected time.
+     *
+     * The node is rotated down, always lifting the child with the higher
+     * priority, until it has at most one child, and then spliced out by
+     * <code>remove</code>. Unlike <code>remove</code>, this never moves keys
+     * between nodes, so pointers to the other nodes stay valid.
+     *
+     * @param[in] node
+     *     The node to be removed from the treap.
+     */
+    void remove_treap(BinaryTreeNode<T> * node);
+
+    /**
+     * Splits a treap around a key. Takes O(log n) expected time.
+     *
+     * The search path for the key is walked once, top down, handing every
+     * node on it to the side its key belongs to; the heap order holds on
+     * both sides without any rotation. Unlike <code>split</code>, no node is
+     * released: keys equal to the given one go to the right.
+     *
+     * The tree is left empty.
+     *
+     * @param[in] key
+     *     The key to split around.
+     * @param[out] left
+     *     The tree that receives the keys smaller than the given key. Its
+     *     previous contents are destroyed.
+     * @param[out] right
+     *     The tree that receives the keys greater than or equal to the given
+     *     key. Its previous contents are destroyed.
+     */
+    void split_treap(T key, BinaryTree<T> & left, BinaryTree<T> & right);
+
+    /**
+     * Merges two treaps, all keys of the first being no greater than any key
+     * of the second. Takes O(log n) expected time.
+     *
+     * The right spine of the left treap and the left spine of the right one
+     * are zipped together in order of priority.
+     *
+     * Any previous contents of this tree are destroyed; both argument trees
+     * are left empty.
+     *
+     * @param[in,out] left
+     *     The treap holding the smaller keys.
+     * @param[in,out] right
+     *     The treap holding the greater keys.
+     */
+    void merge_treap(BinaryTree<T> & left, BinaryTree<T> & right);
+
+    /**
+     * Removes all the keys of a treap within a range. Takes O(log n + k)
+     * expected time, to remove k keys.
+     *
+     * The range is split out of the treap, its nodes are released, and the
+     * parts before and after it are merged back. Typical use is the expiry
+     * of entries keyed by time.
+     *
+     * @param[in] lo
+     *     The smallest key to remove.
+     * @param[in] hi
+     *     The greatest key to remove.
+     *
+     * @return
+     *     The number of keys removed.
+     */
+    int remove_range_treap(T lo, T hi);
+
     /**
      * Location of the minimum value stored in the binary tree. Takes O(h)
      * time, on a binary tree of height h.
@@ -583,6 +975,60 @@ public:
      */
     BinaryTreeNode<T> * predecessor_inorder(BinaryTreeNode<T> * node);
 
+    /**
+     * Location of the node with the k-th smallest key in the tree. Takes O(h)
+     * time, on a binary tree of height h.
+     *
+     * The rank of the root of any subtree within that subtree is the size of
+     * its left subtree plus one. If that is k we are done, otherwise we
+     * continue in the left subtree, or in the right one looking for the
+     * (k - rank)-th smallest key there.
+     *
+     * For the example binary tree, <code>select(5)</code> yields <i>110</i>.
+     *
+     * @param[in] k
+     *     The 1-based order of the key to locate.
+     *
+     * @return
+     *     A pointer to the node holding the k-th smallest key;
+     *     <code>null</code> if k is out of the range [1, n].
+     */
+    BinaryTreeNode<T> * select(int k);
+
+    /**
+     * Counts the keys in the tree that are strictly smaller than the given
+     * key. Takes O(h) time, on a binary tree of height h.
+     *
+     * The key need not be present in the tree. For a key that is present
+     * (and unique), the result is its 0-based position in sorted order.
+     *
+     * For the example binary tree, <code>rank(110)</code> yields <i>4</i>.
+     *
+     * @param[in] key
+     *     The key to rank.
+     *
+     * @return
+     *     The number of keys smaller than the given key.
+     */
+    int rank(T key);
+
+    /**
+     * Counts the keys in the tree that fall within the closed range
+     * [lo, hi]. Takes O(h) time, on a binary tree of height h.
+     *
+     * For the example binary tree, <code>count_range(50, 125)</code> yields
+     * <i>5</i>.
+     *
+     * @param[in] lo
+     *     The lower bound of the range.
+     * @param[in] hi
+     *     The upper bound of the range.
+     *
+     * @return
+     *     The number of keys k with lo <= k <= hi; zero if hi < lo.
+     */
+    int count_range(T lo, T hi);
+
     /**
      * Depth-first traversal of the binary tree in preorder. Takes Θ(n) time to
      * walk a BST.
@@ -712,66 +1158,1406 @@ public:
      * sequence: <i>100, 50, 150, 25, 75, 125, 175, 110</i>
      */
     void bft();
-protected:
-private:
+
     /**
-     * The root node of this binary tree.
+     * Node pointer buffer used by the traversals that accept a caller-owned
+     * work area. Clearing a vector keeps its capacity, so a buffer that is
+     * reused across calls stops allocating once it has grown to the size the
+     * traversal needs.
      */
-    BinaryTreeNode<T> * m_root;
-};
-
+    typedef std::vector<BinaryTreeNode<T> *> NodeBuffer;
 
-template<class T>
-BinaryTree<T>::BinaryTree()
-{
-    m_root = 0;
-}
+    /**
+     * Depth-first preorder traversal that hands every node to a visitor
+     * instead of printing it.
+     *
+     * The visitor is any callable (function pointer, functor or lambda)
+     * taking a <code>BinaryTreeNode<T> *</code> and returning
+     * <code>bool</code>. Returning <code>false</code> stops the traversal.
+     * Since the visitor type is a template parameter the call is resolved at
+     * compile time and can be inlined into the traversal loop. Like the STL
+     * algorithms, the visitor is taken by value.
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool dft_preorder_iterative(Visitor visit);
 
-template<class T>
-BinaryTree<T>::BinaryTree(BinaryTreeNode<T> * root)
-{
-    m_root = root;
-}
+    /**
+     * Depth-first preorder traversal with a visitor and a caller-provided
+     * stack buffer. The buffer is cleared on entry and may be reused between
+     * calls to avoid allocating on every traversal.
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     * @param[in,out] buffer
+     *     The buffer used as the traversal stack.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool dft_preorder_iterative(Visitor visit, NodeBuffer & buffer);
 
-template<class T>
-BinaryTree<T>::~BinaryTree()
-{
-    destroy(m_root);
-}
+    /**
+     * Depth-first inorder traversal with a visitor.
+     *
+     * @see dft_preorder_iterative(Visitor)
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool dft_inorder_iterative(Visitor visit);
 
+    /**
+     * Depth-first inorder traversal with a visitor and a caller-provided
+     * stack buffer.
+     *
+     * @see dft_preorder_iterative(Visitor, NodeBuffer &)
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     * @param[in,out] buffer
+     *     The buffer used as the traversal stack.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool dft_inorder_iterative(Visitor visit, NodeBuffer & buffer);
 
-template<class T>
-BinaryTreeNode<T> * BinaryTree<T>::root() const
-{
-    return m_root;
-}
+    /**
+     * Depth-first postorder traversal with a visitor.
+     *
+     * Walks with a single stack and remembers the last visited node to tell
+     * whether a right subtree has already been processed. Nodes are
+     * therefore handed to the visitor as soon as they are reached in
+     * postorder.
+     *
+     * @see dft_preorder_iterative(Visitor)
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool dft_postorder_iterative(Visitor visit);
 
+    /**
+     * Depth-first postorder traversal with a visitor and a caller-provided
+     * stack buffer.
+     *
+     * @see dft_preorder_iterative(Visitor, NodeBuffer &)
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     * @param[in,out] buffer
+     *     The buffer used as the traversal stack.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool dft_postorder_iterative(Visitor visit, NodeBuffer & buffer);
 
-template<class T>
-BinaryTreeNode<T> *& BinaryTree<T>::root_ref()
-{
-    return m_root;
-}
+    /**
+     * Depth-first inorder traversal with a visitor in O(1) extra memory
+     * (Morris traversal).
+     *
+     * Instead of a stack, the traversal uses the right pointers of the tree
+     * itself. Before descending into the left subtree of a node, it points
+     * the null right pointer of the node's inorder predecessor (the rightmost
+     * node of that subtree) back at the node. When the walk later follows
+     * that <em>thread</em>, it knows the left subtree is done: it removes the
+     * thread, visits the node and goes on to its right subtree. Every edge is
+     * followed at most three times, so the traversal takes O(n) time, however
+     * degenerate the tree is.
+     *
+     * While the traversal runs the tree is not a valid binary tree: the
+     * visitor must not change or walk the tree, and nothing else may read it
+     * concurrently. The tree is restored when the traversal returns, also
+     * when the visitor stops it early.
+     *
+     * @see dft_preorder_iterative(Visitor)
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool dft_inorder_morris(Visitor visit);
 
+    /**
+     * Depth-first preorder traversal with a visitor in O(1) extra memory
+     * (Morris traversal).
+     *
+     * Works like <code>dft_inorder_morris</code>, but visits a node when the
+     * thread to it is set up, before its left subtree, rather than when the
+     * thread is removed.
+     *
+     * @see dft_inorder_morris
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool dft_preorder_morris(Visitor visit);
 
-template<class T>
-void BinaryTree<T>::set_root(BinaryTreeNode<T> * root)
-{
-    m_root = root;
-}
+    /**
+     * Breadth-first traversal with a visitor.
+     *
+     * @see dft_preorder_iterative(Visitor)
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool bft(Visitor visit);
 
+    /**
+     * Breadth-first traversal with a visitor and a caller-provided queue
+     * buffer.
+     *
+     * The buffer is used as a frontier array with a moving read index. The
+     * already visited prefix is dropped whenever it grows past half of the
+     * buffer, so the buffer stays proportional to the widest level of the
+     * tree rather than to the whole tree.
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     * @param[in,out] buffer
+     *     The buffer used as the traversal queue.
+     *
+     * @return
+     *     <code>true</code> if every node was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool bft(Visitor visit, NodeBuffer & buffer);
 
-template<class T>
+    /**
+     * Level-synchronous breadth-first traversal on several threads.
+     *
+     * The tree is processed one level at a time. Each level is held as a
+     * frontier array and cut into chunks that the threads claim in turn. In
+     * a first pass, every thread calls the visitor on the nodes of its
+     * chunks and counts their children. A prefix sum over the chunk counts
+     * then gives every chunk its own range of the next frontier, which the
+     * second pass fills, again chunk by chunk, without any locking; the next
+     * frontier thus keeps the left-to-right order of the level. The threads
+     * are started once per traversal and wait for each other between the
+     * passes; levels too narrow to fill two chunks are handled by the
+     * calling thread alone.
+     *
+     * The visitor is called concurrently on different nodes, and in no
+     * particular order within a level, so it has to be thread safe. If it
+     * returns <code>false</code>, the traversal stops at the end of the
+     * current level.
+     *
+     * @param[in] visit
+     *     The visitor to call on each node.
+     * @param[in] threads
+     *     The number of threads to use, the calling one included.
+     *
+     * @return
+     *     The number of nodes visited on each level, from the root down.
+     */
+    template<class Visitor>
+    std::vector<int> bft_parallel(Visitor visit, int threads);
+
+    /**
+     * Reduction computing the height of a subtree.
+     */
+    struct Height
+    {
+        typedef int Value;
+
+        int operator()() const
+        {
+            return 0;
+        }
+
+        int operator()(BinaryTreeNode<T> *, int left, int right) const
+        {
+            return 1 + std::max(left, right);
+        }
+    };
+
+    /**
+     * Reduction computing the height of a subtree if the subtree is
+     * balanced, and -1 otherwise.
+     */
+    struct Balance
+    {
+        typedef int Value;
+
+        int operator()() const
+        {
+            return 0;
+        }
+
+        int operator()(BinaryTreeNode<T> *, int left, int right) const
+        {
+            if (left < 0 || right < 0 || std::abs(left - right) > 1)
+                return -1;
+            return 1 + std::max(left, right);
+        }
+    };
+
+    /**
+     * Aggregate figures of a subtree. The sum, minimum and maximum of the keys
+     * are meaningless for an empty subtree.
+     */
+    struct Summary
+    {
+        int size;
+        int height;
+        bool balanced;
+        T sum;
+        T min;
+        T max;
+    };
+
+    /**
+     * Reduction computing the summary of a subtree.
+     */
+    struct Summarize
+    {
+        typedef Summary Value;
+
+        Summary operator()() const
+        {
+            Summary empty = Summary();
+            empty.balanced = true;
+            return empty;
+        }
+
+        Summary operator()(BinaryTreeNode<T> * node, const Summary & left, const Summary & right) const
+        {
+            Summary s;
+            s.size = 1 + left.size + right.size;
+            s.height = 1 + std::max(left.height, right.height);
+            s.balanced = left.balanced && right.balanced
+                    && std::abs(left.height - right.height) <= 1;
+            s.sum = left.sum + node->key() + right.sum;
+            s.min = s.max = node->key();
+            if (left.size > 0)
+            {
+                s.min = std::min(s.min, left.min);
+                s.max = std::max(s.max, left.max);
+            }
+            if (right.size > 0)
+            {
+                s.min = std::min(s.min, right.min);
+                s.max = std::max(s.max, right.max);
+            }
+            return s;
+        }
+    };
+
+    /**
+     * Computes the summary of a subtree on several threads.
+     *
+     * @see reduce
+     *
+     * @param[in] root
+     *     A pointer to the root node of the (sub)tree.
+     * @param[in] threads
+     *     The number of threads to use, the calling one included.
+     *
+     * @return
+     *     The size, height, balance and the sum, minimum and maximum key of
+     *     the subtree.
+     */
+    Summary summarize(BinaryTreeNode<T> * root, int threads);
+
+    /**
+     * Fork-join reduction of a subtree.
+     *
+     * A reduction is a functor with a <code>Value</code> type, a call with
+     * no arguments that returns the value of an empty subtree, and a call
+     * taking a node and the values of its left and right subtrees that
+     * returns the value of the subtree rooted at the node. It is called
+     * concurrently from several threads, so it has to be thread safe;
+     * <code>Height</code>, <code>Balance</code> and <code>Summarize</code>
+     * are examples.
+     *
+     * Subtrees with fewer than <code>PARALLEL_CUTOFF</code> nodes, or
+     * reached with a single thread, are reduced on the calling thread by a
+     * postorder walk that keeps its own stack. Above the cutoff, the threads
+     * are shared among the two children of a node in proportion to their
+     * sizes and the left one is reduced on a thread of its own, so that
+     * lopsided trees keep all the threads busy. When one child is too small
+     * to be given a thread, it is reduced on the way and the walk goes on
+     * with the other child, iteratively, so a long spine costs no recursion.
+     * The sizes are the ones kept in the nodes; they only steer the split of
+     * the threads, and the result does not depend on them.
+     *
+     * @param[in] root
+     *     A pointer to the root node of the (sub)tree.
+     * @param[in] reduction
+     *     The reduction.
+     * @param[in] threads
+     *     The number of threads to use, the calling one included.
+     *
+     * @return
+     *     The value of the subtree.
+     */
+    template<class Reduction>
+    typename Reduction::Value reduce(BinaryTreeNode<T> * root, const Reduction & reduction, int threads);
+protected:
+private:
+    /**
+     * Visitor used by the printing traversals; writes the key of each node
+     * to the standard output.
+     */
+    struct KeyPrinter
+    {
+        bool operator()(BinaryTreeNode<T> * node) const
+        {
+            std::cout << node->key() << std::endl;
+            return true;
+        }
+    };
+
+    /**
+     * Null-safe subtree size.
+     *
+     * @param[in] node
+     *     A pointer to the root of the subtree; may be <code>null</code>.
+     *
+     * @return
+     *     The size of the subtree; zero for an empty one.
+     */
+    static int subtree_size(BinaryTreeNode<T> * node);
+
+    /**
+     * Subproblems smaller than this are always solved on the calling thread.
+     */
+    static const int PARALLEL_CUTOFF = 1 << 14;
+
+    /**
+     * The number of frontier nodes claimed at once by <code>bft_parallel</code>.
+     */
+    static const int BFT_CHUNK = 4096;
+
+    /**
+     * Removes the threads left by a Morris traversal stopped at a given node.
+     *
+     * The threads that remain point at the ancestors whose left subtree the
+     * traversal was in. Walking on from the node without setting up new
+     * threads, and skipping the left subtrees that hold none, follows them
+     * back up along the right spines and removes them.
+     *
+     * @param[in] node
+     *     The node where the traversal would have continued.
+     */
+    static void unthread(BinaryTreeNode<T> * node);
+
+    /**
+     * Reduces a subtree on the calling thread.
+     *
+     * @see reduce
+     */
+    template<class Reduction>
+    static typename Reduction::Value reduce_serial(BinaryTreeNode<T> * root, const Reduction & reduction);
+
+    /**
+     * The set operations implemented by <code>combine</code>.
+     */
+    enum SetOperation { UNION, INTERSECTION, DIFFERENCE };
+
+    /**
+     * Releases the nodes of a node block.
+     */
+    struct BlockDeleter
+    {
+        int n;
+
+        void operator()(BinaryTreeNode<T> * block) const
+        {
+            for (int j = 0; j < n; j++)
+                block[j].~BinaryTreeNode<T>();
+            ::operator delete(block);
+        }
+    };
+
+    /**
+     * A node block along with its number of nodes. Blocks are shared by all
+     * trees that hold any of their nodes.
+     */
+    typedef std::pair<std::shared_ptr<BinaryTreeNode<T> >, int> NodeBlock;
+
+    /**
+     * Recursively builds a balanced subtree over the sorted keys in
+     * [lo, hi], placing the node for key i in slot i of the block.
+     *
+     * @param[in] keys
+     *     Random access iterator to the first key of the whole range.
+     * @param[in] lo
+     *     The index of the first key of the subrange.
+     * @param[in] hi
+     *     The index of the last key of the subrange.
+     * @param[in] parent
+     *     The parent of the subtree root.
+     * @param[in] block
+     *     The node block.
+     * @param[in] forks
+     *     How many more levels of the recursion may fork a thread.
+     *
+     * @return
+     *     A pointer to the root of the subtree; <code>null</code> for an
+     *     empty range.
+     */
+    template<class RandomAccessIterator>
+    static BinaryTreeNode<T> * build_range(RandomAccessIterator keys,
+            int lo, int hi, BinaryTreeNode<T> * parent,
+            BinaryTreeNode<T> * block, int forks);
+
+    /**
+     * Allocates a node block and builds a balanced tree in it.
+     *
+     * @see build_range
+     */
+    template<class RandomAccessIterator>
+    void build_block(RandomAccessIterator keys, int n, int forks);
+
+    /**
+     * Deletes a node, unless it lives in one of the tree's node blocks, in
+     * which case it is released together with its block.
+     *
+     * @param[in] node
+     *     The node to release.
+     */
+    void free_node(BinaryTreeNode<T> * node);
+
+    /**
+     * Drops the tree's references to its node blocks. A block is released
+     * once no tree refers to it.
+     */
+    void free_blocks();
+
+    /**
+     * Moves the root and the node blocks of another tree into this one,
+     * whose previous contents are destroyed. The other tree is left empty.
+     *
+     * @param[in,out] other
+     *     The tree to take over.
+     */
+    void take(BinaryTree<T> & other);
+
+    /**
+     * Makes this tree refer to the node blocks of another tree as well,
+     * skipping those it refers to already.
+     *
+     * @param[in] other
+     *     The tree whose blocks to share.
+     */
+    void share_blocks(const BinaryTree<T> & other);
+
+    /**
+     * Weight-balance criterion: neither of two sibling subtrees may weigh
+     * less than about 29% (1 - 1/&radic;2) of their total weight, weight
+     * being the number of nodes plus one.
+     *
+     * @param[in] left
+     *     The size of one subtree.
+     * @param[in] right
+     *     The size of the other subtree.
+     *
+     * @return
+     *     <code>true</code> if subtrees of the given sizes are balanced;
+     *     <code>false</code> otherwise.
+     */
+    static bool weight_balanced(int left, int right);
+
+    /**
+     * Makes a node the root of two subtrees.
+     *
+     * @return
+     *     The node.
+     */
+    static BinaryTreeNode<T> * attach(BinaryTreeNode<T> * left,
+            BinaryTreeNode<T> * node, BinaryTreeNode<T> * right);
+
+    /**
+     * Joins two subtrees and a detached node whose key lies between them.
+     *
+     * @see join
+     *
+     * @return
+     *     The root of the joined subtree, without a parent.
+     */
+    BinaryTreeNode<T> * join_nodes(BinaryTreeNode<T> * left,
+            BinaryTreeNode<T> * node, BinaryTreeNode<T> * right);
+
+    /**
+     * Joins when the left subtree is the heavier one, descending its right
+     * spine.
+     */
+    BinaryTreeNode<T> * join_right(BinaryTreeNode<T> * left,
+            BinaryTreeNode<T> * node, BinaryTreeNode<T> * right);
+
+    /**
+     * Joins when the right subtree is the heavier one, descending its left
+     * spine.
+     */
+    BinaryTreeNode<T> * join_left(BinaryTreeNode<T> * left,
+            BinaryTreeNode<T> * node, BinaryTreeNode<T> * right);
+
+    /**
+     * Joins two subtrees without a node between them.
+     */
+    BinaryTreeNode<T> * join_pair(BinaryTreeNode<T> * left,
+            BinaryTreeNode<T> * right);
+
+    /**
+     * Detaches the node with the maximum key of a non-empty subtree.
+     *
+     * @param[in] root
+     *     The root of the subtree.
+     * @param[out] last
+     *     Set to the detached node.
+     *
+     * @return
+     *     The root of what is left of the subtree.
+     */
+    BinaryTreeNode<T> * split_last(BinaryTreeNode<T> * root,
+            BinaryTreeNode<T> *& last);
+
+    /**
+     * Splits a subtree around a key.
+     *
+     * @param[in] root
+     *     The root of the subtree.
+     * @param[in] key
+     *     The key to split around.
+     * @param[out] left
+     *     Set to the root of the keys smaller than the given key.
+     * @param[out] right
+     *     Set to the root of the keys greater than the given key.
+     *
+     * @return
+     *     The detached node holding the key; <code>null</code> if there is
+     *     none.
+     */
+    BinaryTreeNode<T> * split_nodes(BinaryTreeNode<T> * root, T key,
+            BinaryTreeNode<T> *& left, BinaryTreeNode<T> *& right);
+
+    /**
+     * Recursively applies a set operation to two subtrees, consuming both.
+     *
+     * @param[in] one
+     *     The root of the first subtree.
+     * @param[in] another
+     *     The root of the second subtree.
+     * @param[in] operation
+     *     The set operation.
+     * @param[in] forks
+     *     How many more levels of the recursion may fork a thread.
+     *
+     * @return
+     *     The root of the result, without a parent.
+     */
+    BinaryTreeNode<T> * combine(BinaryTreeNode<T> * one,
+            BinaryTreeNode<T> * another, SetOperation operation, int forks);
+
+    /**
+     * Applies a set operation to this tree and another one, consuming the
+     * other tree.
+     */
+    void set_operation(BinaryTree<T> & other, SetOperation operation,
+            int threads);
+
+    /**
+     * Releases all nodes of a subtree. Unlike <code>destroy</code>, it does
+     * not touch the tree's state, so it may run on several threads at once.
+     *
+     * @param[in] root
+     *     The root of the subtree.
+     */
+    void free_subtree(BinaryTreeNode<T> * root);
+
+    /**
+     * The link through which a node hangs off the tree: its parent's left or
+     * right child pointer, or the root pointer.
+     *
+     * @param[in] node
+     *     A node of the tree.
+     *
+     * @return
+     *     A reference to the pointer that points to the node.
+     */
+    BinaryTreeNode<T> *& link_ref(BinaryTreeNode<T> * node);
+
+    /**
+     * Recomputes the subtree size of a node from the sizes of its children.
+     *
+     * @param[in] node
+     *     The node to update.
+     */
+    static void update_size(BinaryTreeNode<T> * node);
+
+    /**
+     * Counts the keys in the tree that are smaller than or equal to the
+     * given key.
+     *
+     * @param[in] key
+     *     The key to rank.
+     *
+     * @return
+     *     The number of keys smaller than or equal to the given key.
+     */
+    int rank_inclusive(T key);
+
+    /**
+     * Splits the treap rooted at a node by key. The subtree sizes along the
+     * search path are fixed on the way back.
+     *
+     * @param[in] root
+     *     The root of the treap.
+     * @param[in] key
+     *     The key to split around.
+     * @param[in] inclusive
+     *     Whether keys equal to the given one go to the left.
+     * @param[out] left
+     *     The root of the treap with the smaller keys.
+     * @param[out] right
+     *     The root of the treap with the greater keys.
+     */
+    static void split_treap_nodes(BinaryTreeNode<T> * root, T key, bool inclusive,
+            BinaryTreeNode<T> *& left, BinaryTreeNode<T> *& right);
+
+    /**
+     * Merges two treaps, all keys of the first being no greater than any key
+     * of the second.
+     *
+     * @return
+     *     The root of the merged treap.
+     */
+    static BinaryTreeNode<T> * merge_treap_nodes(BinaryTreeNode<T> * left, BinaryTreeNode<T> * right);
+
+    /**
+     * Draws the next treap priority.
+     */
+    unsigned int next_priority();
+
+    /**
+     * The root node of this binary tree.
+     */
+    BinaryTreeNode<T> * m_root;
+
+    /**
+     * Contiguous node blocks allocated by the bulk builds, or taken over
+     * from other trees, that nodes of this tree may live in.
+     */
+    std::vector<NodeBlock> m_blocks;
+
+    /**
+     * The node accessed last by <code>search_finger</code> or
+     * <code>search_splay</code>; <code>null</code> if there is none.
+     */
+    BinaryTreeNode<T> * m_finger;
+
+    /**
+     * The state of the treap priority generator.
+     */
+    unsigned int m_seed;
+};
+
+
+template<class T>
+BinaryTree<T>::BinaryTree()
+{
+    m_root = 0;
+    m_finger = 0;
+    m_seed = 2463534242u;
+}
+
+template<class T>
+BinaryTree<T>::BinaryTree(BinaryTreeNode<T> * root)
+{
+    m_root = root;
+    m_finger = 0;
+    m_seed = 2463534242u;
+}
+
+template<class T>
+BinaryTree<T>::~BinaryTree()
+{
+    destroy(m_root);
+    free_blocks();
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::root() const
+{
+    return m_root;
+}
+
+
+template<class T>
+BinaryTreeNode<T> *& BinaryTree<T>::root_ref()
+{
+    return m_root;
+}
+
+
+template<class T>
+int BinaryTree<T>::blocks() const
+{
+    return (int) m_blocks.size();
+}
+
+
+template<class T>
+void BinaryTree<T>::set_root(BinaryTreeNode<T> * root)
+{
+    m_root = root;
+    m_finger = 0;
+}
+
+
+template<class T>
+void BinaryTree<T>::build_balanced(T * keys, int n)
+{
+    build_block(keys, n, 0);
+}
+
+
+template<class T>
+void BinaryTree<T>::build_balanced(const Array<T> & sorted)
+{
+    build_block(sorted.pointer(), sorted.size(), 0);
+}
+
+
+template<class T>
+template<class RandomAccessIterator>
+void BinaryTree<T>::build_balanced(RandomAccessIterator first, RandomAccessIterator last)
+{
+    build_block(first, (int) (last - first), 0);
+}
+
+
+template<class T>
+void BinaryTree<T>::build_balanced_parallel(T * keys, int n, int threads)
+{
+    // Every forking level doubles the number of threads at work.
+    int forks = 0;
+    while ((1 << forks) < threads)
+        forks++;
+
+    build_block(keys, n, forks);
+}
+
+
+template<class T>
+template<class RandomAccessIterator>
+void BinaryTree<T>::build_block(RandomAccessIterator keys, int n, int forks)
+{
+    destroy(m_root);
+
+    if (n <= 0)
+        return;
+
+    // Raw storage, so that T needs no default constructor; the nodes are
+    // constructed in place by build_range.
+    BinaryTreeNode<T> * block = static_cast<BinaryTreeNode<T> *>(
+            ::operator new(n * sizeof(BinaryTreeNode<T>)));
+    BlockDeleter deleter = { n };
+    m_blocks.push_back(NodeBlock(std::shared_ptr<BinaryTreeNode<T> >(block, deleter), n));
+
+    m_root = build_range(keys, 0, n - 1, 0, block, forks);
+}
+
+
+template<class T>
+template<class RandomAccessIterator>
+BinaryTreeNode<T> * BinaryTree<T>::build_range(RandomAccessIterator keys,
+        int lo, int hi, BinaryTreeNode<T> * parent,
+        BinaryTreeNode<T> * block, int forks)
+{
+    if (lo > hi)
+        return 0;
+
+    int mid = lo + (hi - lo) / 2;
+    BinaryTreeNode<T> * node =
+            new (block + mid) BinaryTreeNode<T>(keys[mid], parent, 0, 0);
+
+    BinaryTreeNode<T> * left = 0;
+    BinaryTreeNode<T> * right = 0;
+
+    if (forks > 0 && hi - lo >= PARALLEL_CUTOFF)
+    {
+        // The subtrees occupy disjoint slots, so no synchronisation is
+        // needed besides the join.
+        std::thread worker([&]() {
+            left = build_range(keys, lo, mid - 1, node, block, forks - 1);
+        });
+        right = build_range(keys, mid + 1, hi, node, block, forks - 1);
+        worker.join();
+    }
+    else
+    {
+        left = build_range(keys, lo, mid - 1, node, block, 0);
+        right = build_range(keys, mid + 1, hi, node, block, 0);
+    }
+
+    node->set_left(left);
+    node->set_right(right);
+    update_size(node);
+
+    return node;
+}
+
+
+template<class T>
+void BinaryTree<T>::free_node(BinaryTreeNode<T> * node)
+{
+    for (typename std::vector<NodeBlock>::size_type i = 0; i < m_blocks.size(); i++)
+    {
+        BinaryTreeNode<T> * block = m_blocks[i].first.get();
+        if (node >= block && node < block + m_blocks[i].second)
+            return;
+    }
+
+    delete node;
+}
+
+
+template<class T>
+void BinaryTree<T>::free_blocks()
+{
+    m_blocks.clear();
+}
+
+
+template<class T>
+void BinaryTree<T>::take(BinaryTree<T> & other)
+{
+    if (&other == this)
+        return;
+
+    destroy(m_root);
+
+    m_root = other.m_root;
+    m_blocks.swap(other.m_blocks);
+    other.m_root = 0;
+    other.m_finger = 0;
+}
+
+
+template<class T>
+void BinaryTree<T>::share_blocks(const BinaryTree<T> & other)
+{
+    if (&other == this)
+        return;
+
+    // A split followed by a join hands the same blocks back; without this
+    // check every round trip would double the list.
+    for (typename std::vector<NodeBlock>::size_type i = 0; i < other.m_blocks.size(); i++)
+    {
+        bool held = false;
+        for (typename std::vector<NodeBlock>::size_type j = 0; j < m_blocks.size() && !held; j++)
+            held = m_blocks[j].first.get() == other.m_blocks[i].first.get();
+
+        if (!held)
+            m_blocks.push_back(other.m_blocks[i]);
+    }
+}
+
+
+template<class T>
+bool BinaryTree<T>::split(T key, BinaryTree<T> & left, BinaryTree<T> & right)
+{
+    // Detach everything first, in case either output is this tree.
+    BinaryTree<T> whole;
+    whole.take(*this);
+
+    BinaryTreeNode<T> * less = 0;
+    BinaryTreeNode<T> * greater = 0;
+    BinaryTreeNode<T> * node = whole.split_nodes(whole.m_root, key, less, greater);
+    if (node != 0)
+        whole.free_node(node);
+    whole.m_root = 0;
+
+    left.destroy(left.m_root);
+    left.m_root = less;
+    left.share_blocks(whole);
+
+    right.destroy(right.m_root);
+    right.m_root = greater;
+    right.share_blocks(whole);
+
+    return node != 0;
+}
+
+
+template<class T>
+void BinaryTree<T>::join(BinaryTree<T> & left, T key, BinaryTree<T> & right)
+{
+    BinaryTree<T> less;
+    BinaryTree<T> greater;
+    less.take(left);
+    greater.take(right);
+
+    destroy(m_root);
+    share_blocks(less);
+    share_blocks(greater);
+    m_root = join_nodes(less.m_root, new BinaryTreeNode<T>(key), greater.m_root);
+
+    less.m_root = 0;
+    greater.m_root = 0;
+}
+
+
+template<class T>
+void BinaryTree<T>::split_treap(T key, BinaryTree<T> & left, BinaryTree<T> & right)
+{
+    // Detach everything first, in case either output is this tree.
+    BinaryTree<T> whole;
+    whole.take(*this);
+
+    BinaryTreeNode<T> * less = 0;
+    BinaryTreeNode<T> * greater = 0;
+    split_treap_nodes(whole.m_root, key, false, less, greater);
+    whole.m_root = 0;
+
+    left.destroy(left.m_root);
+    left.m_root = less;
+    left.share_blocks(whole);
+
+    right.destroy(right.m_root);
+    right.m_root = greater;
+    right.share_blocks(whole);
+}
+
+
+template<class T>
+void BinaryTree<T>::merge_treap(BinaryTree<T> & left, BinaryTree<T> & right)
+{
+    BinaryTree<T> less;
+    BinaryTree<T> greater;
+    less.take(left);
+    greater.take(right);
+
+    destroy(m_root);
+    share_blocks(less);
+    share_blocks(greater);
+    m_root = merge_treap_nodes(less.m_root, greater.m_root);
+
+    less.m_root = 0;
+    greater.m_root = 0;
+}
+
+
+template<class T>
+int BinaryTree<T>::remove_range_treap(T lo, T hi)
+{
+    if (hi < lo)
+        return 0;
+
+    BinaryTreeNode<T> * less = 0;
+    BinaryTreeNode<T> * rest = 0;
+    BinaryTreeNode<T> * range = 0;
+    BinaryTreeNode<T> * greater = 0;
+    split_treap_nodes(m_root, lo, false, less, rest);
+    split_treap_nodes(rest, hi, true, range, greater);
+
+    int removed = subtree_size(range);
+    free_subtree(range);
+    m_root = merge_treap_nodes(less, greater);
+
+    // The finger may point anywhere in the removed range.
+    m_finger = 0;
+
+    return removed;
+}
+
+
+template<class T>
+void BinaryTree<T>::set_union(BinaryTree<T> & other, int threads)
+{
+    set_operation(other, UNION, threads);
+}
+
+
+template<class T>
+void BinaryTree<T>::set_intersection(BinaryTree<T> & other, int threads)
+{
+    set_operation(other, INTERSECTION, threads);
+}
+
+
+template<class T>
+void BinaryTree<T>::set_difference(BinaryTree<T> & other, int threads)
+{
+    set_operation(other, DIFFERENCE, threads);
+}
+
+
+template<class T>
+void BinaryTree<T>::set_operation(BinaryTree<T> & other, SetOperation operation,
+        int threads)
+{
+    if (&other == this)
+    {
+        if (operation == DIFFERENCE)
+            destroy(m_root);
+        return;
+    }
+
+    // Nodes of the other tree may end up here, so may its blocks.
+    BinaryTree<T> another;
+    another.take(other);
+    share_blocks(another);
+    m_finger = 0;
+
+    int forks = 0;
+    while ((1 << forks) < threads)
+        forks++;
+
+    m_root = combine(m_root, another.m_root, operation, forks);
+    another.m_root = 0;
+}
+
+
+template<class T>
+bool BinaryTree<T>::weight_balanced(int left, int right)
+{
+    // Compare in 64 bits, so that large trees cannot overflow.
+    long long l = left + 1;
+    long long r = right + 1;
+
+    return 100 * l >= 29 * (l + r) && 100 * r >= 29 * (l + r);
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::attach(BinaryTreeNode<T> * left,
+        BinaryTreeNode<T> * node, BinaryTreeNode<T> * right)
+{
+    node->set_left(left);
+    node->set_right(right);
+    if (left)
+        left->set_parent(node);
+    if (right)
+        right->set_parent(node);
+    update_size(node);
+
+    return node;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::join_nodes(BinaryTreeNode<T> * left,
+        BinaryTreeNode<T> * node, BinaryTreeNode<T> * right)
+{
+    BinaryTreeNode<T> * root;
+
+    if (weight_balanced(subtree_size(left), subtree_size(right)))
+        root = attach(left, node, right);
+    else if (subtree_size(left) > subtree_size(right))
+        root = join_right(left, node, right);
+    else
+        root = join_left(left, node, right);
+
+    root->set_parent(0);
+    return root;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::join_right(BinaryTreeNode<T> * left,
+        BinaryTreeNode<T> * node, BinaryTreeNode<T> * right)
+{
+    // Running out of spine only happens on inputs that were not weight
+    // balanced to begin with; the result is still a search tree.
+    if (left == 0 || weight_balanced(subtree_size(left), subtree_size(right)))
+        return attach(left, node, right);
+
+    BinaryTreeNode<T> * spine = join_right(left->right(), node, right);
+    BinaryTreeNode<T> * root = attach(left->left(), left, spine);
+
+    if (weight_balanced(subtree_size(root->left()), subtree_size(spine)))
+        return root;
+
+    // Too heavy on the right now: a single rotation does if the inner
+    // grandchild stays light enough, otherwise a double one. Again, inputs
+    // that are not weight balanced may lack the inner grandchild.
+    int outer = subtree_size(root->left());
+    if (spine->left() == 0
+            || (weight_balanced(outer, subtree_size(spine->left()))
+                && weight_balanced(outer + subtree_size(spine->left()) + 1,
+                        subtree_size(spine->right()))))
+    {
+        rotate_left(root);
+    }
+    else
+    {
+        rotate_right(root->right_ref());
+        rotate_left(root);
+    }
+
+    return root;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::join_left(BinaryTreeNode<T> * left,
+        BinaryTreeNode<T> * node, BinaryTreeNode<T> * right)
+{
+    if (right == 0 || weight_balanced(subtree_size(left), subtree_size(right)))
+        return attach(left, node, right);
+
+    BinaryTreeNode<T> * spine = join_left(left, node, right->left());
+    BinaryTreeNode<T> * root = attach(spine, right, right->right());
+
+    if (weight_balanced(subtree_size(spine), subtree_size(root->right())))
+        return root;
+
+    int outer = subtree_size(root->right());
+    if (spine->right() == 0
+            || (weight_balanced(subtree_size(spine->right()), outer)
+                && weight_balanced(subtree_size(spine->left()),
+                        subtree_size(spine->right()) + outer + 1)))
+    {
+        rotate_right(root);
+    }
+    else
+    {
+        rotate_left(root->left_ref());
+        rotate_right(root);
+    }
+
+    return root;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::join_pair(BinaryTreeNode<T> * left,
+        BinaryTreeNode<T> * right)
+{
+    if (left == 0)
+    {
+        if (right)
+            right->set_parent(0);
+        return right;
+    }
+
+    BinaryTreeNode<T> * last = 0;
+    BinaryTreeNode<T> * rest = split_last(left, last);
+
+    return join_nodes(rest, last, right);
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::split_last(BinaryTreeNode<T> * root,
+        BinaryTreeNode<T> *& last)
+{
+    if (root->right() == 0)
+    {
+        last = root;
+        BinaryTreeNode<T> * rest = root->left();
+        if (rest)
+            rest->set_parent(0);
+        return rest;
+    }
+
+    BinaryTreeNode<T> * rest = split_last(root->right(), last);
+
+    return join_nodes(root->left(), root, rest);
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::split_nodes(BinaryTreeNode<T> * root, T key,
+        BinaryTreeNode<T> *& left, BinaryTreeNode<T> *& right)
+{
+    if (root == 0)
+    {
+        left = right = 0;
+        return 0;
+    }
+
+    BinaryTreeNode<T> * l = root->left();
+    BinaryTreeNode<T> * r = root->right();
+
+    if (key == root->key())
+    {
+        left = l;
+        right = r;
+        if (left)
+            left->set_parent(0);
+        if (right)
+            right->set_parent(0);
+        return root;
+    }
+
+    BinaryTreeNode<T> * found;
+    if (key < root->key())
+    {
+        BinaryTreeNode<T> * middle;
+        found = split_nodes(l, key, left, middle);
+        right = join_nodes(middle, root, r);
+    }
+    else
+    {
+        BinaryTreeNode<T> * middle;
+        found = split_nodes(r, key, middle, right);
+        left = join_nodes(l, root, middle);
+    }
+
+    return found;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::combine(BinaryTreeNode<T> * one,
+        BinaryTreeNode<T> * another, SetOperation operation, int forks)
+{
+    if (one == 0 || another == 0)
+    {
+        if (operation == UNION)
+        {
+            BinaryTreeNode<T> * root = one ? one : another;
+            if (root)
+                root->set_parent(0);
+            return root;
+        }
+
+        if (operation == DIFFERENCE && one != 0)
+        {
+            one->set_parent(0);
+            return one;
+        }
+
+        free_subtree(one);
+        free_subtree(another);
+        return 0;
+    }
+
+    // Union and intersection split the other tree around this one's root;
+    // the difference has to keep this tree's nodes, so it does the reverse.
+    BinaryTreeNode<T> * pivot = operation == DIFFERENCE ? another : one;
+    BinaryTreeNode<T> * split = operation == DIFFERENCE ? one : another;
+    BinaryTreeNode<T> * pivot_left = pivot->left();
+    BinaryTreeNode<T> * pivot_right = pivot->right();
+    BinaryTreeNode<T> * split_left;
+    BinaryTreeNode<T> * split_right;
+    BinaryTreeNode<T> * match = split_nodes(split, pivot->key(), split_left, split_right);
+
+    BinaryTreeNode<T> * one_left = pivot_left;
+    BinaryTreeNode<T> * one_right = pivot_right;
+    BinaryTreeNode<T> * another_left = split_left;
+    BinaryTreeNode<T> * another_right = split_right;
+    if (operation == DIFFERENCE)
+    {
+        std::swap(one_left, another_left);
+        std::swap(one_right, another_right);
+    }
+
+    BinaryTreeNode<T> * left = 0;
+    BinaryTreeNode<T> * right = 0;
+    if (forks > 0 && subtree_size(one) + subtree_size(another) >= PARALLEL_CUTOFF)
+    {
+        // The two halves share no nodes, so no synchronisation is needed
+        // besides the join.
+        std::thread worker([&]() {
+            left = combine(one_left, another_left, operation, forks - 1);
+        });
+        right = combine(one_right, another_right, operation, forks - 1);
+        worker.join();
+    }
+    else
+    {
+        left = combine(one_left, another_left, operation, 0);
+        right = combine(one_right, another_right, operation, 0);
+    }
+
+    switch (operation)
+    {
+    case UNION:
+        if (match)
+            free_node(match);
+        return join_nodes(left, pivot, right);
+    case INTERSECTION:
+        if (match)
+        {
+            free_node(match);
+            return join_nodes(left, pivot, right);
+        }
+        free_node(pivot);
+        return join_pair(left, right);
+    default:
+        if (match)
+            free_node(match);
+        free_node(pivot);
+        return join_pair(left, right);
+    }
+}
+
+
+template<class T>
+void BinaryTree<T>::free_subtree(BinaryTreeNode<T> * root)
+{
+    if (root != 0)
+    {
+        free_subtree(root->left());
+        free_subtree(root->right());
+        free_node(root);
+    }
+}
+
+
+template<class T>
 void BinaryTree<T>::destroy(BinaryTreeNode<T> *& root)
 {
+    // The finger may point anywhere in the destroyed part.
+    m_finger = 0;
+
     if (root != 0)
     {
         destroy(root->left_ref());
         destroy(root->right_ref());
         BinaryTreeNode<T> * tmp = root;
         root = 0;
-        delete tmp;
+        free_node(tmp);
     }
+
+    // Once the whole tree is gone, so can the blocks its nodes lived in.
+    if (&root == &m_root)
+        free_blocks();
 }
 
 
@@ -786,40 +2572,167 @@ BinaryTreeNode<T> * BinaryTree<T>::copy(BinaryTreeNode<T> * root)
         t = 0;
     else
     {
-        l = copy(root->left_ref());
-        r = copy(root->right_ref());
-        t = new BinaryTreeNode<T>(root->key(), 0, l, r);
+        l = copy(root->left_ref());
+        r = copy(root->right_ref());
+        t = new BinaryTreeNode<T>(root->key(), 0, l, r);
+    }
+
+    return t;
+}
+
+
+template<class T>
+int BinaryTree<T>::height(BinaryTreeNode<T> * root)
+{
+    return reduce_serial(root, Height());
+}
+
+
+template<class T>
+int BinaryTree<T>::height(BinaryTreeNode<T> * root, int threads)
+{
+    return reduce(root, Height(), threads);
+}
+
+
+template<class T>
+bool BinaryTree<T>::is_balanced(BinaryTreeNode<T> * root)
+{
+    return reduce_serial(root, Balance()) >= 0;
+}
+
+
+template<class T>
+bool BinaryTree<T>::is_balanced(BinaryTreeNode<T> * root, int threads)
+{
+    return reduce(root, Balance(), threads) >= 0;
+}
+
+
+template<class T>
+typename BinaryTree<T>::Summary BinaryTree<T>::summarize(BinaryTreeNode<T> * root, int threads)
+{
+    return reduce(root, Summarize(), threads);
+}
+
+
+template<class T>
+template<class Reduction>
+typename Reduction::Value BinaryTree<T>::reduce(BinaryTreeNode<T> * root, const Reduction & reduction, int threads)
+{
+    typedef typename Reduction::Value Value;
+
+    // The nodes passed on the way down, whether their reduced child is the
+    // left one, and that child's value.
+    struct Step
+    {
+        BinaryTreeNode<T> * node;
+        bool left;
+        Value value;
+    };
+    std::vector<Step> spine;
+
+    BinaryTreeNode<T> * node = root;
+    Value value;
+    for (;;)
+    {
+        int size = subtree_size(node);
+        if (threads < 2 || size < PARALLEL_CUTOFF)
+        {
+            value = reduce_serial(node, reduction);
+            break;
+        }
+
+        // Round the left child's share of the threads to the nearest integer.
+        long long ls = subtree_size(node->left());
+        long long rs = subtree_size(node->right());
+        int lt = ls + rs == 0 ? 0 : (int) ((2 * threads * ls + ls + rs) / (2 * (ls + rs)));
+        int rt = threads - lt;
+
+        if (lt > 0 && rt > 0)
+        {
+            Value left;
+            Value right;
+            std::thread worker([&]() {
+                left = reduce(node->left(), reduction, lt);
+            });
+            right = reduce(node->right(), reduction, rt);
+            worker.join();
+            value = reduction(node, left, right);
+            break;
+        }
+
+        Step step;
+        step.node = node;
+        step.left = lt == 0;
+        step.value = reduce_serial(step.left ? node->left() : node->right(), reduction);
+        spine.push_back(step);
+        node = step.left ? node->right() : node->left();
+    }
+
+    while (!spine.empty())
+    {
+        const Step & step = spine.back();
+        if (step.left)
+            value = reduction(step.node, step.value, value);
+        else
+            value = reduction(step.node, value, step.value);
+        spine.pop_back();
     }
 
-    return t;
+    return value;
 }
 
 
 template<class T>
-int BinaryTree<T>::height(BinaryTreeNode<T> * root)
+template<class Reduction>
+typename Reduction::Value BinaryTree<T>::reduce_serial(BinaryTreeNode<T> * root, const Reduction & reduction)
 {
-    if (!root)
-        return 0;
-    else
-        return 1+ std::max(height(root->left()), height(root->right()));
-}
+    typedef typename Reduction::Value Value;
 
+    if (root == 0)
+        return reduction();
 
-template<class T>
-bool BinaryTree<T>::is_balanced(BinaryTreeNode<T> * root)
-{
-    if(!root)
-        return true;
+    // Postorder walk; the values of the finished subtrees wait on a stack of
+    // their own until their parent is finished, left before right.
+    std::vector<std::pair<BinaryTreeNode<T> *, int> > st;
+    std::vector<Value> values;
+
+    st.push_back(std::make_pair(root, 0));
+    while (!st.empty())
+    {
+        BinaryTreeNode<T> * node = st.back().first;
+        int & state = st.back().second;
 
-    int lh = height(root->left());
-    int rh = height(root->right());
+        if (state == 0)
+        {
+            state = 1;
+            if (node->left() != 0)
+            {
+                st.push_back(std::make_pair(node->left(), 0));
+                continue;
+            }
+            values.push_back(reduction());
+        }
+        if (state == 1)
+        {
+            state = 2;
+            if (node->right() != 0)
+            {
+                st.push_back(std::make_pair(node->right(), 0));
+                continue;
+            }
+            values.push_back(reduction());
+        }
 
-    if (std::abs((long int) (lh - rh)) <= 1 &&
-            is_balanced(root->left()) &&
-            is_balanced(root->right()))
-        return true;
+        Value right = values.back();
+        values.pop_back();
+        Value left = values.back();
+        values.back() = reduction(node, left, right);
+        st.pop_back();
+    }
 
-    return false;
+    return values.back();
 }
 
 
@@ -833,6 +2746,15 @@ void BinaryTree<T>::rotate_left(BinaryTreeNode<T> *& root)
     newRoot->set_left(oldRoot);
     oldRoot->set_right(newRootOldLeft);
 
+    newRoot->set_parent(oldRoot->parent());
+    oldRoot->set_parent(newRoot);
+    if (newRootOldLeft)
+        newRootOldLeft->set_parent(oldRoot);
+
+    // The old root lost a subtree, so it has to be fixed first.
+    update_size(oldRoot);
+    update_size(newRoot);
+
     root = newRoot;
 }
 
@@ -846,6 +2768,15 @@ void BinaryTree<T>::rotate_right(BinaryTreeNode<T> *& root)
     newRoot->set_right(oldRoot);
     oldRoot->set_left(newRootOldRight);
 
+    newRoot->set_parent(oldRoot->parent());
+    oldRoot->set_parent(newRoot);
+    if (newRootOldRight)
+        newRootOldRight->set_parent(oldRoot);
+
+    // The old root lost a subtree, so it has to be fixed first.
+    update_size(oldRoot);
+    update_size(newRoot);
+
     root = newRoot;
 }
 
@@ -859,6 +2790,10 @@ void BinaryTree<T>::insert_recursive(BinaryTreeNode<T> *& root, BinaryTreeNode<T
     }
     else
     {
+        root->set_size(root->size() + 1);
+        // The last node the recursion passes is the parent.
+        node->set_parent(root);
+
         if (node->key() < root->key())
         {
             insert_recursive(root->left_ref(), node);
@@ -877,9 +2812,13 @@ void BinaryTree<T>::insert_iterative(BinaryTreeNode<T> * node)
     BinaryTreeNode<T> * parent = 0;
     BinaryTreeNode<T> * curr = m_root;
 
+    update_size(node);
+
     while (curr != 0)
     {
         parent = curr;
+        // The new node will end up below curr.
+        curr->set_size(curr->size() + 1);
         if (node->key() < curr->key())
             curr = curr->left();
         else
@@ -946,9 +2885,16 @@ void BinaryTree<T>::remove(BinaryTreeNode<T> * node)
     if (splice != node)
         node->set_key(splice->key());
 
+    // Every ancestor of the spliced out node lost one descendant.
+    for (BinaryTreeNode<T> * up = splice->parent(); up != 0; up = up->parent())
+        up->set_size(up->size() - 1);
+
+    if (m_finger == splice)
+        m_finger = 0;
+
     // Check that the splice node is actually deleted and not the node given
     // as an argument to the function since some times splice != node.
-    delete splice;
+    free_node(splice);
 }
 
 
@@ -969,19 +2915,172 @@ BinaryTreeNode<T> * BinaryTree<T>::search_recursive(BinaryTreeNode<T> * root, T
 template<class T>
 BinaryTreeNode<T> * BinaryTree<T>::search_iterative(BinaryTreeNode<T> * root, T key)
 {
-    BinaryTreeNode<int> * node = root;
+    BinaryTreeNode<T> * node = root;
+
+    while (node != 0 && node->key() != key) {
+        if (node->key() > key)
+            node = node->left();
+        else
+            node = node->right();
+    }
+
+    return node;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::search_splay(T key)
+{
+    BinaryTreeNode<T> * node = m_root;
+    BinaryTreeNode<T> * last = 0;
+
+    while (node != 0 && node->key() != key) {
+        last = node;
+        if (node->key() > key)
+            node = node->left();
+        else
+            node = node->right();
+    }
+
+    // On a miss, splay the last node on the search path, so that the cost of
+    // the walk is still paid for by the restructuring.
+    BinaryTreeNode<T> * target = node != 0 ? node : last;
+    if (target != 0) {
+        splay(target);
+        m_finger = target;
+    }
+
+    return node;
+}
+
+
+template<class T>
+void BinaryTree<T>::splay(BinaryTreeNode<T> * node)
+{
+    while (node->parent() != 0) {
+        BinaryTreeNode<T> * parent = node->parent();
+        BinaryTreeNode<T> * grandparent = parent->parent();
+        bool left = node == parent->left();
+
+        if (grandparent == 0) {
+            // Zig.
+            if (left)
+                rotate_right(link_ref(parent));
+            else
+                rotate_left(link_ref(parent));
+        }
+        else if (left == (parent == grandparent->left())) {
+            // Zig-zig.
+            if (left) {
+                rotate_right(link_ref(grandparent));
+                rotate_right(link_ref(parent));
+            }
+            else {
+                rotate_left(link_ref(grandparent));
+                rotate_left(link_ref(parent));
+            }
+        }
+        else {
+            // Zig-zag.
+            if (left) {
+                rotate_right(link_ref(parent));
+                rotate_left(link_ref(grandparent));
+            }
+            else {
+                rotate_left(link_ref(parent));
+                rotate_right(link_ref(grandparent));
+            }
+        }
+    }
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::search_finger(T key)
+{
+    BinaryTreeNode<T> * node = m_finger != 0 ? m_finger : m_root;
+
+    if (node == 0)
+        return 0;
+
+    // Climb to the lowest ancestor whose subtree can hold the key. Going up
+    // from a right (left) child, the parent bounds the subtree from below
+    // (above); climbing past parents on the near side changes nothing.
+    while (node->parent() != 0 && node->key() != key) {
+        BinaryTreeNode<T> * parent = node->parent();
+
+        if (key < node->key()) {
+            if (node == parent->right() && parent->key() < key)
+                break;
+        }
+        else {
+            if (node == parent->left() && key < parent->key())
+                break;
+        }
+
+        node = parent;
+    }
 
+    // Descend from there.
+    BinaryTreeNode<T> * last = node;
     while (node != 0 && node->key() != key) {
+        last = node;
         if (node->key() > key)
             node = node->left();
         else
             node = node->right();
     }
 
+    m_finger = node != 0 ? node : last;
+
     return node;
 }
 
 
+template<class T>
+BinaryTreeNode<T> *& BinaryTree<T>::link_ref(BinaryTreeNode<T> * node)
+{
+    BinaryTreeNode<T> * parent = node->parent();
+
+    if (parent == 0)
+        return m_root;
+
+    return node == parent->left() ? parent->left_ref() : parent->right_ref();
+}
+
+
+template<class T>
+void BinaryTree<T>::insert_treap(BinaryTreeNode<T> * node)
+{
+    node->set_priority(next_priority());
+    insert_iterative(node);
+
+    while (node->parent() && node->parent()->priority() < node->priority())
+    {
+        BinaryTreeNode<T> * parent = node->parent();
+        if (node == parent->left())
+            rotate_right(link_ref(parent));
+        else
+            rotate_left(link_ref(parent));
+    }
+}
+
+
+template<class T>
+void BinaryTree<T>::remove_treap(BinaryTreeNode<T> * node)
+{
+    while (node->left() && node->right())
+    {
+        if (node->left()->priority() > node->right()->priority())
+            rotate_right(link_ref(node));
+        else
+            rotate_left(link_ref(node));
+    }
+
+    remove(node);
+}
+
+
 template<class T>
 BinaryTreeNode<T> * BinaryTree<T>::minimum(BinaryTreeNode<T> * root)
 {
@@ -998,99 +3097,285 @@ BinaryTreeNode<T> * BinaryTree<T>::minimum(BinaryTreeNode<T> * root)
 
 
 template<class T>
-BinaryTreeNode<T> * BinaryTree<T>::maximum(BinaryTreeNode<T> * root)
+BinaryTreeNode<T> * BinaryTree<T>::maximum(BinaryTreeNode<T> * root)
+{
+    if (root == 0)
+        return 0;
+
+    BinaryTreeNode<T> * node = root;
+
+    while (node->right() != 0)
+        node = node->right();
+
+    return node;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::lowest_common_ancestor_bst(T one, T another)
+{
+    // Assuming both values exist in tree!
+    // Else we can here perform two searches to double check the
+    // validity of the input.
+
+    BinaryTreeNode<T> * btn = m_root;
+
+    while (btn)
+    {
+        if(btn->key() > one && btn->key() > another)
+            btn = btn->left();
+        else if (btn->key() < one && btn->key() < another)
+            btn = btn->right();
+        else
+            return btn;
+    }
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::successor_inorder(BinaryTreeNode<T> * node)
+{
+    BinaryTreeNode<T> * successor = 0;
+
+    if (node != 0) {
+        // If the right subtree of the node is non-empty...
+        if (node->right() != 0) {
+            // ...the successor of the node, is the leftmost node
+            // in the right subtree.
+            successor = minimum(node->right());
+        }
+        else {
+            BinaryTreeNode<T> * curr = node;
+
+            // To find the successor if the right subtree of the node is empty, we
+            // simply go up the tree from the given node until we encounter a node
+            // that is the left child of its parent.
+            successor = curr->parent();
+            while (successor != 0 && curr == successor->right()) {
+                curr = successor;
+                successor = successor->parent();
+            }
+        }
+    }
+
+    return successor;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::predecessor_inorder(BinaryTreeNode<T> * node)
+{
+    BinaryTreeNode<T> * predecessor = 0;
+
+    if (node != 0) {
+        // If the left subtree of the node is non-empty...
+        if (node->left() != 0) {
+            // ...the predecessor of the node, is the rightmost node
+            // in left subtree.
+            predecessor = maximum(node->left());
+        }
+        else {
+            BinaryTreeNode<T> * curr = node;
+
+            // To find the predecessor if the left subtree of the node is empty, we
+            // simply go up the tree for the given node until we encounter the
+            // closest ancestor such that the given node is descended from the
+            // right child of that predecessor.
+            predecessor = curr->parent();
+            while (predecessor != 0 && curr == predecessor->left()) {
+                curr = predecessor;
+                predecessor = predecessor->parent();
+            }
+        }
+    }
+
+    return predecessor;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * BinaryTree<T>::select(int k)
+{
+    BinaryTreeNode<T> * node = m_root;
+
+    while (node != 0) {
+        int r = subtree_size(node->left()) + 1;
+
+        if (k == r)
+            return node;
+
+        if (k < r) {
+            node = node->left();
+        }
+        else {
+            // Skip the left subtree and the node itself.
+            k -= r;
+            node = node->right();
+        }
+    }
+
+    return 0;
+}
+
+
+template<class T>
+int BinaryTree<T>::rank(T key)
+{
+    int r = 0;
+    BinaryTreeNode<T> * node = m_root;
+
+    while (node != 0) {
+        if (node->key() < key) {
+            // The node and its whole left subtree are smaller than the key.
+            r += subtree_size(node->left()) + 1;
+            node = node->right();
+        }
+        else {
+            node = node->left();
+        }
+    }
+
+    return r;
+}
+
+
+template<class T>
+int BinaryTree<T>::rank_inclusive(T key)
+{
+    int r = 0;
+    BinaryTreeNode<T> * node = m_root;
+
+    while (node != 0) {
+        if (!(key < node->key())) {
+            r += subtree_size(node->left()) + 1;
+            node = node->right();
+        }
+        else {
+            node = node->left();
+        }
+    }
+
+    return r;
+}
+
+
+template<class T>
+int BinaryTree<T>::count_range(T lo, T hi)
 {
-    if (root == 0)
+    if (hi < lo)
         return 0;
 
-    BinaryTreeNode<T> * node = root;
+    return rank_inclusive(hi) - rank(lo);
+}
 
-    while (node->right() != 0)
-        node = node->right();
 
-    return node;
+template<class T>
+int BinaryTree<T>::subtree_size(BinaryTreeNode<T> * node)
+{
+    return node ? node->size() : 0;
 }
 
 
 template<class T>
-BinaryTreeNode<T> * BinaryTree<T>::lowest_common_ancestor_bst(T one, T another)
+void BinaryTree<T>::split_treap_nodes(BinaryTreeNode<T> * root, T key, bool inclusive,
+        BinaryTreeNode<T> *& left, BinaryTreeNode<T> *& right)
 {
-    // Assuming both values exist in tree!
-    // Else we can here perform two searches to double check the
-    // validity of the input.
-
-    BinaryTreeNode<T> * btn = m_root;
+    // Each side is grown downwards through a hook: the link where the next
+    // node handed to that side goes. Left nodes hook further nodes to their
+    // right, and right nodes to their left.
+    BinaryTreeNode<T> ** left_hook = &left;
+    BinaryTreeNode<T> ** right_hook = &right;
+    BinaryTreeNode<T> * left_parent = 0;
+    BinaryTreeNode<T> * right_parent = 0;
+    std::vector<BinaryTreeNode<T> *> path;
 
-    while (btn)
+    BinaryTreeNode<T> * node = root;
+    while (node)
     {
-        if(btn->key() > one && btn->key() > another)
-            btn = btn->left();
-        else if (btn->key() < one && btn->key() < another)
-            btn = btn->right();
+        path.push_back(node);
+        if (node->key() < key || (inclusive && !(key < node->key())))
+        {
+            *left_hook = node;
+            node->set_parent(left_parent);
+            left_parent = node;
+            left_hook = &node->right_ref();
+            node = node->right();
+        }
         else
-            return btn;
+        {
+            *right_hook = node;
+            node->set_parent(right_parent);
+            right_parent = node;
+            right_hook = &node->left_ref();
+            node = node->left();
+        }
     }
+    *left_hook = 0;
+    *right_hook = 0;
+
+    // A node on the path only lost or gained nodes further down the path.
+    for (typename std::vector<BinaryTreeNode<T> *>::reverse_iterator it = path.rbegin(); it != path.rend(); ++it)
+        update_size(*it);
 }
 
 
 template<class T>
-BinaryTreeNode<T> * BinaryTree<T>::successor_inorder(BinaryTreeNode<T> * node)
+BinaryTreeNode<T> * BinaryTree<T>::merge_treap_nodes(BinaryTreeNode<T> * left, BinaryTreeNode<T> * right)
 {
-    BinaryTreeNode<T> * successor = 0;
+    BinaryTreeNode<T> * root = 0;
+    BinaryTreeNode<T> ** hook = &root;
+    BinaryTreeNode<T> * parent = 0;
+    std::vector<BinaryTreeNode<T> *> path;
 
-    if (node != 0) {
-        // If the right subtree of the node is non-empty...
-        if (node->right() != 0) {
-            // ...the successor of the node, is the leftmost node
-            // in the right subtree.
-            successor = minimum(node->right());
+    while (left && right)
+    {
+        if (left->priority() < right->priority())
+        {
+            path.push_back(right);
+            *hook = right;
+            right->set_parent(parent);
+            parent = right;
+            hook = &right->left_ref();
+            right = right->left();
         }
-        else {
-            BinaryTreeNode<T> * curr = node;
-
-            // To find the successor if the right subtree of the node is empty, we
-            // simply go up the tree from the given node until we encounter a node
-            // that is the left child of its parent.
-            successor = curr->parent();
-            while (successor != 0 && curr == successor->right()) {
-                curr = successor;
-                successor = successor->parent();
-            }
+        else
+        {
+            path.push_back(left);
+            *hook = left;
+            left->set_parent(parent);
+            parent = left;
+            hook = &left->right_ref();
+            left = left->right();
         }
     }
 
-    return successor;
+    BinaryTreeNode<T> * rest = left ? left : right;
+    *hook = rest;
+    if (rest)
+        rest->set_parent(parent);
+
+    for (typename std::vector<BinaryTreeNode<T> *>::reverse_iterator it = path.rbegin(); it != path.rend(); ++it)
+        update_size(*it);
+
+    return root;
 }
 
 
 template<class T>
-BinaryTreeNode<T> * BinaryTree<T>::predecessor_inorder(BinaryTreeNode<T> * node)
+unsigned int BinaryTree<T>::next_priority()
 {
-    BinaryTreeNode<T> * predecessor = 0;
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
 
-    if (node != 0) {
-        // If the left subtree of the node is non-empty...
-        if (node->left() != 0) {
-            // ...the predecessor of the node, is the rightmost node
-            // in left subtree.
-            predecessor = maximum(node->left());
-        }
-        else {
-            BinaryTreeNode<T> * curr = node;
+    return m_seed;
+}
 
-            // To find the predecessor if the left subtree of the node is empty, we
-            // simply go up the tree for the given node until we encounter the
-            // closest ancestor such that the given node is descended from the
-            // right child of that predecessor.
-            predecessor = curr->parent();
-            while (predecessor != 0 && curr == predecessor->left()) {
-                curr = predecessor;
-                predecessor = predecessor->parent();
-            }
-        }
-    }
 
-    return predecessor;
+template<class T>
+void BinaryTree<T>::update_size(BinaryTreeNode<T> * node)
+{
+    node->set_size(1 + subtree_size(node->left()) + subtree_size(node->right()));
 }
 
 
@@ -1108,24 +3393,46 @@ void BinaryTree<T>::dft_preorder(BinaryTreeNode<T> * root)
 template<class T>
 void BinaryTree<T>::dft_preorder_iterative()
 {
+    dft_preorder_iterative(KeyPrinter());
+}
+
+
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::dft_preorder_iterative(Visitor visit)
+{
+    NodeBuffer buffer;
+    return dft_preorder_iterative(visit, buffer);
+}
+
+
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::dft_preorder_iterative(Visitor visit, NodeBuffer & buffer)
+{
+    buffer.clear();
+
     if (!m_root)
-        return;
+        return true;
 
-    std::stack<BinaryTreeNode<T> *> st;
     BinaryTreeNode<T> * btn = 0;
-    st.push(m_root);
+    buffer.push_back(m_root);
 
-    while (!st.empty())
+    while (!buffer.empty())
     {
-        btn = st.top();
-        std::cout << btn->key() << std::endl;
-        st.pop();
+        btn = buffer.back();
+        buffer.pop_back();
+
+        if (!visit(btn))
+            return false;
 
         // I push first right and then left into the stack because I want to
         // process the left node first!
-        if (btn->right()) st.push(btn->right());
-        if (btn->left()) st.push(btn->left());
+        if (btn->right()) buffer.push_back(btn->right());
+        if (btn->left()) buffer.push_back(btn->left());
     }
+
+    return true;
 }
 
 
@@ -1143,29 +3450,161 @@ void BinaryTree<T>::dft_inorder(BinaryTreeNode<T> * root)
 template<class T>
 void BinaryTree<T>::dft_inorder_iterative()
 {
-    std::stack<BinaryTreeNode<T> *> st;
+    dft_inorder_iterative(KeyPrinter());
+}
+
+
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::dft_inorder_iterative(Visitor visit)
+{
+    NodeBuffer buffer;
+    return dft_inorder_iterative(visit, buffer);
+}
+
+
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::dft_inorder_iterative(Visitor visit, NodeBuffer & buffer)
+{
+    buffer.clear();
+
     BinaryTreeNode<T> * btn = m_root;
-    bool finished = false;
 
-    while (!finished)
+    while (btn || !buffer.empty())
     {
         if (btn)
         {
-            st.push(btn);
+            buffer.push_back(btn);
             btn = btn->left();
         }
         else
         {
-            if (st.empty())
-                finished = true;
-            else
+            btn = buffer.back();
+            buffer.pop_back();
+
+            if (!visit(btn))
+                return false;
+
+            btn = btn->right();
+        }
+    }
+
+    return true;
+}
+
+
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::dft_inorder_morris(Visitor visit)
+{
+    BinaryTreeNode<T> * btn = m_root;
+
+    while (btn)
+    {
+        if (btn->left() == 0)
+        {
+            if (!visit(btn))
+            {
+                unthread(btn->right());
+                return false;
+            }
+            btn = btn->right();
+            continue;
+        }
+
+        BinaryTreeNode<T> * pred = btn->left();
+        while (pred->right() != 0 && pred->right() != btn)
+            pred = pred->right();
+
+        if (pred->right() == 0)
+        {
+            pred->set_right(btn);
+            btn = btn->left();
+        }
+        else
+        {
+            pred->set_right(0);
+            if (!visit(btn))
+            {
+                unthread(btn->right());
+                return false;
+            }
+            btn = btn->right();
+        }
+    }
+
+    return true;
+}
+
+
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::dft_preorder_morris(Visitor visit)
+{
+    BinaryTreeNode<T> * btn = m_root;
+
+    while (btn)
+    {
+        if (btn->left() == 0)
+        {
+            if (!visit(btn))
+            {
+                unthread(btn->right());
+                return false;
+            }
+            btn = btn->right();
+            continue;
+        }
+
+        BinaryTreeNode<T> * pred = btn->left();
+        while (pred->right() != 0 && pred->right() != btn)
+            pred = pred->right();
+
+        if (pred->right() == 0)
+        {
+            // The thread is set up before the visit, so that stopping here
+            // leaves the same threads as stopping anywhere in the subtree.
+            pred->set_right(btn);
+            if (!visit(btn))
             {
-                btn = st.top();
-                st.pop();
-                std::cout << btn->key() << std::endl;
-                btn = btn->right();
+                unthread(btn->left());
+                return false;
             }
+            btn = btn->left();
+        }
+        else
+        {
+            pred->set_right(0);
+            btn = btn->right();
+        }
+    }
+
+    return true;
+}
+
+
+template<class T>
+void BinaryTree<T>::unthread(BinaryTreeNode<T> * node)
+{
+    BinaryTreeNode<T> * btn = node;
+
+    while (btn)
+    {
+        if (btn->left() == 0)
+        {
+            btn = btn->right();
+            continue;
         }
+
+        BinaryTreeNode<T> * pred = btn->left();
+        while (pred->right() != 0 && pred->right() != btn)
+            pred = pred->right();
+
+        // A left subtree without a thread back was never entered.
+        if (pred->right() == btn)
+            pred->set_right(0);
+        btn = btn->right();
     }
 }
 
@@ -1184,34 +3623,57 @@ void BinaryTree<T>::dft_postorder(BinaryTreeNode<T> * root)
 template<class T>
 void BinaryTree<T>::dft_postorder_iterative()
 {
-    if (!m_root)
-        return;
+    dft_postorder_iterative(KeyPrinter());
+}
 
-    // Primary stack
-    std::stack<BinaryTreeNode<T> *> ps;
-    // Final stack
-    std::stack<BinaryTreeNode<T> *> fs;
 
-    ps.push(m_root);
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::dft_postorder_iterative(Visitor visit)
+{
+    NodeBuffer buffer;
+    return dft_postorder_iterative(visit, buffer);
+}
 
-    while (!ps.empty())
-    {
-        BinaryTreeNode<T> * btn = ps.top();
-        fs.push(btn);
-        ps.pop();
 
-        if (btn->left())
-            ps.push(btn->left());
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::dft_postorder_iterative(Visitor visit, NodeBuffer & buffer)
+{
+    buffer.clear();
 
-        if (btn->right())
-            ps.push(btn->right());
-    }
+    BinaryTreeNode<T> * btn = m_root;
+    BinaryTreeNode<T> * last = 0;
 
-    while (!fs.empty())
+    while (btn || !buffer.empty())
     {
-        std::cout << (fs.top())->key() << std::endl;
-        fs.pop();
+        if (btn)
+        {
+            buffer.push_back(btn);
+            btn = btn->left();
+        }
+        else
+        {
+            BinaryTreeNode<T> * top = buffer.back();
+
+            // Descend into the right subtree unless we are just coming back
+            // from it.
+            if (top->right() && top->right() != last)
+            {
+                btn = top->right();
+            }
+            else
+            {
+                if (!visit(top))
+                    return false;
+
+                last = top;
+                buffer.pop_back();
+            }
+        }
     }
+
+    return true;
 }
 
 
@@ -1233,32 +3695,188 @@ void BinaryTree<T>::dft_pre_in_post_order(BinaryTreeNode<T> * root,
 template<class T>
 void BinaryTree<T>::bft()
 {
+    bft(KeyPrinter());
+}
+
+
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::bft(Visitor visit)
+{
+    NodeBuffer buffer;
+    return bft(visit, buffer);
+}
+
+
+template<class T>
+template<class Visitor>
+bool BinaryTree<T>::bft(Visitor visit, NodeBuffer & buffer)
+{
+    buffer.clear();
+
     if (!m_root)
-        return;
+        return true;
 
-    // Create a queue.
-    std::queue<BinaryTreeNode<T> *> q;
+    typename NodeBuffer::size_type head = 0;
     BinaryTreeNode<T> * node = 0;
 
-    if (m_root)
-        q.push(m_root);
+    buffer.push_back(m_root);
 
-    while (!q.empty()) {
+    while (head < buffer.size()) {
         // Dequeue a node from the front.
-        node = q.front();
-        std::cout << node->key() << std::endl;
+        node = buffer[head++];
+
+        if (!visit(node))
+            return false;
 
         // Enqueue the left child.
         if (node->left() != 0)
-            q.push(node->left());
+            buffer.push_back(node->left());
 
         // Enqueue the right child.
         if (node->right() != 0)
-            q.push(node->right());
+            buffer.push_back(node->right());
+
+        // Drop the visited prefix once it dominates the buffer.
+        if (head >= 1024 && head * 2 >= buffer.size()) {
+            buffer.erase(buffer.begin(), buffer.begin() + head);
+            head = 0;
+        }
+    }
+
+    return true;
+}
+
+
+template<class T>
+template<class Visitor>
+std::vector<int> BinaryTree<T>::bft_parallel(Visitor visit, int threads)
+{
+    std::vector<int> counts;
+    if (!m_root)
+        return counts;
+
+    NodeBuffer frontier(1, m_root);
+    NodeBuffer next;
+    std::vector<int> offsets;
+    std::atomic<bool> stop(false);
+
+    // State shared with the workers: the pass to run, the chunk to claim
+    // next, and a generation counter that tells them a new pass started.
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    int generation = 0;
+    int pending = 0;
+    int pass = 0;
+    bool quit = false;
+    std::atomic<int> chunk(0);
+    int chunks = 0;
+
+    // Runs chunks of the current pass until there are none left.
+    auto work = [&]() {
+        for (int c = chunk++; c < chunks; c = chunk++)
+        {
+            size_t first = (size_t) c * BFT_CHUNK;
+            size_t last = std::min(first + BFT_CHUNK, frontier.size());
+
+            if (pass == 0)
+            {
+                int children = 0;
+                for (size_t i = first; i < last; i++)
+                {
+                    BinaryTreeNode<T> * node = frontier[i];
+                    if (!visit(node))
+                        stop = true;
+                    children += (node->left() != 0) + (node->right() != 0);
+                }
+                offsets[c + 1] = children;
+            }
+            else
+            {
+                BinaryTreeNode<T> ** out = &next[0] + offsets[c];
+                for (size_t i = first; i < last; i++)
+                {
+                    BinaryTreeNode<T> * node = frontier[i];
+                    if (node->left() != 0)
+                        *out++ = node->left();
+                    if (node->right() != 0)
+                        *out++ = node->right();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < threads; w++)
+    {
+        workers.push_back(std::thread([&]() {
+            int seen = 0;
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [&]() { return quit || generation != seen; });
+                    if (quit)
+                        return;
+                    seen = generation;
+                }
+                work();
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pending == 0)
+                    done.notify_one();
+            }
+        }));
+    }
+
+    // Runs one pass, with the workers if the level is wide enough.
+    auto run = [&](int p) {
+        pass = p;
+        chunk = 0;
+        if (workers.empty() || chunks < 2)
+        {
+            work();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = (int) workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        work();
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]() { return pending == 0; });
+    };
 
-        // Pop the visited node.
-        q.pop();
+    while (!frontier.empty())
+    {
+        counts.push_back((int) frontier.size());
+        chunks = (int) ((frontier.size() + BFT_CHUNK - 1) / BFT_CHUNK);
+        offsets.assign(chunks + 1, 0);
+
+        run(0);
+        if (stop)
+            break;
+
+        for (int c = 0; c < chunks; c++)
+            offsets[c + 1] += offsets[c];
+        next.resize(offsets[chunks]);
+        if (!next.empty())
+            run(1);
+
+        frontier.swap(next);
     }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wake.notify_all();
+    for (size_t w = 0; w < workers.size(); w++)
+        workers[w].join();
+
+    return counts;
 }
 
 #endif /* BINARYTREE_H_ */
@@ -13,8 +13,14 @@
 #include "binarytree.h"
 #include "binarytreenode.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <set>
 #include <stdlib.h>
+#include <sys/resource.h>
+#include <ctime>
 
 BinaryTree<int> * init_tree_std();
 void finalize_tree(BinaryTree<int> * tree);
@@ -43,6 +49,24 @@ void test_dft_postorder();
 void test_dft_postorder_iterative();
 void test_dft_pre_in_post_order();
 void test_bft();
+void test_traversal_visitor();
+void test_traversal_visitor_timing();
+void test_order_statistics();
+void test_build_balanced();
+void test_build_balanced_timing();
+void test_splay_finger_search();
+void test_search_zipf_timing();
+void test_split_join();
+void test_set_operations();
+void test_set_operations_timing();
+void test_bft_parallel();
+void test_bft_parallel_timing();
+void test_reduce();
+void test_reduce_timing();
+void test_morris_traversal();
+void test_morris_traversal_timing();
+void test_treap();
+void test_treap_range_timing();
 
 int main (int argc, char** argv)
 {
@@ -71,6 +95,24 @@ int main (int argc, char** argv)
 //    test_dft_postorder_iterative();
     test_dft_pre_in_post_order();
 //    test_bft();
+    test_traversal_visitor();
+    test_traversal_visitor_timing();
+    test_order_statistics();
+    test_build_balanced();
+    test_build_balanced_timing();
+    test_splay_finger_search();
+    test_search_zipf_timing();
+    test_split_join();
+    test_set_operations();
+    test_set_operations_timing();
+    test_bft_parallel();
+    test_bft_parallel_timing();
+    test_reduce();
+    test_reduce_timing();
+    test_morris_traversal();
+    test_morris_traversal_timing();
+    test_treap();
+    test_treap_range_timing();
 
     return EXIT_SUCCESS;
 }
@@ -781,3 +823,1185 @@ void test_bft()
     finalize_tree(bst);
     std::cout << std::endl;
 }
+
+
+/**
+ * Visitor that prints the keys it is given and asks the traversal to stop
+ * once it has seen a given key.
+ */
+struct PrintUntil
+{
+    int stop;
+
+    bool operator()(BinaryTreeNode<int> * node) const
+    {
+        std::cout << node->key() << " ";
+        return node->key() != stop;
+    }
+};
+
+/**
+ * Visitor that adds up the keys of the nodes it is given.
+ */
+struct KeySum
+{
+    long * sum;
+
+    bool operator()(BinaryTreeNode<int> * node) const
+    {
+        *sum += node->key();
+        return true;
+    }
+};
+
+/**
+ * Visitor that adds up the keys of the nodes it is given from several threads
+ * at once, and asks the traversal to stop once it has seen a given key.
+ */
+struct AtomicKeySum
+{
+    std::atomic<long> * sum;
+    int stop;
+
+    bool operator()(BinaryTreeNode<int> * node) const
+    {
+        *sum += node->key();
+        return node->key() != stop;
+    }
+};
+
+/**
+ * Reduction that counts the leaves of a subtree.
+ */
+struct LeafCount
+{
+    typedef int Value;
+
+    int operator()() const
+    {
+        return 0;
+    }
+
+    int operator()(BinaryTreeNode<int> * node, int left, int right) const
+    {
+        return (node->left() == 0 && node->right() == 0) ? 1 : left + right;
+    }
+};
+
+/**
+ * Visitor that collects the keys of the nodes it is given, and asks the
+ * traversal to stop once it has collected a given number of them.
+ */
+struct KeyCollector
+{
+    std::vector<int> * keys;
+    size_t limit;
+
+    bool operator()(BinaryTreeNode<int> * node) const
+    {
+        keys->push_back(node->key());
+        return keys->size() < limit;
+    }
+};
+
+/**
+ * Checks the parent pointers, the subtree sizes and the key order of a
+ * subtree.
+ */
+bool is_consistent(BinaryTreeNode<int> * node, BinaryTreeNode<int> * parent)
+{
+    if (node == 0)
+        return true;
+
+    int size = 1;
+    if (node->left())
+        size += node->left()->size();
+    if (node->right())
+        size += node->right()->size();
+
+    return node->parent() == parent && node->size() == size
+            && (node->left() == 0 || node->left()->key() < node->key())
+            && (node->right() == 0 || node->key() < node->right()->key())
+            && is_consistent(node->left(), node)
+            && is_consistent(node->right(), node);
+}
+
+/**
+ * Checks that the priorities of a subtree form a max-heap.
+ */
+bool is_heap_ordered(BinaryTreeNode<int> * node)
+{
+    if (node == 0)
+        return true;
+
+    return (node->left() == 0 || node->left()->priority() <= node->priority())
+            && (node->right() == 0 || node->right()->priority() <= node->priority())
+            && is_heap_ordered(node->left())
+            && is_heap_ordered(node->right());
+}
+
+/**
+ * Checks that a tree holds exactly the keys of a set, in order.
+ */
+bool same_keys(BinaryTree<int> * bst, const std::set<int> & keys)
+{
+    std::vector<int> inorder;
+    BinaryTreeNode<int> * node = bst->minimum(bst->root());
+    while (node)
+    {
+        inorder.push_back(node->key());
+        node = bst->successor_inorder(node);
+    }
+
+    return is_consistent(bst->root(), 0)
+            && inorder == std::vector<int>(keys.begin(), keys.end());
+}
+
+void test_traversal_visitor()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    BinaryTree<int>::NodeBuffer buffer;
+    PrintUntil all = { -1 };
+    PrintUntil until = { 125 };
+
+    std::cout << "Preorder:  ";
+    bst->dft_preorder_iterative(all, buffer);
+    std::cout << std::endl << "Inorder:   ";
+    bst->dft_inorder_iterative(all, buffer);
+    std::cout << std::endl << "Postorder: ";
+    bst->dft_postorder_iterative(all, buffer);
+    std::cout << std::endl << "BFT:       ";
+    bst->bft(all, buffer);
+    std::cout << std::endl;
+
+    std::cout << "Stopping at " << until.stop << ":" << std::endl;
+    std::cout << "Preorder:  ";
+    bool done = bst->dft_preorder_iterative(until, buffer);
+    std::cout << (done ? "(complete)" : "(stopped)") << std::endl << "Inorder:   ";
+    done = bst->dft_inorder_iterative(until, buffer);
+    std::cout << (done ? "(complete)" : "(stopped)") << std::endl << "Postorder: ";
+    done = bst->dft_postorder_iterative(until, buffer);
+    std::cout << (done ? "(complete)" : "(stopped)") << std::endl << "BFT:       ";
+    done = bst->bft(until, buffer);
+    std::cout << (done ? "(complete)" : "(stopped)") << std::endl;
+
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+void test_traversal_visitor_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int nodes = 200000;
+    const int rounds = 20;
+
+    srand(1);
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    for (int i = 0; i < nodes; i++)
+        bst->insert_iterative(new BinaryTreeNode<int>(rand()));
+
+    long queue_sum = 0;
+    clock_t start = clock();
+    for (int r = 0; r < rounds; r++)
+    {
+        std::queue<int> preQ;
+        std::queue<int> inQ;
+        std::queue<int> postQ;
+        bst->dft_pre_in_post_order(bst->root(), preQ, inQ, postQ);
+        while (!inQ.empty())
+        {
+            queue_sum += inQ.front();
+            inQ.pop();
+        }
+    }
+    double queue_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    long visitor_sum = 0;
+    KeySum summer = { &visitor_sum };
+    BinaryTree<int>::NodeBuffer buffer;
+    start = clock();
+    for (int r = 0; r < rounds; r++)
+        bst->dft_inorder_iterative(summer, buffer);
+    double visitor_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << nodes << " nodes, " << rounds << " rounds" << std::endl;
+    std::cout << "Queue copy:      " << queue_secs << "s (sum " << queue_sum << ")" << std::endl;
+    std::cout << "Inorder visitor: " << visitor_secs << "s (sum " << visitor_sum << ")" << std::endl;
+
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+void test_order_statistics()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+
+    std::cout << "Select (1..n):";
+    for (int k = 1; k <= bst->root()->size(); k++)
+        std::cout << " " << bst->select(k)->key();
+    std::cout << std::endl;
+    std::cout << "Select " << 0 << ": " << (bst->select(0) ? "found" : "none") << std::endl;
+
+    std::cout << "Rank of 110: " << bst->rank(110) << std::endl;
+    std::cout << "Rank of 111 (absent): " << bst->rank(111) << std::endl;
+    std::cout << "Keys in [50, 125]: " << bst->count_range(50, 125) << std::endl;
+    std::cout << "Keys in [51, 74]: " << bst->count_range(51, 74) << std::endl;
+
+    std::cout << "Removing 100 and 25." << std::endl;
+    bst->remove(bst->search_iterative(bst->root(), 100));
+    bst->remove(bst->search_iterative(bst->root(), 25));
+    std::cout << "Size: " << bst->root()->size() << std::endl;
+    std::cout << "Select 3: " << bst->select(3)->key() << std::endl;
+    std::cout << "Rank of 150: " << bst->rank(150) << std::endl;
+
+    std::cout << "Rotating right on root." << std::endl;
+    bst->rotate_right(bst->root_ref());
+    std::cout << "Root: " << bst->root()->key() << ", size: " << bst->root()->size() << std::endl;
+    std::cout << "Select (1..n):";
+    for (int k = 1; k <= bst->root()->size(); k++)
+        std::cout << " " << bst->select(k)->key();
+    std::cout << std::endl;
+    std::cout << "Keys in [0, 1000]: " << bst->count_range(0, 1000) << std::endl;
+
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+void test_build_balanced()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    Array<int> sorted(10);
+    for (int i = 0; i < sorted.size(); i++)
+        sorted[i] = (i + 1) * 10;
+
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    bst->build_balanced(sorted);
+
+    std::cout << "Built from array (BFT):";
+    PrintUntil all = { -1 };
+    bst->bft(all);
+    std::cout << std::endl;
+    std::cout << "Height " << bst->height(bst->root()) << ", "
+            << (bst->is_balanced(bst->root()) ? "balanced" : "not balanced")
+            << ", size " << bst->root()->size() << std::endl;
+
+    std::cout << "Removing 50 and 60, inserting 55." << std::endl;
+    bst->remove(bst->search_iterative(bst->root(), 50));
+    bst->remove(bst->search_iterative(bst->root(), 60));
+    bst->insert_iterative(new BinaryTreeNode<int>(55));
+    std::cout << "Inorder:";
+    bst->dft_inorder_iterative(all);
+    std::cout << std::endl;
+
+    std::vector<int> keys;
+    for (int i = 0; i < 7; i++)
+        keys.push_back(i);
+    bst->build_balanced(keys.begin(), keys.end());
+    std::cout << "Rebuilt from iterator range (BFT):";
+    bst->bft(all);
+    std::cout << std::endl;
+
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+void test_build_balanced_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int small = 20000;
+    const int large = 1 << 22;
+    Array<int> keys(large);
+    for (int i = 0; i < large; i++)
+        keys[i] = i;
+
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    clock_t start = clock();
+    for (int i = 0; i < small; i++)
+        bst->insert_iterative(new BinaryTreeNode<int>(keys[i]));
+    double insert_secs = double(clock() - start) / CLOCKS_PER_SEC;
+    finalize_tree(bst);
+
+    bst = new BinaryTree<int>();
+    start = clock();
+    bst->build_balanced(keys, small);
+    double build_secs = double(clock() - start) / CLOCKS_PER_SEC;
+    std::cout << small << " sorted keys: insert_iterative " << insert_secs
+            << "s, build_balanced " << build_secs << "s" << std::endl;
+
+    start = clock();
+    bst->build_balanced(keys);
+    build_secs = double(clock() - start) / CLOCKS_PER_SEC;
+    std::cout << large << " sorted keys: build_balanced " << build_secs << "s";
+
+    bst->build_balanced_parallel(keys, large, 4);
+    std::cout << ", parallel build height " << bst->height(bst->root())
+            << ", size " << bst->root()->size()
+            << ", 1000th key " << bst->select(1001)->key() << std::endl;
+
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+void test_splay_finger_search()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    PrintUntil all = { -1 };
+
+    std::cout << "Splaying 110: " << bst->search_splay(110)->key() << std::endl;
+    std::cout << "Root " << bst->root()->key() << ", BFT:";
+    bst->bft(all);
+    std::cout << std::endl;
+
+    std::cout << "Splaying 25: " << bst->search_splay(25)->key() << std::endl;
+    std::cout << "Root " << bst->root()->key() << ", BFT:";
+    bst->bft(all);
+    std::cout << std::endl;
+
+    std::cout << "Splaying absent 80: " << (bst->search_splay(80) ? "found" : "none")
+            << ", root " << bst->root()->key() << std::endl;
+    std::cout << "Inorder:";
+    bst->dft_inorder_iterative(all);
+    std::cout << std::endl;
+    std::cout << "Size " << bst->root()->size() << ", select 4: " << bst->select(4)->key() << std::endl;
+
+    std::cout << "Finger search:";
+    int keys[] = { 110, 125, 150, 175, 25, 111, 50, 100 };
+    for (int i = 0; i < 8; i++)
+    {
+        BinaryTreeNode<int> * node = bst->search_finger(keys[i]);
+        std::cout << " " << keys[i] << (node ? "+" : "-");
+    }
+    std::cout << std::endl;
+
+    std::cout << "Removing 100, then finger search 100 and 75:";
+    bst->remove(bst->search_finger(100));
+    std::cout << " " << (bst->search_finger(100) ? "found" : "none");
+    std::cout << " " << (bst->search_finger(75) ? "found" : "none") << std::endl;
+
+    // A tree built with insert_recursive has parent pointers too.
+    BinaryTree<int> recursive;
+    int recursive_keys[] = { 50, 25, 75, 10, 30, 60, 90 };
+    for (int i = 0; i < 7; i++)
+        recursive.insert_recursive(recursive.root_ref(), new BinaryTreeNode<int>(recursive_keys[i]));
+    std::cout << "Built with insert_recursive, finger search 60: "
+            << (recursive.search_finger(60) ? "found" : "none");
+    std::cout << ", splaying 30: " << recursive.search_splay(30)->key()
+            << ", root " << recursive.root()->key() << std::endl;
+
+    // Replacing the root drops the finger into the old tree.
+    BinaryTreeNode<int> * detached = recursive.root();
+    recursive.set_root(0);
+    std::cout << "Root detached, finger search 60: " << (recursive.search_finger(60) ? "found" : "none");
+    recursive.set_root(detached);
+    std::cout << "; reattached: " << (recursive.search_finger(60) ? "found" : "none") << std::endl;
+
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+/**
+ * Looks up Zipf-distributed keys (exponent 1) in a random tree, with plain,
+ * splaying and finger searches. Hot keys are scattered over the key space.
+ */
+void test_search_zipf_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int nodes = 100000;
+    const int lookups = 1000000;
+
+    std::vector<int> keys(nodes);
+    for (int i = 0; i < nodes; i++)
+        keys[i] = i;
+    srand(42);
+    for (int i = nodes - 1; i > 0; i--)
+        std::swap(keys[i], keys[rand() % (i + 1)]);
+
+    // The key of rank r is keys[r], so popular keys land anywhere.
+    std::vector<double> cdf(nodes);
+    double total = 0;
+    for (int r = 0; r < nodes; r++)
+    {
+        total += 1.0 / (r + 1);
+        cdf[r] = total;
+    }
+
+    std::vector<int> queries(lookups);
+    for (int i = 0; i < lookups; i++)
+    {
+        double u = total * rand() / ((double) RAND_MAX + 1);
+        int r = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+        queries[i] = keys[std::min(r, nodes - 1)];
+    }
+
+    const char * names[] = { "search_iterative", "search_splay", "search_finger" };
+    for (int mode = 0; mode < 3; mode++)
+    {
+        BinaryTree<int> * bst = new BinaryTree<int>();
+        for (int i = 0; i < nodes; i++)
+            bst->insert_iterative(new BinaryTreeNode<int>(keys[i]));
+
+        long found = 0;
+        clock_t start = clock();
+        for (int i = 0; i < lookups; i++)
+        {
+            BinaryTreeNode<int> * node;
+            if (mode == 0)
+                node = bst->search_iterative(bst->root(), queries[i]);
+            else if (mode == 1)
+                node = bst->search_splay(queries[i]);
+            else
+                node = bst->search_finger(queries[i]);
+            if (node)
+                found++;
+        }
+        double secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+        std::cout << names[mode] << ": " << secs << "s (" << found << " found)" << std::endl;
+        finalize_tree(bst);
+    }
+
+    std::cout << std::endl;
+}
+
+void test_split_join()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    int keys[] = { 10, 20, 30, 40, 50, 60, 70, 80, 90 };
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    bst->build_balanced(keys, 9);
+    PrintUntil all = { -1 };
+
+    BinaryTree<int> * left = new BinaryTree<int>();
+    BinaryTree<int> * right = new BinaryTree<int>();
+    std::cout << "Split around 40: " << (bst->split(40, *left, *right) ? "found" : "not found") << std::endl;
+    std::cout << "Left:";
+    left->dft_inorder_iterative(all);
+    std::cout << std::endl << "Right:";
+    right->dft_inorder_iterative(all);
+    std::cout << std::endl;
+    std::cout << "Split tree " << (bst->root() ? "not empty" : "empty") << std::endl;
+
+    std::cout << "Split right around 65: " << (right->split(65, *right, *bst) ? "found" : "not found") << std::endl;
+    std::cout << "Right:";
+    right->dft_inorder_iterative(all);
+    std::cout << std::endl << "Greater:";
+    bst->dft_inorder_iterative(all);
+    std::cout << std::endl;
+
+    bst->join(*left, 45, *right);
+    std::cout << "Joined left, 45 and right (BFT):";
+    bst->bft(all);
+    std::cout << std::endl;
+    std::cout << "Arguments " << (left->root() == 0 && right->root() == 0 ? "empty" : "not empty") << std::endl;
+
+    // Join a single key with a large tree: the key is attached deep down the
+    // left spine and the tree stays balanced.
+    std::set<int> expected;
+    std::vector<int> many;
+    for (int i = 1000; i < 2000; i++)
+    {
+        many.push_back(i);
+        expected.insert(i);
+    }
+    right->build_balanced(many.begin(), many.end());
+    left->join(*left, 500, *right);
+    left->split(1500, *left, *right);
+    right->join(*left, 1500, *right);
+    expected.insert(500);
+    std::cout << "Join/split round trip " << (same_keys(right, expected) ? "consistent" : "INCONSISTENT")
+            << ", height " << right->height(right->root()) << std::endl;
+
+    // Repeated round trips hand the same node block back and forth; the
+    // trees must not collect copies of it.
+    BinaryTree<int> whole;
+    BinaryTree<int> less;
+    BinaryTree<int> greater;
+    whole.build_balanced(many.begin(), many.end());
+    int most = 0;
+    for (int round = 0; round < 64; round++)
+    {
+        int key = 1000 + (round * 397) % 1000;
+        whole.split(key, less, greater);
+        whole.join(less, key, greater);
+        most = std::max(most, std::max(whole.blocks(), std::max(less.blocks(), greater.blocks())));
+    }
+    std::cout << "64 split/join round trips: at most " << most << " node blocks"
+            << (most == 1 && same_keys(&whole, std::set<int>(many.begin(), many.end())) ? " (ok)" : " (WRONG)")
+            << std::endl;
+
+    finalize_tree(left);
+    finalize_tree(right);
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+void test_set_operations()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    PrintUntil all = { -1 };
+    int odd[] = { 1, 3, 5, 7, 9, 11 };
+    int low[] = { 1, 2, 3, 4, 5 };
+
+    const char * names[] = { "Union", "Intersection", "Difference" };
+    for (int op = 0; op < 3; op++)
+    {
+        BinaryTree<int> * one = new BinaryTree<int>();
+        BinaryTree<int> * another = new BinaryTree<int>();
+        one->build_balanced(odd, 6);
+        another->build_balanced(low, 5);
+
+        if (op == 0)
+            one->set_union(*another, 1);
+        else if (op == 1)
+            one->set_intersection(*another, 1);
+        else
+            one->set_difference(*another, 1);
+
+        std::cout << names[op] << ":";
+        one->dft_inorder_iterative(all);
+        std::cout << std::endl;
+
+        finalize_tree(one);
+        finalize_tree(another);
+    }
+
+    // Random sets, checked against std::set, with trees built both ways.
+    srand(5);
+    bool consistent = true;
+    for (int round = 0; round < 30; round++)
+    {
+        std::set<int> a;
+        std::set<int> b;
+        BinaryTree<int> * one = new BinaryTree<int>();
+        BinaryTree<int> * another = new BinaryTree<int>();
+        int count = rand() % 300;
+        for (int i = 0; i < count; i++)
+            a.insert(rand() % 500);
+        std::vector<int> sorted(a.begin(), a.end());
+        one->build_balanced(sorted.begin(), sorted.end());
+
+        count = rand() % 300;
+        for (int i = 0; i < count; i++)
+        {
+            int key = rand() % 500;
+            if (b.insert(key).second)
+                another->insert_iterative(new BinaryTreeNode<int>(key));
+        }
+
+        std::set<int> expected;
+        int op = round % 3;
+        for (std::set<int>::iterator it = a.begin(); it != a.end(); ++it)
+            if ((op == 0) || (op == 1 && b.count(*it)) || (op == 2 && !b.count(*it)))
+                expected.insert(*it);
+        if (op == 0)
+            expected.insert(b.begin(), b.end());
+
+        if (op == 0)
+            one->set_union(*another, 4);
+        else if (op == 1)
+            one->set_intersection(*another, 4);
+        else
+            one->set_difference(*another, 4);
+
+        consistent = consistent && same_keys(one, expected) && another->root() == 0;
+
+        finalize_tree(one);
+        finalize_tree(another);
+    }
+    std::cout << "Random set operations " << (consistent ? "consistent" : "INCONSISTENT") << std::endl;
+
+    std::cout << std::endl;
+}
+
+void test_set_operations_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1 << 20;
+    int sizes[] = { 1 << 10, 1 << 16, 1 << 20 };
+
+    std::vector<int> big(n);
+    for (int i = 0; i < n; i++)
+        big[i] = 2 * i;
+
+    std::cout << "m\tkey by key\tunion (1 thread)\tunion (4 threads)" << std::endl;
+    for (int s = 0; s < 3; s++)
+    {
+        int m = sizes[s];
+        std::vector<int> small(m);
+        for (int i = 0; i < m; i++)
+            small[i] = (int) ((long long) i * n / m) * 2 + 1;
+
+        BinaryTree<int> * one = new BinaryTree<int>();
+        one->build_balanced(big.begin(), big.end());
+        clock_t start = clock();
+        for (int i = 0; i < m; i++)
+            one->insert_iterative(new BinaryTreeNode<int>(small[i]));
+        double insert_secs = double(clock() - start) / CLOCKS_PER_SEC;
+        finalize_tree(one);
+
+        double union_secs[2];
+        int threads[] = { 1, 4 };
+        for (int t = 0; t < 2; t++)
+        {
+            one = new BinaryTree<int>();
+            BinaryTree<int> * another = new BinaryTree<int>();
+            one->build_balanced(big.begin(), big.end());
+            another->build_balanced(small.begin(), small.end());
+
+            std::chrono::steady_clock::time_point wall = std::chrono::steady_clock::now();
+            one->set_union(*another, threads[t]);
+            union_secs[t] = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+
+            if (one->root()->size() != n + m)
+                std::cout << "Wrong union size " << one->root()->size() << std::endl;
+
+            finalize_tree(one);
+            finalize_tree(another);
+        }
+
+        std::cout << m << "\t" << insert_secs << "s\t" << union_secs[0] << "s\t\t"
+                << union_secs[1] << "s" << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+void test_bft_parallel()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    std::atomic<long> sum(0);
+    AtomicKeySum summer = { &sum, -1 };
+
+    std::vector<int> counts = bst->bft_parallel(summer, 4);
+    std::cout << "Nodes per level:";
+    for (size_t i = 0; i < counts.size(); i++)
+        std::cout << " " << counts[i];
+    std::cout << " (sum " << sum << ")" << std::endl;
+    finalize_tree(bst);
+
+    // A tree wide enough to be split among the threads: the levels of a
+    // balanced tree are full, but for the last one.
+    const int n = 100000;
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; i++)
+        keys[i] = i;
+    bst = new BinaryTree<int>();
+    bst->build_balanced(keys.begin(), keys.end());
+
+    long expected = (long) n * (n - 1) / 2;
+    int threads[] = { 1, 2, 4 };
+    for (int t = 0; t < 3; t++)
+    {
+        sum = 0;
+        counts = bst->bft_parallel(summer, threads[t]);
+
+        int total = 0;
+        bool full = true;
+        for (size_t i = 0; i < counts.size(); i++)
+        {
+            total += counts[i];
+            if (i + 1 < counts.size() && counts[i] != 1 << i)
+                full = false;
+        }
+        std::cout << threads[t] << " threads: " << counts.size() << " levels, "
+                << total << " nodes, sum " << sum
+                << ((total == n && full && sum == expected) ? " (ok)" : " (WRONG)") << std::endl;
+    }
+
+    // Stopping at the root's right child still finishes its level.
+    sum = 0;
+    summer.stop = bst->root()->right()->key();
+    counts = bst->bft_parallel(summer, 4);
+    std::cout << "Stopping at " << summer.stop << ": " << counts.size() << " levels, sum " << sum
+            << ((counts.size() == 2 && sum == bst->root()->key() + bst->root()->left()->key() + summer.stop) ? " (ok)" : " (WRONG)")
+            << std::endl;
+
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+void test_bft_parallel_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1 << 22;
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; i++)
+        keys[i] = i;
+
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    bst->build_balanced(keys.begin(), keys.end());
+
+    long serial_sum = 0;
+    KeySum summer = { &serial_sum };
+    BinaryTree<int>::NodeBuffer buffer;
+    std::chrono::steady_clock::time_point wall = std::chrono::steady_clock::now();
+    bst->bft(summer, buffer);
+    double serial_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+    std::cout << n << " nodes" << std::endl;
+    std::cout << "bft:                     " << serial_secs << "s (sum " << serial_sum << ")" << std::endl;
+
+    std::atomic<long> sum(0);
+    AtomicKeySum atomic_summer = { &sum, -1 };
+    int threads[] = { 1, 2, 4, 8 };
+    for (int t = 0; t < 4; t++)
+    {
+        sum = 0;
+        wall = std::chrono::steady_clock::now();
+        std::vector<int> counts = bst->bft_parallel(atomic_summer, threads[t]);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+        std::cout << "bft_parallel (" << threads[t] << " threads): " << secs << "s (sum " << sum
+                << ", " << counts.size() << " levels)" << std::endl;
+    }
+
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+void test_reduce()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    BinaryTree<int>::Summary summary = bst->summarize(bst->root(), 4);
+    std::cout << "Height " << bst->height(bst->root()) << ", "
+            << (bst->is_balanced(bst->root()) ? "balanced" : "not balanced")
+            << ", " << bst->reduce(bst->root(), LeafCount(), 4) << " leaves" << std::endl;
+    std::cout << "Size " << summary.size << ", height " << summary.height
+            << ", sum " << summary.sum << ", min " << summary.min << ", max " << summary.max
+            << (summary.balanced ? ", balanced" : ", not balanced") << std::endl;
+    finalize_tree(bst);
+
+    // A balanced tree large enough to be split among the threads, and small
+    // enough for the sum of its keys to fit in an int.
+    const int n = (1 << 16) - 1;
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; i++)
+        keys[i] = i;
+    bst = new BinaryTree<int>();
+    bst->build_balanced(keys.begin(), keys.end());
+
+    int threads[] = { 1, 2, 3, 4 };
+    for (int t = 0; t < 4; t++)
+    {
+        summary = bst->summarize(bst->root(), threads[t]);
+        bool ok = bst->height(bst->root(), threads[t]) == 16
+                && bst->is_balanced(bst->root(), threads[t])
+                && bst->reduce(bst->root(), LeafCount(), threads[t]) == (n + 1) / 2
+                && summary.size == n && summary.height == 16 && summary.balanced
+                && summary.sum == (long) n * (n - 1) / 2 && summary.min == 0 && summary.max == n - 1;
+        std::cout << threads[t] << " threads, balanced tree: " << (ok ? "ok" : "WRONG") << std::endl;
+    }
+    finalize_tree(bst);
+
+    // A caterpillar: a long right spine with a leaf hanging to the left of
+    // every spine node. Every split gives all the threads to the spine.
+    const int spine = 20000;
+    BinaryTreeNode<int> * root = 0;
+    for (int i = spine - 1; i >= 0; i--)
+    {
+        BinaryTreeNode<int> * leaf = new BinaryTreeNode<int>(2 * i);
+        BinaryTreeNode<int> * node = new BinaryTreeNode<int>(2 * i + 1, 0, leaf, root);
+        leaf->set_parent(node);
+        if (root)
+            root->set_parent(node);
+        root = node;
+    }
+    bst = new BinaryTree<int>(root);
+
+    for (int t = 0; t < 4; t++)
+    {
+        summary = bst->summarize(bst->root(), threads[t]);
+        bool ok = bst->height(bst->root(), threads[t]) == spine + 1
+                && !bst->is_balanced(bst->root(), threads[t])
+                && bst->reduce(bst->root(), LeafCount(), threads[t]) == spine
+                && summary.size == 2 * spine && summary.height == spine + 1 && !summary.balanced
+                && summary.sum == (long) (2 * spine) * (2 * spine - 1) / 2
+                && summary.min == 0 && summary.max == 2 * spine - 1;
+        std::cout << threads[t] << " threads, caterpillar: " << (ok ? "ok" : "WRONG") << std::endl;
+    }
+    finalize_tree(bst);
+
+    std::cout << std::endl;
+}
+
+void test_reduce_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1 << 22;
+    std::vector<long> keys(n);
+    for (int i = 0; i < n; i++)
+        keys[i] = i;
+
+    // Long keys, so that their sum does not overflow.
+    BinaryTree<long> * bst = new BinaryTree<long>();
+    bst->build_balanced(keys.begin(), keys.end());
+    std::cout << n << " nodes" << std::endl;
+
+    int threads[] = { 1, 2, 4, 8 };
+    for (int t = 0; t < 4; t++)
+    {
+        std::chrono::steady_clock::time_point wall = std::chrono::steady_clock::now();
+        bool balanced = bst->is_balanced(bst->root(), threads[t]);
+        double balanced_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+
+        wall = std::chrono::steady_clock::now();
+        BinaryTree<long>::Summary summary = bst->summarize(bst->root(), threads[t]);
+        double summary_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+
+        std::cout << threads[t] << " threads: is_balanced " << balanced_secs << "s ("
+                << (balanced ? "balanced" : "not balanced") << "), summarize " << summary_secs
+                << "s (height " << summary.height << ", sum " << summary.sum << ")" << std::endl;
+    }
+
+    bst->destroy(bst->root_ref());
+    delete bst;
+    std::cout << std::endl;
+}
+
+/**
+ * Peak resident set size of the process so far, in kilobytes.
+ */
+long peak_rss()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+void test_morris_traversal()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    PrintUntil all = { -1 };
+    PrintUntil until = { 125 };
+
+    std::cout << "Inorder:  ";
+    bst->dft_inorder_morris(all);
+    std::cout << std::endl << "Preorder: ";
+    bst->dft_preorder_morris(all);
+    std::cout << std::endl;
+
+    std::cout << "Stopping at " << until.stop << ":" << std::endl << "Inorder:  ";
+    bool done = bst->dft_inorder_morris(until);
+    std::cout << (done ? "(complete)" : "(stopped)") << std::endl << "Preorder: ";
+    done = bst->dft_preorder_morris(until);
+    std::cout << (done ? "(complete)" : "(stopped)") << std::endl;
+    std::cout << "Tree after the stopped traversals (BFT): ";
+    bst->bft(all);
+    std::cout << std::endl;
+    finalize_tree(bst);
+
+    // Random trees, stopped after every possible number of visits: the
+    // visits have to match the stack-based traversals and the tree has to be
+    // restored.
+    srand(7);
+    bool ok = true;
+    for (int round = 0; round < 50 && ok; round++)
+    {
+        bst = new BinaryTree<int>();
+        std::set<int> keys;
+        int n = 1 + rand() % 60;
+        for (int i = 0; i < n; i++)
+        {
+            int key = rand() % 1000;
+            if (keys.insert(key).second)
+                bst->insert_iterative(new BinaryTreeNode<int>(key));
+        }
+
+        std::vector<int> inorder;
+        std::vector<int> preorder;
+        KeyCollector in_all = { &inorder, keys.size() + 1 };
+        KeyCollector pre_all = { &preorder, keys.size() + 1 };
+        bst->dft_inorder_iterative(in_all);
+        bst->dft_preorder_iterative(pre_all);
+
+        for (size_t limit = 1; limit <= keys.size() + 1 && ok; limit++)
+        {
+            std::vector<int> in;
+            std::vector<int> pre;
+            KeyCollector in_some = { &in, limit };
+            KeyCollector pre_some = { &pre, limit };
+            bool in_done = bst->dft_inorder_morris(in_some);
+            bool pre_done = bst->dft_preorder_morris(pre_some);
+
+            size_t seen = std::min(limit, keys.size());
+            ok = in_done == (limit > keys.size()) && pre_done == (limit > keys.size())
+                    && in == std::vector<int>(inorder.begin(), inorder.begin() + seen)
+                    && pre == std::vector<int>(preorder.begin(), preorder.begin() + seen)
+                    && same_keys(bst, keys);
+        }
+
+        finalize_tree(bst);
+    }
+    std::cout << "Random trees, stopped at every node: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+void test_morris_traversal_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int nodes = 1000000;
+    const int rounds = 5;
+
+    // A random tree, whose height is logarithmic.
+    srand(1);
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    for (int i = 0; i < nodes; i++)
+        bst->insert_iterative(new BinaryTreeNode<int>(rand()));
+
+    long stack_sum = 0;
+    KeySum stack_summer = { &stack_sum };
+    BinaryTree<int>::NodeBuffer buffer;
+    clock_t start = clock();
+    for (int r = 0; r < rounds; r++)
+        bst->dft_inorder_iterative(stack_summer, buffer);
+    double stack_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    long morris_sum = 0;
+    KeySum morris_summer = { &morris_sum };
+    start = clock();
+    for (int r = 0; r < rounds; r++)
+        bst->dft_inorder_morris(morris_summer);
+    double morris_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << "Random tree, " << nodes << " nodes, " << rounds << " rounds" << std::endl;
+    std::cout << "dft_inorder_iterative: " << stack_secs << "s (sum " << stack_sum << ", stack "
+            << buffer.capacity() * sizeof(BinaryTreeNode<int> *) << " bytes)" << std::endl;
+    std::cout << "dft_inorder_morris:    " << morris_secs << "s (sum " << morris_sum << ")" << std::endl;
+    finalize_tree(bst);
+
+    // A left spine, on which the stack holds every node. The nodes are
+    // deleted by hand, since destroy would recurse down the whole spine. The
+    // Morris traversal runs first, so that the growth of the peak resident
+    // set size is due to the stack alone; it only shows when the peak of the
+    // earlier tests is lower, e.g. when this test runs on its own.
+    BinaryTreeNode<int> * root = 0;
+    for (int i = nodes - 1; i >= 0; i--)
+    {
+        BinaryTreeNode<int> * node = new BinaryTreeNode<int>(nodes - i, 0, root, 0);
+        if (root)
+            root->set_parent(node);
+        root = node;
+    }
+    bst = new BinaryTree<int>(root);
+
+    morris_sum = 0;
+    long rss = peak_rss();
+    start = clock();
+    bst->dft_inorder_morris(morris_summer);
+    morris_secs = double(clock() - start) / CLOCKS_PER_SEC;
+    long morris_rss = peak_rss() - rss;
+
+    stack_sum = 0;
+    BinaryTree<int>::NodeBuffer spine_buffer;
+    rss = peak_rss();
+    start = clock();
+    bst->dft_inorder_iterative(stack_summer, spine_buffer);
+    stack_secs = double(clock() - start) / CLOCKS_PER_SEC;
+    long stack_rss = peak_rss() - rss;
+
+    std::cout << "Left spine, " << nodes << " nodes" << std::endl;
+    std::cout << "dft_inorder_iterative: " << stack_secs << "s (sum " << stack_sum
+            << ", stack " << spine_buffer.capacity() * sizeof(BinaryTreeNode<int> *)
+            << " bytes, peak RSS +" << stack_rss << " KB)" << std::endl;
+    std::cout << "dft_inorder_morris:    " << morris_secs << "s (sum " << morris_sum
+            << ", peak RSS +" << morris_rss << " KB)" << std::endl;
+
+    while (root)
+    {
+        BinaryTreeNode<int> * left = root->left();
+        delete root;
+        root = left;
+    }
+    bst->root_ref() = 0;
+    delete bst;
+
+    std::cout << std::endl;
+}
+
+void test_treap()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    // Sorted insertions, which make a plain binary search tree a list.
+    const int n = 100000;
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    std::set<int> keys;
+    for (int i = 0; i < n; i++)
+    {
+        bst->insert_treap(new BinaryTreeNode<int>(i));
+        keys.insert(i);
+    }
+    std::cout << n << " sorted insertions: height " << bst->height(bst->root())
+            << (same_keys(bst, keys) && is_heap_ordered(bst->root()) ? " (ok)" : " (WRONG)") << std::endl;
+
+    // Remove every other key, by node.
+    for (int i = 0; i < n; i += 2)
+    {
+        bst->remove_treap(bst->search_iterative(bst->root(), i));
+        keys.erase(i);
+    }
+    std::cout << "Odd keys left: height " << bst->height(bst->root())
+            << (same_keys(bst, keys) && is_heap_ordered(bst->root()) ? " (ok)" : " (WRONG)") << std::endl;
+
+    // Split and merge back.
+    BinaryTree<int> left;
+    BinaryTree<int> right;
+    bst->split_treap(n / 3, left, right);
+    std::set<int> less(keys.begin(), keys.lower_bound(n / 3));
+    std::set<int> greater(keys.lower_bound(n / 3), keys.end());
+    bool ok = bst->root() == 0 && same_keys(&left, less) && same_keys(&right, greater)
+            && is_heap_ordered(left.root()) && is_heap_ordered(right.root());
+    bst->merge_treap(left, right);
+    ok = ok && left.root() == 0 && right.root() == 0
+            && same_keys(bst, keys) && is_heap_ordered(bst->root());
+    std::cout << "Split at " << n / 3 << " and merge: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    // Random range removals, checked against a set.
+    srand(3);
+    ok = true;
+    for (int round = 0; round < 200 && ok; round++)
+    {
+        int lo = rand() % n;
+        int hi = lo + rand() % 100;
+        int expected = (int) std::distance(keys.lower_bound(lo), keys.upper_bound(hi));
+        keys.erase(keys.lower_bound(lo), keys.upper_bound(hi));
+
+        ok = bst->remove_range_treap(lo, hi) == expected
+                && is_heap_ordered(bst->root());
+    }
+    ok = ok && same_keys(bst, keys);
+    std::cout << "Random range removals, " << keys.size() << " keys left: " << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << "Empty range removes " << bst->remove_range_treap(10, 5) << " keys" << std::endl;
+
+    // Round trips of a bulk-built tree, whose nodes share one block and
+    // equal priorities, must not make the trees collect copies of it.
+    std::vector<int> sorted;
+    for (int i = 0; i < 1000; i++)
+        sorted.push_back(i);
+    BinaryTree<int> whole;
+    whole.build_balanced(sorted.begin(), sorted.end());
+    int most = 0;
+    for (int round = 0; round < 64; round++)
+    {
+        whole.split_treap((round * 397) % 1000, left, right);
+        whole.merge_treap(left, right);
+        most = std::max(most, std::max(whole.blocks(), std::max(left.blocks(), right.blocks())));
+    }
+    std::cout << "64 split/merge round trips: at most " << most << " node blocks"
+            << (most == 1 && same_keys(&whole, std::set<int>(sorted.begin(), sorted.end())) ? " (ok)" : " (WRONG)")
+            << std::endl;
+
+    finalize_tree(bst);
+    std::cout << std::endl;
+}
+
+void test_treap_range_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    // Entries keyed by their arrival time; every tick, the oldest window of
+    // entries expires.
+    const int n = 1000000;
+    const int window = 10000;
+
+    double insert_secs = 0;
+    double expire_secs[2];
+    for (int mode = 0; mode < 2; mode++)
+    {
+        BinaryTree<int> * bst = new BinaryTree<int>();
+        clock_t start = clock();
+        for (int i = 0; i < n; i++)
+            bst->insert_treap(new BinaryTreeNode<int>(i));
+        insert_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+        long removed = 0;
+        start = clock();
+        for (int t = 0; t + window <= n; t += window)
+        {
+            if (mode == 0)
+            {
+                for (BinaryTreeNode<int> * node = bst->minimum(bst->root());
+                        node != 0 && node->key() < t + window;
+                        node = bst->minimum(bst->root()))
+                {
+                    bst->remove_treap(node);
+                    removed++;
+                }
+            }
+            else
+            {
+                removed += bst->remove_range_treap(t, t + window - 1);
+            }
+        }
+        expire_secs[mode] = double(clock() - start) / CLOCKS_PER_SEC;
+
+        if (removed != n || bst->root() != 0)
+            std::cout << "Wrong number of keys removed: " << removed << std::endl;
+        finalize_tree(bst);
+    }
+
+    std::cout << n << " time-keyed insertions: " << insert_secs << "s" << std::endl;
+    std::cout << "Expiry of windows of " << window << " keys:" << std::endl;
+    std::cout << "remove_treap of the minimum: " << expire_secs[0] << "s" << std::endl;
+    std::cout << "remove_range_treap:          " << expire_secs[1] << "s" << std::endl;
+
+    std::cout << std::endl;
+}
@@ -8,6 +8,13 @@
  *
  * @brief Binary (search) tree node class definition.
  *
+ * Besides the key and the links, every node stores the number of nodes in the
+ * subtree rooted at it (itself included). The size is what turns the binary
+ * search tree into an order-statistic tree; it is kept up to date by the
+ * mutating operations of BinaryTree and is only meaningful for trees built
+ * through them. A node also carries a priority, which is only used by the
+ * treap operations of BinaryTree.
+ *
  * @created Dec 21, 2012
  * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
  */
@@ -102,6 +109,23 @@ public:
      */
     BinaryTreeNode<T> *& right_ref();
 
+    /**
+     * Getter for the size of the subtree rooted at the binary tree node.
+     *
+     * @return
+     *     The number of nodes in the subtree rooted at this binary tree node,
+     *     including the node itself.
+     */
+    int size() const;
+
+    /**
+     * Getter for the binary tree node's treap priority.
+     *
+     * @return
+     *     The priority of this binary tree node.
+     */
+    unsigned int priority() const;
+
     // -- setter methods
 
     /**
@@ -137,6 +161,22 @@ public:
      *     child.
      */
     void set_right(BinaryTreeNode<T> * right);
+
+    /**
+     * Setter for the size of the subtree rooted at the binary tree node.
+     *
+     * @param[in] size
+     *     The number of nodes in the subtree rooted at this binary tree node.
+     */
+    void set_size(int size);
+
+    /**
+     * Setter for the binary tree node's treap priority.
+     *
+     * @param[in] priority
+     *     The priority to be set for this binary tree node.
+     */
+    void set_priority(unsigned int priority);
 protected:
 private:
     /**
@@ -158,6 +198,17 @@ private:
      * A pointer to the right child of this binary tree node.
      */
     BinaryTreeNode<T> * m_right;
+
+    /**
+     * The number of nodes in the subtree rooted at this binary tree node.
+     */
+    int m_size;
+
+    /**
+     * The treap priority of this binary tree node; no smaller than the
+     * priorities of its children in a tree built by the treap operations.
+     */
+    unsigned int m_priority;
 };
 
 
@@ -168,6 +219,8 @@ BinaryTreeNode<T>::BinaryTreeNode()
     m_parent = 0;
     m_left = 0;
     m_right = 0;
+    m_size = 1;
+    m_priority = 0;
 }
 
 
@@ -178,6 +231,8 @@ BinaryTreeNode<T>::BinaryTreeNode(T key)
     m_parent = 0;
     m_left = 0;
     m_right = 0;
+    m_size = 1;
+    m_priority = 0;
 }
 
 
@@ -193,6 +248,8 @@ BinaryTreeNode<T>::BinaryTreeNode(
     m_parent = parent;
     m_left = left;
     m_right = right;
+    m_size = 1 + (left ? left->size() : 0) + (right ? right->size() : 0);
+    m_priority = 0;
 }
 
 
@@ -244,6 +301,20 @@ BinaryTreeNode<T> *& BinaryTreeNode<T>::right_ref()
 }
 
 
+template<class T>
+int BinaryTreeNode<T>::size() const
+{
+    return m_size;
+}
+
+
+template<class T>
+unsigned int BinaryTreeNode<T>::priority() const
+{
+    return m_priority;
+}
+
+
 template<class T>
 void BinaryTreeNode<T>::set_key(const T & key)
 {
@@ -271,4 +342,18 @@ void BinaryTreeNode<T>::set_right(BinaryTreeNode<T> * right)
     m_right = right;
 }
 
+
+template<class T>
+void BinaryTreeNode<T>::set_size(int size)
+{
+    m_size = size;
+}
+
+
+template<class T>
+void BinaryTreeNode<T>::set_priority(unsigned int priority)
+{
+    m_priority = priority;
+}
+
 #endif /* BINARYTREENODE_H_ */
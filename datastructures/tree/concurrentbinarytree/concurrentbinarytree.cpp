@@ -0,0 +1,14 @@
+/**
+ * @class ConcurrentBinaryTree
+ *
+ * @file concurrentbinarytree.cpp
+ *
+ * @brief Concurrent binary search tree class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "concurrentbinarytree.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,726 @@
+#ifndef CONCURRENTBINARYTREE_H_
+#define CONCURRENTBINARYTREE_H_
+
+#include "concurrentbinarytreenode.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/**
+ * @class ConcurrentBinaryTree
+ *
+ * @file concurrentbinarytree.h
+ *
+ * Concurrent binary search tree class definition.
+ *
+ * <p>
+ * An ordered set of unique keys that can be used by many threads at once
+ * without an external lock. Writers (<code>insert</code> and
+ * <code>remove</code>) use <em>hand-over-hand</em> (lock coupling) locking:
+ * a writer locks a child before it releases the parent, so it always holds
+ * the lock of the node whose link it is about to change, while writers
+ * working in disjoint parts of the tree do not block each other. Readers
+ * (<code>search_iterative</code>, <code>minimum</code>, <code>maximum</code>
+ * and <code>successor_inorder</code>) take no lock at all.
+ *
+ * Inserting a leaf or unlinking a node with at most one child is a single
+ * pointer store, so a lock-free reader either sees the tree before or after
+ * the change and its result is correct either way. Removing a node with two
+ * children is different: the inorder successor has to move up into the place
+ * of the removed node. Keys never change in this tree, so the removed node
+ * is replaced by a fresh copy of the successor, and only then the successor
+ * is unlinked from below. A reader that was already inside the old node's
+ * right subtree may, however, miss the successor's key after it has been
+ * unlinked from below. Such <em>relocations</em> are counted when they start
+ * and when they finish, and a reader whose answer depends on the tree's
+ * shape validates it <em>optimistically</em>: if a relocation overlapped the
+ * read, it retries. After a few failed attempts it falls back to a locked
+ * hand-over-hand descent, which cannot be overtaken by a writer.
+ *
+ * Since readers hold no locks, an unlinked node cannot be deleted right
+ * away; it is reclaimed by <em>epochs</em> instead. A global epoch counter
+ * only ever goes up, and a reader registers in the epoch it starts in, in
+ * one of two counters (by the parity of the epoch) of one of several
+ * cache-line sized stripes, picked per thread. A retired node is stamped
+ * with the epoch current when it was unlinked. On every retirement the
+ * writer tries, up to twice, to advance the epoch from e to e + 1, which
+ * it may do as soon as no reader of epoch e - 1 is left; every reader in
+ * flight then started in epoch e or later. A node stamped r is deleted once
+ * the epoch has reached r + 2, since by then every reader in flight started
+ * after it was unlinked. Readers leave the old parity as fast as they
+ * finish, so under any steady read traffic the epoch keeps advancing and
+ * the retired list stays short; only a reader that stalls holds
+ * reclamation back.
+ *
+ * The tree is not balanced; the usual remarks on the height of binary search
+ * trees built from random insertions apply (see binarytree.h).
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class ConcurrentBinaryTree {
+public:
+    /**
+     * Default constructor.
+     */
+    ConcurrentBinaryTree();
+
+    /**
+     * Destructor.
+     *
+     * Must not run concurrently with any other operation on the tree.
+     */
+    virtual ~ConcurrentBinaryTree();
+
+    // -- public methods
+
+    /**
+     * Inserts a key into the tree. Takes O(h) time, on a tree of height h.
+     *
+     * @param[in] key
+     *     The key to insert.
+     *
+     * @return
+     *     <code>true</code> if the key was inserted; <code>false</code> if it
+     *     was already present.
+     */
+    bool insert(T key);
+
+    /**
+     * Removes a key from the tree. Takes O(h) time, on a tree of height h.
+     *
+     * @param[in] key
+     *     The key to remove.
+     *
+     * @return
+     *     <code>true</code> if the key was removed; <code>false</code> if it
+     *     was not present.
+     */
+    bool remove(T key);
+
+    /**
+     * Lock-free lookup of a key. Takes O(h) time, on a tree of height h.
+     *
+     * @param[in] key
+     *     The key to search.
+     *
+     * @return
+     *     <code>true</code> if the key is present; <code>false</code>
+     *     otherwise.
+     */
+    bool search_iterative(T key);
+
+    /**
+     * Lock-free location of the minimum key in the tree.
+     *
+     * @param[out] key
+     *     Set to the minimum key if the tree is not empty.
+     *
+     * @return
+     *     <code>false</code> for an empty tree; <code>true</code> otherwise.
+     */
+    bool minimum(T & key);
+
+    /**
+     * Lock-free location of the maximum key in the tree.
+     *
+     * @param[out] key
+     *     Set to the maximum key if the tree is not empty.
+     *
+     * @return
+     *     <code>false</code> for an empty tree; <code>true</code> otherwise.
+     */
+    bool maximum(T & key);
+
+    /**
+     * Lock-free location of the smallest key greater than the given one.
+     *
+     * The nodes carry no parent pointers (they could not be kept consistent
+     * without locking readers out), so the successor is found top-down: the
+     * last node at which the descent towards the given key turned left is
+     * the successor.
+     *
+     * @param[in] key
+     *     The key whose successor is to be found. It need not be present.
+     * @param[out] successor
+     *     Set to the successor if there is one.
+     *
+     * @return
+     *     <code>true</code> if a successor exists; <code>false</code>
+     *     otherwise.
+     */
+    bool successor_inorder(T key, T & successor);
+
+    /**
+     * The number of removed nodes that are waiting to be deleted.
+     *
+     * @return
+     *     The length of the retired list.
+     */
+    int retired();
+protected:
+private:
+    typedef ConcurrentBinaryTreeNode<T> Node;
+
+    /**
+     * Outcome of a descent step: continue left, continue right or stop.
+     */
+    enum Direction { LEFT, RIGHT, STOP };
+
+    /**
+     * Descent step for <code>search_iterative</code>.
+     */
+    struct SearchStep
+    {
+        T key;
+        bool found;
+        T result;
+
+        SearchStep(const T & k) : key(k), found(false), result(k) {}
+        void reset() { found = false; }
+        // A key that was seen is a correct answer even if the tree changed.
+        bool settled() const { return found; }
+        Direction operator()(const Node * node)
+        {
+            if (key == node->key()) {
+                found = true;
+                return STOP;
+            }
+            return key < node->key() ? LEFT : RIGHT;
+        }
+    };
+
+    /**
+     * Descent step for <code>minimum</code>.
+     */
+    struct MinimumStep
+    {
+        bool found;
+        T result;
+
+        MinimumStep(const T & seed) : found(false), result(seed) {}
+        void reset() { found = false; }
+        bool settled() const { return false; }
+        Direction operator()(const Node * node)
+        {
+            found = true;
+            result = node->key();
+            return LEFT;
+        }
+    };
+
+    /**
+     * Descent step for <code>maximum</code>.
+     */
+    struct MaximumStep
+    {
+        bool found;
+        T result;
+
+        MaximumStep(const T & seed) : found(false), result(seed) {}
+        void reset() { found = false; }
+        bool settled() const { return false; }
+        Direction operator()(const Node * node)
+        {
+            found = true;
+            result = node->key();
+            return RIGHT;
+        }
+    };
+
+    /**
+     * Descent step for <code>successor_inorder</code>.
+     */
+    struct SuccessorStep
+    {
+        T key;
+        bool found;
+        T result;
+
+        SuccessorStep(const T & k) : key(k), found(false), result(k) {}
+        void reset() { found = false; }
+        bool settled() const { return false; }
+        Direction operator()(const Node * node)
+        {
+            if (key < node->key()) {
+                found = true;
+                result = node->key();
+                return LEFT;
+            }
+            return RIGHT;
+        }
+    };
+
+    /**
+     * The number of reader counters. Readers are spread over them so that
+     * they do not all bounce the same cache line between cores.
+     */
+    static const int READER_STRIPES = 64;
+
+    /**
+     * The reader counters of a stripe, one per epoch parity, padded to a
+     * cache line of their own.
+     */
+    struct ReaderStripe
+    {
+        std::atomic<int> count[2];
+        char padding[64 - 2 * sizeof(std::atomic<int>)];
+    };
+
+    /**
+     * Registers a lock-free reader in the current epoch for the lifetime of
+     * the object.
+     */
+    struct ReaderGuard
+    {
+        std::atomic<int> * readers;
+
+        ReaderGuard(ReaderStripe & stripe, std::atomic<unsigned long> & epoch)
+        {
+            // A reader that read an epoch which has moved on by the time it
+            // is counted must not go ahead in it: the writer that moved it
+            // may have found that parity empty already.
+            for (;;) {
+                unsigned long e = epoch.load();
+                readers = &stripe.count[e & 1];
+                (*readers)++;
+                if (epoch.load() == e)
+                    break;
+                (*readers)--;
+            }
+        }
+        ~ReaderGuard() { (*readers)--; }
+    };
+
+    /**
+     * The reader counter stripe of the calling thread.
+     *
+     * @return
+     *     The stripe index, assigned round robin on a thread's first call.
+     */
+    static int reader_stripe();
+
+    /**
+     * The number of optimistic attempts before a reader falls back to
+     * locking.
+     */
+    static const int OPTIMISTIC_ATTEMPTS = 4;
+
+    /**
+     * Runs a read operation: optimistic descents validated against the
+     * relocation counters, then a locked descent if they keep failing.
+     *
+     * @param[in,out] step
+     *     The descent step; holds the result on return.
+     */
+    template<class Step>
+    void read(Step & step);
+
+    /**
+     * Lock-free descent from the root.
+     *
+     * @param[in,out] step
+     *     The descent step.
+     */
+    template<class Step>
+    void descend_optimistic(Step & step);
+
+    /**
+     * Hand-over-hand locked descent from the root.
+     *
+     * @param[in,out] step
+     *     The descent step.
+     */
+    template<class Step>
+    void descend_locked(Step & step);
+
+    /**
+     * Redirects the link of a parent, which must be locked, from one child
+     * to another node.
+     *
+     * @param[in] parent
+     *     The parent node; may be the head sentinel.
+     * @param[in] child
+     *     The current child.
+     * @param[in] replacement
+     *     The node that takes the child's place.
+     */
+    void replace_child(Node * parent, Node * child, Node * replacement);
+
+    /**
+     * Hands an unlinked node over for deferred deletion, advances the epoch
+     * if no reader of the previous one is left, and deletes the nodes that
+     * no reader can reach any more.
+     *
+     * @param[in] node
+     *     The node to retire.
+     */
+    void retire(Node * node);
+
+    /**
+     * Recursively deletes a subtree.
+     *
+     * @param[in] root
+     *     The root of the subtree.
+     */
+    void destroy(Node * root);
+
+    /**
+     * Sentinel whose left child is the root of the tree. Locking it guards
+     * the root link.
+     */
+    Node * m_head;
+
+    /**
+     * The number of relocations that have started.
+     */
+    std::atomic<unsigned long> m_relocations_started;
+
+    /**
+     * The number of relocations that have finished.
+     */
+    std::atomic<unsigned long> m_relocations_finished;
+
+    /**
+     * The current epoch.
+     */
+    std::atomic<unsigned long> m_epoch;
+
+    /**
+     * The number of lock-free readers in flight, split in stripes.
+     */
+    ReaderStripe m_readers[READER_STRIPES];
+
+    /**
+     * Nodes that have been unlinked but may still be seen by a reader, with
+     * the epoch they were unlinked in, oldest first.
+     */
+    std::deque<std::pair<Node *, unsigned long> > m_retired;
+
+    /**
+     * Guards the retired list.
+     */
+    std::mutex m_retired_mutex;
+};
+
+
+template<class T>
+ConcurrentBinaryTree<T>::ConcurrentBinaryTree()
+    : m_head(new Node(T())), m_relocations_started(0),
+      m_relocations_finished(0), m_epoch(0)
+{
+    for (int i = 0; i < READER_STRIPES; i++) {
+        m_readers[i].count[0].store(0);
+        m_readers[i].count[1].store(0);
+    }
+}
+
+
+template<class T>
+ConcurrentBinaryTree<T>::~ConcurrentBinaryTree()
+{
+    destroy(m_head);
+
+    for (typename std::deque<std::pair<Node *, unsigned long> >::size_type i = 0; i < m_retired.size(); i++)
+        delete m_retired[i].first;
+}
+
+
+template<class T>
+bool ConcurrentBinaryTree<T>::insert(T key)
+{
+    Node * parent = m_head;
+    parent->lock();
+    Node * curr = parent->left();
+
+    while (curr != 0)
+    {
+        // Lock the child before letting go of the parent.
+        curr->lock();
+        parent->unlock();
+
+        if (key == curr->key())
+        {
+            curr->unlock();
+            return false;
+        }
+
+        parent = curr;
+        curr = key < curr->key() ? curr->left() : curr->right();
+    }
+
+    // The new leaf is fully constructed before it is published with a
+    // single store.
+    Node * node = new Node(key);
+    if (parent == m_head || key < parent->key())
+        parent->set_left(node);
+    else
+        parent->set_right(node);
+
+    parent->unlock();
+    return true;
+}
+
+
+template<class T>
+bool ConcurrentBinaryTree<T>::remove(T key)
+{
+    Node * parent = m_head;
+    parent->lock();
+    Node * curr = parent->left();
+
+    while (curr != 0)
+    {
+        curr->lock();
+
+        if (key == curr->key())
+            break;
+
+        parent->unlock();
+        parent = curr;
+        curr = key < curr->key() ? curr->left() : curr->right();
+    }
+
+    if (curr == 0)
+    {
+        parent->unlock();
+        return false;
+    }
+
+    // Both the parent and the node to be removed are locked here.
+    Node * left = curr->left();
+    Node * right = curr->right();
+
+    if (left == 0 || right == 0)
+    {
+        // At most one child: bypass the node.
+        replace_child(parent, curr, left != 0 ? left : right);
+        curr->unlock();
+        parent->unlock();
+        retire(curr);
+        return true;
+    }
+
+    // Two children: lock our way down to the inorder successor, keeping the
+    // node itself locked.
+    Node * succ_parent = curr;
+    Node * succ = right;
+    succ->lock();
+    while (succ->left() != 0)
+    {
+        Node * next = succ->left();
+        next->lock();
+        if (succ_parent != curr)
+            succ_parent->unlock();
+        succ_parent = succ;
+        succ = next;
+    }
+
+    m_relocations_started++;
+
+    // Publish a copy of the successor in the place of the removed node. The
+    // successor's key is now reachable twice, the removed key not at all.
+    // The copy needs no lock of its own: a writer can only reach it through
+    // parent, which stays locked until we are done.
+    Node * copy = new Node(succ->key(), left, right);
+    replace_child(parent, curr, copy);
+
+    // Unlink the original successor. It has no left child.
+    if (succ_parent == curr)
+        copy->set_right(succ->right());
+    else
+        succ_parent->set_left(succ->right());
+
+    m_relocations_finished++;
+
+    succ->unlock();
+    if (succ_parent != curr)
+        succ_parent->unlock();
+    curr->unlock();
+    parent->unlock();
+
+    retire(curr);
+    retire(succ);
+    return true;
+}
+
+
+template<class T>
+bool ConcurrentBinaryTree<T>::search_iterative(T key)
+{
+    SearchStep step(key);
+    read(step);
+    return step.found;
+}
+
+
+template<class T>
+bool ConcurrentBinaryTree<T>::minimum(T & key)
+{
+    MinimumStep step(key);
+    read(step);
+    if (step.found)
+        key = step.result;
+    return step.found;
+}
+
+
+template<class T>
+bool ConcurrentBinaryTree<T>::maximum(T & key)
+{
+    MaximumStep step(key);
+    read(step);
+    if (step.found)
+        key = step.result;
+    return step.found;
+}
+
+
+template<class T>
+bool ConcurrentBinaryTree<T>::successor_inorder(T key, T & successor)
+{
+    SuccessorStep step(key);
+    read(step);
+    if (step.found)
+        successor = step.result;
+    return step.found;
+}
+
+
+template<class T>
+template<class Step>
+void ConcurrentBinaryTree<T>::read(Step & step)
+{
+    ReaderGuard guard(m_readers[reader_stripe()], m_epoch);
+
+    for (int attempt = 0; attempt < OPTIMISTIC_ATTEMPTS; attempt++)
+    {
+        unsigned long finished = m_relocations_finished.load();
+
+        step.reset();
+        descend_optimistic(step);
+
+        // If no relocation started before now that had not already finished
+        // before the descent began, nothing moved under our feet.
+        if (step.settled() || m_relocations_started.load() == finished)
+            return;
+    }
+
+    step.reset();
+    descend_locked(step);
+}
+
+
+template<class T>
+template<class Step>
+void ConcurrentBinaryTree<T>::descend_optimistic(Step & step)
+{
+    Node * node = m_head->left();
+
+    while (node != 0)
+    {
+        Direction dir = step(node);
+        if (dir == STOP)
+            return;
+        node = dir == LEFT ? node->left() : node->right();
+    }
+}
+
+
+template<class T>
+template<class Step>
+void ConcurrentBinaryTree<T>::descend_locked(Step & step)
+{
+    Node * parent = m_head;
+    parent->lock();
+    Node * node = parent->left();
+
+    while (node != 0)
+    {
+        node->lock();
+        parent->unlock();
+        parent = node;
+
+        Direction dir = step(node);
+        if (dir == STOP)
+            break;
+        node = dir == LEFT ? node->left() : node->right();
+    }
+
+    parent->unlock();
+}
+
+
+template<class T>
+void ConcurrentBinaryTree<T>::replace_child(Node * parent, Node * child, Node * replacement)
+{
+    if (parent->left() == child)
+        parent->set_left(replacement);
+    else
+        parent->set_right(replacement);
+}
+
+
+template<class T>
+void ConcurrentBinaryTree<T>::retire(Node * node)
+{
+    std::lock_guard<std::mutex> guard(m_retired_mutex);
+
+    // The node was unlinked before the epoch is read, so only readers of
+    // this epoch or an earlier one can have reached it.
+    unsigned long epoch = m_epoch.load();
+    m_retired.push_back(std::make_pair(node, epoch));
+
+    // The readers of epoch - 1 count in the parity epoch + 1 will use. Two
+    // steps are enough to make every retired node deletable.
+    for (int step = 0; step < 2; step++)
+    {
+        int readers = 0;
+        for (int i = 0; i < READER_STRIPES && readers == 0; i++)
+            readers += m_readers[i].count[(epoch + 1) & 1].load();
+
+        if (readers != 0)
+            break;
+        m_epoch.store(++epoch);
+    }
+
+    while (!m_retired.empty() && m_retired.front().second + 2 <= epoch)
+    {
+        delete m_retired.front().first;
+        m_retired.pop_front();
+    }
+}
+
+
+template<class T>
+int ConcurrentBinaryTree<T>::retired()
+{
+    std::lock_guard<std::mutex> guard(m_retired_mutex);
+    return (int) m_retired.size();
+}
+
+
+template<class T>
+int ConcurrentBinaryTree<T>::reader_stripe()
+{
+    static std::atomic<int> next(0);
+    static thread_local int stripe = next++ % READER_STRIPES;
+    return stripe;
+}
+
+
+template<class T>
+void ConcurrentBinaryTree<T>::destroy(Node * root)
+{
+    if (root != 0)
+    {
+        destroy(root->left());
+        destroy(root->right());
+        delete root;
+    }
+}
+
+#endif /* CONCURRENTBINARYTREE_H_ */
@@ -0,0 +1,392 @@
+/**
+ * @file concurrentbinarytree_test.cpp
+ *
+ * @brief Test unit for the concurrent binary search tree class.
+ *
+ * @see concurrentbinarytree.h concurrentbinarytree.cpp
+ * concurrentbinarytreenode.h concurrentbinarytreenode.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "concurrentbinarytree.h"
+#include "../binarytree/binarytree.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void test_insert_remove();
+void test_ordered_queries();
+void test_concurrent_consistency();
+void test_retired_bounded();
+void test_read_write_mix_timing();
+
+int main (int argc, char** argv)
+{
+    test_insert_remove();
+    test_ordered_queries();
+    test_concurrent_consistency();
+    test_retired_bounded();
+    test_read_write_mix_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+ConcurrentBinaryTree<int> * init_tree_std()
+{
+    ConcurrentBinaryTree<int> * tree = new ConcurrentBinaryTree<int>();
+    int keys[] = { 100, 50, 150, 25, 75, 125, 175, 110 };
+
+    for (int i = 0; i < 8; i++)
+        tree->insert(keys[i]);
+
+    return tree;
+}
+
+
+/**
+ * Small xorshift generator, so that every thread has its own random state.
+ */
+unsigned int next_random(unsigned int & state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+
+// test functions
+
+
+void test_insert_remove()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    ConcurrentBinaryTree<int> * tree = init_tree_std();
+
+    std::cout << "Insert duplicate 75: " << (tree->insert(75) ? "inserted" : "rejected") << std::endl;
+    std::cout << "Remove leaf 25: " << (tree->remove(25) ? "removed" : "not found") << std::endl;
+    std::cout << "Remove one-child 125: " << (tree->remove(125) ? "removed" : "not found") << std::endl;
+    std::cout << "Remove two-children root 100: " << (tree->remove(100) ? "removed" : "not found") << std::endl;
+    std::cout << "Remove absent 100: " << (tree->remove(100) ? "removed" : "not found") << std::endl;
+
+    int keys[] = { 25, 50, 75, 100, 110, 125, 150, 175 };
+    std::cout << "Present:";
+    for (int i = 0; i < 8; i++)
+        if (tree->search_iterative(keys[i]))
+            std::cout << " " << keys[i];
+    std::cout << std::endl;
+
+    delete tree;
+    std::cout << std::endl;
+}
+
+
+void test_ordered_queries()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    ConcurrentBinaryTree<int> * tree = new ConcurrentBinaryTree<int>();
+    int key = 0;
+
+    std::cout << "Empty tree minimum: " << (tree->minimum(key) ? "found" : "none") << std::endl;
+    delete tree;
+
+    tree = init_tree_std();
+    tree->minimum(key);
+    std::cout << "Minimum: " << key << std::endl;
+    tree->maximum(key);
+    std::cout << "Maximum: " << key << std::endl;
+
+    std::cout << "Inorder via successor_inorder:";
+    bool more = tree->minimum(key);
+    while (more)
+    {
+        std::cout << " " << key;
+        more = tree->successor_inorder(key, key);
+    }
+    std::cout << std::endl;
+
+    tree->successor_inorder(111, key);
+    std::cout << "Successor of absent 111: " << key << std::endl;
+
+    delete tree;
+    std::cout << std::endl;
+}
+
+
+/**
+ * Writers own disjoint key ranges and toggle keys in them, while readers
+ * keep checking that a set of keys that nobody touches is always found.
+ */
+void test_concurrent_consistency()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int writers = 4;
+    const int readers = 4;
+    const int range = 1000;
+    const int rounds = 20000;
+
+    ConcurrentBinaryTree<int> tree;
+
+    // Stable keys are odd, toggled keys are even.
+    unsigned int seed = 7;
+    std::vector<int> stable;
+    for (int i = 0; i < writers * range / 2; i++)
+    {
+        int key = 2 * (next_random(seed) % (writers * range)) + 1;
+        if (tree.insert(key))
+            stable.push_back(key);
+    }
+
+    std::vector<int> errors(readers, 0);
+    std::vector<std::thread> threads;
+
+    for (int w = 0; w < writers; w++)
+    {
+        threads.push_back(std::thread([&tree, w]() {
+            unsigned int state = 17 + w;
+            for (int i = 0; i < rounds; i++)
+            {
+                int key = 2 * (w * range + (int) (next_random(state) % range));
+                if (!tree.insert(key))
+                    tree.remove(key);
+            }
+        }));
+    }
+
+    for (int r = 0; r < readers; r++)
+    {
+        threads.push_back(std::thread([&tree, &stable, &errors, r]() {
+            for (int i = 0; i < rounds; i++)
+            {
+                int key = stable[(i * 31 + r) % stable.size()];
+                if (!tree.search_iterative(key))
+                    errors[r]++;
+                int succ;
+                if (tree.successor_inorder(key - 1, succ) && succ != key)
+                    errors[r]++;
+            }
+        }));
+    }
+
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    int total = 0;
+    for (int r = 0; r < readers; r++)
+        total += errors[r];
+
+    std::cout << "Lookups of untouched keys that failed: " << total << std::endl;
+
+    int key = 0;
+    int count = 0;
+    int previous = -1;
+    bool sorted = true;
+    bool more = tree.minimum(key);
+    while (more)
+    {
+        if (key <= previous)
+            sorted = false;
+        previous = key;
+        count++;
+        more = tree.successor_inorder(key, key);
+    }
+    std::cout << "Final inorder walk " << (sorted ? "is" : "is NOT") << " sorted." << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Readers never stop while a writer removes keys; the removed nodes must
+ * still be deleted as the writer goes, not piled up until the readers are
+ * done. How many wait at a time depends on how long a reader can be
+ * descheduled in the middle of a read, so the bound is loose; once the
+ * readers are gone, one more remove must empty the list.
+ */
+void test_retired_bounded()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int readers = 4;
+    const int keys = 1000;
+    const int removes = 200000;
+    const int bound = removes / 4;
+
+    ConcurrentBinaryTree<int> tree;
+    for (int key = 0; key < keys; key++)
+        tree.insert(key);
+
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+
+    for (int r = 0; r < readers; r++)
+    {
+        threads.push_back(std::thread([&tree, &done, r]() {
+            unsigned int state = 31 + r;
+            while (!done.load())
+            {
+                int succ;
+                int key = (int) (next_random(state) % keys);
+                tree.search_iterative(key);
+                tree.successor_inorder(key, succ);
+            }
+        }));
+    }
+
+    int removed = 0;
+    int most = 0;
+    unsigned int seed = 29;
+    for (int i = 0; removed < removes; i++)
+    {
+        int key = (int) (next_random(seed) % keys);
+        if (tree.remove(key))
+        {
+            removed++;
+            tree.insert(key);
+        }
+        if (i % 100 == 0 && tree.retired() > most)
+            most = tree.retired();
+    }
+
+    done = true;
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    std::cout << removed << " removes under " << readers << " busy readers, at most "
+              << most << " nodes waiting: " << (most < bound ? "(ok)" : "(WRONG)") << std::endl;
+
+    tree.remove(0);
+    std::cout << "Nodes waiting after the readers are gone: " << tree.retired()
+              << (tree.retired() == 0 ? " (ok)" : " (WRONG)") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Runs a read/write mix on the concurrent tree and on a plain BinaryTree
+ * behind a global mutex. A write toggles a random key; a read looks one up.
+ */
+void test_read_write_mix_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int key_range = 1 << 16;
+    const int total_ops = 1 << 18;
+    int write_percents[] = { 0, 5, 50 };
+    int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+    std::cout << "reads/writes\tthreads\tconcurrent (Mops/s)\tglobal mutex (Mops/s)" << std::endl;
+
+    for (int m = 0; m < 3; m++)
+    {
+        for (int t = 0; t < 7; t++)
+        {
+            int threads = thread_counts[t];
+            int writes = write_percents[m];
+            int ops = total_ops / threads;
+
+            ConcurrentBinaryTree<int> ctree;
+            BinaryTree<int> btree;
+            std::mutex bmutex;
+
+            unsigned int seed = 1;
+            for (int i = 0; i < key_range / 2; i++)
+            {
+                int key = (int) (next_random(seed) % key_range);
+                if (ctree.insert(key))
+                    btree.insert_iterative(new BinaryTreeNode<int>(key));
+            }
+
+            // Hit counters keep the lookups from being optimised away.
+            std::vector<long> hits(threads, 0);
+            std::vector<std::thread> workers;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (int w = 0; w < threads; w++)
+            {
+                workers.push_back(std::thread([&ctree, &hits, ops, writes, w]() {
+                    unsigned int state = 101 + w;
+                    long found = 0;
+                    for (int i = 0; i < ops; i++)
+                    {
+                        int key = (int) (next_random(state) % key_range);
+                        if ((int) (next_random(state) % 100) < writes)
+                        {
+                            if (!ctree.insert(key))
+                                ctree.remove(key);
+                        }
+                        else if (ctree.search_iterative(key))
+                        {
+                            found++;
+                        }
+                    }
+                    hits[w] = found;
+                }));
+            }
+            for (int w = 0; w < threads; w++)
+                workers[w].join();
+            double csecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            workers.clear();
+            start = std::chrono::steady_clock::now();
+            for (int w = 0; w < threads; w++)
+            {
+                workers.push_back(std::thread([&btree, &bmutex, &hits, ops, writes, w]() {
+                    unsigned int state = 101 + w;
+                    long found = 0;
+                    for (int i = 0; i < ops; i++)
+                    {
+                        int key = (int) (next_random(state) % key_range);
+                        std::lock_guard<std::mutex> guard(bmutex);
+                        if ((int) (next_random(state) % 100) < writes)
+                        {
+                            BinaryTreeNode<int> * node = btree.search_iterative(btree.root(), key);
+                            if (node)
+                                btree.remove(node);
+                            else
+                                btree.insert_iterative(new BinaryTreeNode<int>(key));
+                        }
+                        else if (btree.search_iterative(btree.root(), key))
+                        {
+                            found++;
+                        }
+                    }
+                    hits[w] = found;
+                }));
+            }
+            for (int w = 0; w < threads; w++)
+                workers[w].join();
+            double bsecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            double done = (double) ops * threads / 1e6;
+            std::cout << (100 - writes) << "/" << writes << "\t\t" << threads << "\t"
+                    << done / csecs << "\t\t\t" << done / bsecs << std::endl;
+        }
+    }
+
+    std::cout << std::endl;
+}
@@ -0,0 +1,14 @@
+/**
+ * @class ConcurrentBinaryTreeNode
+ *
+ * @file concurrentbinarytreenode.cpp
+ *
+ * @brief Concurrent binary search tree node class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "concurrentbinarytreenode.h"
+
+// Empty due to template implementation.
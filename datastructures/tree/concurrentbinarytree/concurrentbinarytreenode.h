@@ -0,0 +1,205 @@
+#ifndef CONCURRENTBINARYTREENODE_H_
+#define CONCURRENTBINARYTREENODE_H_
+
+#include <atomic>
+#include <mutex>
+
+/**
+ * @class ConcurrentBinaryTreeNode
+ *
+ * @file concurrentbinarytreenode.h
+ *
+ * @brief Concurrent binary search tree node class definition.
+ *
+ * The key of a node never changes once the node is constructed; the child
+ * links are atomics so that readers can follow them without taking any lock
+ * while writers update them. Each node carries its own mutex, used by the
+ * writers for hand-over-hand locking.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class ConcurrentBinaryTreeNode {
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] key
+     *     The key of the node constructed.
+     */
+    ConcurrentBinaryTreeNode(T key);
+
+    /**
+     * Constructor.
+     *
+     * @param[in] key
+     *     The key of the node constructed.
+     * @param[in] left
+     *     The left child of the node constructed.
+     * @param[in] right
+     *     The right child of the node constructed.
+     */
+    ConcurrentBinaryTreeNode(
+            T key,
+            ConcurrentBinaryTreeNode<T> * left,
+            ConcurrentBinaryTreeNode<T> * right
+            );
+
+    /**
+     * Destructor.
+     */
+    virtual ~ConcurrentBinaryTreeNode();
+
+    // -- getter methods
+
+    /**
+     * Getter for the node's key.
+     *
+     * @return
+     *     The key of this node.
+     */
+    const T & key() const;
+
+    /**
+     * Getter for the node's left child.
+     *
+     * @return
+     *     A pointer to the left child of this node.
+     */
+    ConcurrentBinaryTreeNode<T> * left() const;
+
+    /**
+     * Getter for the node's right child.
+     *
+     * @return
+     *     A pointer to the right child of this node.
+     */
+    ConcurrentBinaryTreeNode<T> * right() const;
+
+    // -- setter methods
+
+    /**
+     * Setter for the node's left child.
+     *
+     * @param[in] left
+     *     A pointer to the node to be set as this node's left child.
+     */
+    void set_left(ConcurrentBinaryTreeNode<T> * left);
+
+    /**
+     * Setter for the node's right child.
+     *
+     * @param[in] right
+     *     A pointer to the node to be set as this node's right child.
+     */
+    void set_right(ConcurrentBinaryTreeNode<T> * right);
+
+    // -- public methods
+
+    /**
+     * Acquires the node's lock.
+     */
+    void lock();
+
+    /**
+     * Releases the node's lock.
+     */
+    void unlock();
+protected:
+private:
+    /**
+     * The key conveyed by this node.
+     */
+    const T m_key;
+
+    /**
+     * A pointer to the left child of this node.
+     */
+    std::atomic<ConcurrentBinaryTreeNode<T> *> m_left;
+
+    /**
+     * A pointer to the right child of this node.
+     */
+    std::atomic<ConcurrentBinaryTreeNode<T> *> m_right;
+
+    /**
+     * The lock taken by writers passing through this node.
+     */
+    std::mutex m_mutex;
+};
+
+
+template<class T>
+ConcurrentBinaryTreeNode<T>::ConcurrentBinaryTreeNode(T key)
+    : m_key(key), m_left(0), m_right(0)
+{
+}
+
+
+template<class T>
+ConcurrentBinaryTreeNode<T>::ConcurrentBinaryTreeNode(
+        T key,
+        ConcurrentBinaryTreeNode<T> * left,
+        ConcurrentBinaryTreeNode<T> * right
+        )
+    : m_key(key), m_left(left), m_right(right)
+{
+}
+
+
+template<class T>
+ConcurrentBinaryTreeNode<T>::~ConcurrentBinaryTreeNode()
+{
+}
+
+
+template<class T>
+const T & ConcurrentBinaryTreeNode<T>::key() const
+{
+    return m_key;
+}
+
+
+template<class T>
+ConcurrentBinaryTreeNode<T> * ConcurrentBinaryTreeNode<T>::left() const
+{
+    return m_left.load();
+}
+
+
+template<class T>
+ConcurrentBinaryTreeNode<T> * ConcurrentBinaryTreeNode<T>::right() const
+{
+    return m_right.load();
+}
+
+
+template<class T>
+void ConcurrentBinaryTreeNode<T>::set_left(ConcurrentBinaryTreeNode<T> * left)
+{
+    m_left.store(left);
+}
+
+
+template<class T>
+void ConcurrentBinaryTreeNode<T>::set_right(ConcurrentBinaryTreeNode<T> * right)
+{
+    m_right.store(right);
+}
+
+
+template<class T>
+void ConcurrentBinaryTreeNode<T>::lock()
+{
+    m_mutex.lock();
+}
+
+
+template<class T>
+void ConcurrentBinaryTreeNode<T>::unlock()
+{
+    m_mutex.unlock();
+}
+
+#endif /* CONCURRENTBINARYTREENODE_H_ */
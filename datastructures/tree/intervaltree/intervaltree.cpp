@@ -0,0 +1,14 @@
+/**
+ * @class IntervalTree
+ *
+ * @file intervaltree.cpp
+ *
+ * @brief Interval tree class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "intervaltree.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,511 @@
+#ifndef INTERVALTREE_H_
+#define INTERVALTREE_H_
+
+#include "intervaltreenode.h"
+
+#include <vector>
+
+/**
+ * @class IntervalTree
+ *
+ * @file intervaltree.h
+ *
+ * @brief Interval tree class definition.
+ *
+ * <p>
+ * An interval tree stores closed intervals [low, high] and answers which of
+ * them overlap a point (<em>stabbing</em> query) or another interval. It is
+ * a binary search tree on the low endpoints in which every node is augmented
+ * with the largest high endpoint in its subtree (Cormen et al., 14.3). The
+ * maximum prunes the search: a subtree whose maximum is below the query's
+ * low end holds nothing that can overlap the query, and, since the tree is
+ * ordered by low endpoints, neither does anything to the right of a node
+ * whose low endpoint is past the query's high end.
+ *
+ * The tree is kept balanced as a <em>treap</em>: each node gets a random
+ * priority and the nodes are arranged as a max-heap on the priorities by
+ * rotations, which gives an expected height of O(log n) whatever the order
+ * of the updates. The maximum of a node depends only on its own interval and
+ * its children's maximums, so insertion, removal and rotations update it
+ * locally, along the path they change.
+ *
+ * Finding one overlapping interval takes O(log n) expected time. Reporting
+ * all k of them visits only subtrees that contain a high endpoint within
+ * reach of the query, which costs O(log n + k) when the intervals overlapping
+ * a query are clustered in the tree, as in sliding time windows, and never
+ * more than O(min(n, k log n)).
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class K>
+class IntervalTree {
+public:
+    /**
+     * Default constructor. Creates an empty tree.
+     */
+    IntervalTree();
+
+    /**
+     * Destructor.
+     */
+    virtual ~IntervalTree();
+
+    // -- getter methods
+
+    /**
+     * Getter for the root node.
+     *
+     * @return
+     *     A pointer to the root node; <code>null</code> for an empty tree.
+     */
+    IntervalTreeNode<K> * root() const;
+
+    /**
+     * Getter for the number of intervals.
+     *
+     * @return
+     *     The number of intervals in the tree.
+     */
+    int size() const;
+
+    // -- public methods
+
+    /**
+     * Inserts an interval. Takes O(log n) expected time.
+     *
+     * The interval is inserted as a leaf, ordered by its low endpoint (ties
+     * broken by the high endpoint), and then rotated up while its priority
+     * beats its parent's.
+     *
+     * @param[in] low
+     *     The low endpoint of the interval.
+     * @param[in] high
+     *     The high endpoint of the interval; not less than low.
+     *
+     * @return
+     *     A pointer to the node holding the interval.
+     */
+    IntervalTreeNode<K> * insert(K low, K high);
+
+    /**
+     * Removes an interval. Takes O(log n) expected time.
+     *
+     * @param[in] low
+     *     The low endpoint of the interval.
+     * @param[in] high
+     *     The high endpoint of the interval.
+     *
+     * @return
+     *     <code>true</code> if (one copy of) the interval was found and
+     *     removed; <code>false</code> otherwise.
+     */
+    bool remove(K low, K high);
+
+    /**
+     * Removes a node. Takes O(log n) expected time.
+     *
+     * The node is rotated down, always lifting the child with the higher
+     * priority, until it is a leaf; then it is cut off and the maximums on
+     * the way back to the root are fixed.
+     *
+     * @param[in] node
+     *     The node to remove; it is deleted.
+     */
+    void remove(IntervalTreeNode<K> * node);
+
+    /**
+     * Looks up an interval.
+     *
+     * @param[in] low
+     *     The low endpoint of the interval.
+     * @param[in] high
+     *     The high endpoint of the interval.
+     *
+     * @return
+     *     A pointer to a node holding the interval; <code>null</code> if
+     *     there is none.
+     */
+    IntervalTreeNode<K> * search(K low, K high) const;
+
+    /**
+     * Finds an interval that overlaps a given one. Takes O(log n) expected
+     * time.
+     *
+     * Walks down from the root: if the current interval does not overlap the
+     * query, the walk goes left when the left subtree's maximum reaches the
+     * query's low end (if nothing there overlaps, nothing to the right does
+     * either) and right otherwise.
+     *
+     * @param[in] low
+     *     The low endpoint of the query interval.
+     * @param[in] high
+     *     The high endpoint of the query interval.
+     *
+     * @return
+     *     A pointer to a node whose interval overlaps the query;
+     *     <code>null</code> if there is none.
+     */
+    IntervalTreeNode<K> * find_overlap(K low, K high) const;
+
+    /**
+     * Reports all intervals that overlap a given one.
+     *
+     * The visitor takes a node and returns <code>false</code> to stop the
+     * query.
+     *
+     * @param[in] low
+     *     The low endpoint of the query interval.
+     * @param[in] high
+     *     The high endpoint of the query interval.
+     * @param[in] visit
+     *     The visitor to call on each overlapping node.
+     *
+     * @return
+     *     The number of nodes visited.
+     */
+    template<class Visitor>
+    int overlap(K low, K high, Visitor visit) const;
+
+    /**
+     * Reports all intervals that contain a point.
+     *
+     * @see overlap
+     *
+     * @param[in] point
+     *     The point.
+     * @param[in] visit
+     *     The visitor to call on each interval containing the point.
+     *
+     * @return
+     *     The number of nodes visited.
+     */
+    template<class Visitor>
+    int stab(K point, Visitor visit) const;
+protected:
+private:
+    /**
+     * Copy constructor; a tree owns its nodes.
+     */
+    IntervalTree(const IntervalTree<K> & other);
+
+    /**
+     * Assignment operator; a tree owns its nodes.
+     */
+    IntervalTree<K> & operator=(const IntervalTree<K> & other);
+
+    /**
+     * Recomputes the maximum of a node from its interval and its children.
+     */
+    static void update_max(IntervalTreeNode<K> * node);
+
+    /**
+     * Rotates a node down to the left, lifting its right child.
+     */
+    void rotate_left(IntervalTreeNode<K> * node);
+
+    /**
+     * Rotates a node down to the right, lifting its left child.
+     */
+    void rotate_right(IntervalTreeNode<K> * node);
+
+    /**
+     * Replaces the link pointing to a node, from its parent or the root
+     * pointer, with another node.
+     */
+    void replace_link(IntervalTreeNode<K> * node, IntervalTreeNode<K> * other);
+
+    /**
+     * Draws the next treap priority.
+     */
+    unsigned int next_priority();
+
+    /**
+     * The root node of the tree.
+     */
+    IntervalTreeNode<K> * m_root;
+
+    /**
+     * The number of intervals.
+     */
+    int m_size;
+
+    /**
+     * The state of the priority generator.
+     */
+    unsigned int m_seed;
+};
+
+
+template<class K>
+IntervalTree<K>::IntervalTree()
+    : m_root(0), m_size(0), m_seed(2463534242u)
+{
+}
+
+
+template<class K>
+IntervalTree<K>::~IntervalTree()
+{
+    std::vector<IntervalTreeNode<K> *> st;
+    if (m_root)
+        st.push_back(m_root);
+
+    while (!st.empty())
+    {
+        IntervalTreeNode<K> * node = st.back();
+        st.pop_back();
+        if (node->left())
+            st.push_back(node->left());
+        if (node->right())
+            st.push_back(node->right());
+        delete node;
+    }
+}
+
+
+template<class K>
+IntervalTreeNode<K> * IntervalTree<K>::root() const
+{
+    return m_root;
+}
+
+
+template<class K>
+int IntervalTree<K>::size() const
+{
+    return m_size;
+}
+
+
+template<class K>
+IntervalTreeNode<K> * IntervalTree<K>::insert(K low, K high)
+{
+    IntervalTreeNode<K> * node = new IntervalTreeNode<K>(low, high, next_priority());
+    IntervalTreeNode<K> * parent = 0;
+    IntervalTreeNode<K> * cursor = m_root;
+
+    // Descend, raising the maximums on the way.
+    while (cursor)
+    {
+        parent = cursor;
+        if (cursor->max() < high)
+            cursor->set_max(high);
+
+        if (low < cursor->low() || (!(cursor->low() < low) && high < cursor->high()))
+            cursor = cursor->left();
+        else
+            cursor = cursor->right();
+    }
+
+    node->set_parent(parent);
+    if (parent == 0)
+        m_root = node;
+    else if (low < parent->low() || (!(parent->low() < low) && high < parent->high()))
+        parent->set_left(node);
+    else
+        parent->set_right(node);
+
+    while (node->parent() && node->parent()->priority() < node->priority())
+    {
+        if (node == node->parent()->left())
+            rotate_right(node->parent());
+        else
+            rotate_left(node->parent());
+    }
+
+    m_size++;
+    return node;
+}
+
+
+template<class K>
+bool IntervalTree<K>::remove(K low, K high)
+{
+    IntervalTreeNode<K> * node = search(low, high);
+
+    if (node == 0)
+        return false;
+
+    remove(node);
+    return true;
+}
+
+
+template<class K>
+void IntervalTree<K>::remove(IntervalTreeNode<K> * node)
+{
+    while (node->left() && node->right())
+    {
+        if (node->left()->priority() > node->right()->priority())
+            rotate_right(node);
+        else
+            rotate_left(node);
+    }
+
+    IntervalTreeNode<K> * child = node->left() ? node->left() : node->right();
+    IntervalTreeNode<K> * parent = node->parent();
+    replace_link(node, child);
+
+    for (; parent; parent = parent->parent())
+        update_max(parent);
+
+    delete node;
+    m_size--;
+}
+
+
+template<class K>
+IntervalTreeNode<K> * IntervalTree<K>::search(K low, K high) const
+{
+    IntervalTreeNode<K> * node = m_root;
+
+    while (node && (low != node->low() || high != node->high()))
+    {
+        if (low < node->low() || (!(node->low() < low) && high < node->high()))
+            node = node->left();
+        else
+            node = node->right();
+    }
+
+    return node;
+}
+
+
+template<class K>
+IntervalTreeNode<K> * IntervalTree<K>::find_overlap(K low, K high) const
+{
+    IntervalTreeNode<K> * node = m_root;
+
+    while (node && (high < node->low() || node->high() < low))
+    {
+        if (node->left() && !(node->left()->max() < low))
+            node = node->left();
+        else
+            node = node->right();
+    }
+
+    return node;
+}
+
+
+template<class K>
+template<class Visitor>
+int IntervalTree<K>::overlap(K low, K high, Visitor visit) const
+{
+    int visited = 0;
+    std::vector<IntervalTreeNode<K> *> st;
+
+    if (m_root && !(m_root->max() < low))
+        st.push_back(m_root);
+
+    while (!st.empty())
+    {
+        IntervalTreeNode<K> * node = st.back();
+        st.pop_back();
+
+        // Everything here and to the right starts past the query.
+        bool past = high < node->low();
+
+        if (!past && !(node->high() < low))
+        {
+            visited++;
+            if (!visit(node))
+                break;
+        }
+
+        if (!past && node->right() && !(node->right()->max() < low))
+            st.push_back(node->right());
+        if (node->left() && !(node->left()->max() < low))
+            st.push_back(node->left());
+    }
+
+    return visited;
+}
+
+
+template<class K>
+template<class Visitor>
+int IntervalTree<K>::stab(K point, Visitor visit) const
+{
+    return overlap(point, point, visit);
+}
+
+
+template<class K>
+void IntervalTree<K>::update_max(IntervalTreeNode<K> * node)
+{
+    K max = node->high();
+
+    if (node->left() && max < node->left()->max())
+        max = node->left()->max();
+    if (node->right() && max < node->right()->max())
+        max = node->right()->max();
+
+    node->set_max(max);
+}
+
+
+template<class K>
+void IntervalTree<K>::rotate_left(IntervalTreeNode<K> * node)
+{
+    IntervalTreeNode<K> * pivot = node->right();
+
+    replace_link(node, pivot);
+    node->set_right(pivot->left());
+    if (pivot->left())
+        pivot->left()->set_parent(node);
+    pivot->set_left(node);
+    node->set_parent(pivot);
+
+    // The node is now below the pivot, so it has to be fixed first.
+    update_max(node);
+    update_max(pivot);
+}
+
+
+template<class K>
+void IntervalTree<K>::rotate_right(IntervalTreeNode<K> * node)
+{
+    IntervalTreeNode<K> * pivot = node->left();
+
+    replace_link(node, pivot);
+    node->set_left(pivot->right());
+    if (pivot->right())
+        pivot->right()->set_parent(node);
+    pivot->set_right(node);
+    node->set_parent(pivot);
+
+    update_max(node);
+    update_max(pivot);
+}
+
+
+template<class K>
+void IntervalTree<K>::replace_link(IntervalTreeNode<K> * node, IntervalTreeNode<K> * other)
+{
+    IntervalTreeNode<K> * parent = node->parent();
+
+    if (parent == 0)
+        m_root = other;
+    else if (parent->left() == node)
+        parent->set_left(other);
+    else
+        parent->set_right(other);
+
+    if (other)
+        other->set_parent(parent);
+}
+
+
+template<class K>
+unsigned int IntervalTree<K>::next_priority()
+{
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    return m_seed;
+}
+
+#endif /* INTERVALTREE_H_ */
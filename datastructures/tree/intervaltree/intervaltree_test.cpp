@@ -0,0 +1,294 @@
+/**
+ * @file intervaltree_test.cpp
+ *
+ * @brief Test unit for the interval tree class.
+ *
+ * @see intervaltree.h intervaltree.cpp intervaltreenode.h
+ * intervaltreenode.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "intervaltree.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+void test_insert_remove();
+void test_stab_overlap();
+void test_against_scan();
+void test_query_timing();
+
+int main (int argc, char** argv)
+{
+    test_insert_remove();
+    test_stab_overlap();
+    test_against_scan();
+    test_query_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+typedef std::pair<int, int> Interval;
+
+IntervalTree<int> * init_tree_std()
+{
+    IntervalTree<int> * tree = new IntervalTree<int>();
+    int intervals[][2] = { { 16, 21 }, { 8, 9 }, { 25, 30 }, { 5, 8 }, { 15, 23 },
+            { 17, 19 }, { 26, 26 }, { 0, 3 }, { 6, 10 }, { 19, 20 } };
+
+    for (int i = 0; i < 10; i++)
+        tree->insert(intervals[i][0], intervals[i][1]);
+
+    return tree;
+}
+
+
+/**
+ * Visitor that prints the intervals it is given.
+ */
+struct PrintInterval
+{
+    bool operator()(IntervalTreeNode<int> * node) const
+    {
+        std::cout << " [" << node->low() << ", " << node->high() << "]";
+        return true;
+    }
+};
+
+
+/**
+ * Visitor that collects the intervals it is given.
+ */
+struct CollectInterval
+{
+    std::vector<Interval> * found;
+
+    bool operator()(IntervalTreeNode<int> * node) const
+    {
+        found->push_back(Interval(node->low(), node->high()));
+        return true;
+    }
+};
+
+
+/**
+ * Visitor that only counts.
+ */
+struct CountInterval
+{
+    bool operator()(IntervalTreeNode<int> *) const
+    {
+        return true;
+    }
+};
+
+
+/**
+ * Checks the order, heap and maximum invariants of a subtree.
+ */
+bool is_consistent(IntervalTreeNode<int> * node, int & count)
+{
+    if (node == 0)
+        return true;
+
+    count++;
+    int max = node->high();
+    bool ok = true;
+
+    IntervalTreeNode<int> * children[2] = { node->left(), node->right() };
+    for (int c = 0; c < 2; c++)
+    {
+        IntervalTreeNode<int> * child = children[c];
+        if (child == 0)
+            continue;
+        ok = ok && child->parent() == node && child->priority() <= node->priority()
+                && is_consistent(child, count);
+        max = std::max(max, child->max());
+    }
+
+    if (node->left())
+        ok = ok && node->left()->low() <= node->low();
+    if (node->right())
+        ok = ok && node->low() <= node->right()->low();
+
+    return ok && node->max() == max;
+}
+
+
+// test functions
+
+
+void test_insert_remove()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    IntervalTree<int> * tree = init_tree_std();
+    int count = 0;
+    std::cout << "Size " << tree->size() << ", "
+            << (is_consistent(tree->root(), count) ? "consistent" : "INCONSISTENT") << std::endl;
+    std::cout << "Root maximum: " << tree->root()->max() << std::endl;
+
+    std::cout << "Remove [25, 30]: " << (tree->remove(25, 30) ? "removed" : "not found") << std::endl;
+    std::cout << "Remove [25, 30]: " << (tree->remove(25, 30) ? "removed" : "not found") << std::endl;
+    std::cout << "Remove [26, 26]: " << (tree->remove(26, 26) ? "removed" : "not found") << std::endl;
+    count = 0;
+    std::cout << "Size " << tree->size() << ", "
+            << (is_consistent(tree->root(), count) ? "consistent" : "INCONSISTENT") << std::endl;
+    std::cout << "Root maximum: " << tree->root()->max() << std::endl;
+
+    delete tree;
+    std::cout << std::endl;
+}
+
+
+void test_stab_overlap()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    IntervalTree<int> * tree = init_tree_std();
+
+    int points[] = { 8, 20, 24, 26, 40 };
+    for (int i = 0; i < 5; i++)
+    {
+        std::cout << "Stab " << points[i] << ":";
+        int count = tree->stab(points[i], PrintInterval());
+        std::cout << " (" << count << ")" << std::endl;
+    }
+
+    std::cout << "Overlap [22, 25]:";
+    tree->overlap(22, 25, PrintInterval());
+    std::cout << std::endl;
+
+    IntervalTreeNode<int> * node = tree->find_overlap(11, 14);
+    std::cout << "Find overlap [11, 14]: " << (node ? "found" : "none") << std::endl;
+    node = tree->find_overlap(10, 14);
+    std::cout << "Find overlap [10, 14]: [" << node->low() << ", " << node->high() << "]" << std::endl;
+
+    delete tree;
+    std::cout << std::endl;
+}
+
+
+/**
+ * Random insertions, removals and queries checked against a linear scan.
+ */
+void test_against_scan()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    srand(9);
+    IntervalTree<int> tree;
+    std::vector<Interval> all;
+    bool consistent = true;
+
+    for (int round = 0; round < 3000; round++)
+    {
+        if (all.empty() || rand() % 3 != 0)
+        {
+            int low = rand() % 1000;
+            int high = low + rand() % 50;
+            tree.insert(low, high);
+            all.push_back(Interval(low, high));
+        }
+        else
+        {
+            int i = rand() % all.size();
+            consistent = consistent && tree.remove(all[i].first, all[i].second);
+            all[i] = all.back();
+            all.pop_back();
+        }
+
+        int low = rand() % 1000;
+        int high = low + rand() % 20;
+        std::vector<Interval> expected;
+        for (size_t i = 0; i < all.size(); i++)
+            if (all[i].first <= high && low <= all[i].second)
+                expected.push_back(all[i]);
+
+        std::vector<Interval> found;
+        CollectInterval collect = { &found };
+        tree.overlap(low, high, collect);
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(found.begin(), found.end());
+        consistent = consistent && found == expected
+                && (tree.find_overlap(low, high) != 0) == !expected.empty();
+    }
+
+    int count = 0;
+    consistent = consistent && is_consistent(tree.root(), count) && count == tree.size()
+            && count == (int) all.size();
+    std::cout << "Against linear scan: " << (consistent ? "consistent" : "INCONSISTENT") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Sliding-window stabbing queries over 1M short intervals, against a scan
+ * of all of them.
+ */
+void test_query_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1 << 20;
+    const int queries = 1 << 14;
+    const int scans = 32;
+
+    srand(1);
+    IntervalTree<int> tree;
+    std::vector<Interval> all(n);
+    clock_t start = clock();
+    for (int i = 0; i < n; i++)
+    {
+        int low = rand() % (1 << 28);
+        int high = low + rand() % (1 << 12);
+        all[i] = Interval(low, high);
+        tree.insert(low, high);
+    }
+    double insert_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    long tree_hits = 0;
+    start = clock();
+    for (int q = 0; q < queries; q++)
+        tree_hits += tree.stab((q * 16381) % (1 << 28), CountInterval());
+    double tree_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    long scan_hits = 0;
+    start = clock();
+    for (int q = 0; q < scans; q++)
+    {
+        int point = (q * 16381) % (1 << 28);
+        for (int i = 0; i < n; i++)
+            if (all[i].first <= point && point <= all[i].second)
+                scan_hits++;
+    }
+    double scan_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << n << " intervals inserted in " << insert_secs << "s" << std::endl;
+    std::cout << "Stabbing query: tree " << tree_secs / queries * 1e6 << "us ("
+            << tree_hits << " hits in " << queries << " queries), scan "
+            << scan_secs / scans * 1e6 << "us (" << scan_hits << " hits in " << scans
+            << " queries)" << std::endl;
+
+    std::cout << std::endl;
+}
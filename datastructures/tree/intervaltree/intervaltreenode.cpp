@@ -0,0 +1,14 @@
+/**
+ * @class IntervalTreeNode
+ *
+ * @file intervaltreenode.cpp
+ *
+ * @brief Interval tree node class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "intervaltreenode.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,261 @@
+#ifndef INTERVALTREENODE_H_
+#define INTERVALTREENODE_H_
+
+/**
+ * @class IntervalTreeNode
+ *
+ * @file intervaltreenode.h
+ *
+ * @brief Interval tree node class definition.
+ *
+ * A node holds a closed interval [low, high], the largest high endpoint in
+ * the subtree rooted at it and a random priority that keeps the tree
+ * balanced as a treap. The interval and the priority never change once the
+ * node is constructed; the maximum is kept up to date by IntervalTree.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class K>
+class IntervalTreeNode {
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] low
+     *     The low endpoint of the interval.
+     * @param[in] high
+     *     The high endpoint of the interval.
+     * @param[in] priority
+     *     The treap priority of the node.
+     */
+    IntervalTreeNode(K low, K high, unsigned int priority);
+
+    /**
+     * Destructor.
+     */
+    virtual ~IntervalTreeNode();
+
+    // -- getter methods
+
+    /**
+     * Getter for the low endpoint of the node's interval.
+     *
+     * @return
+     *     The low endpoint.
+     */
+    const K & low() const;
+
+    /**
+     * Getter for the high endpoint of the node's interval.
+     *
+     * @return
+     *     The high endpoint.
+     */
+    const K & high() const;
+
+    /**
+     * Getter for the largest high endpoint in the subtree rooted at the
+     * node.
+     *
+     * @return
+     *     The largest high endpoint in the subtree.
+     */
+    const K & max() const;
+
+    /**
+     * Getter for the node's treap priority.
+     *
+     * @return
+     *     The priority.
+     */
+    unsigned int priority() const;
+
+    /**
+     * Getter for the node's parent.
+     *
+     * @return
+     *     A pointer to the parent of this node.
+     */
+    IntervalTreeNode<K> * parent() const;
+
+    /**
+     * Getter for the node's left child.
+     *
+     * @return
+     *     A pointer to the left child of this node.
+     */
+    IntervalTreeNode<K> * left() const;
+
+    /**
+     * Getter for the node's right child.
+     *
+     * @return
+     *     A pointer to the right child of this node.
+     */
+    IntervalTreeNode<K> * right() const;
+
+    // -- setter methods
+
+    /**
+     * Setter for the largest high endpoint in the subtree rooted at the node.
+     *
+     * @param[in] max
+     *     The largest high endpoint.
+     */
+    void set_max(const K & max);
+
+    /**
+     * Setter for the node's parent.
+     *
+     * @param[in] parent
+     *     A pointer to the node to be set as this node's parent.
+     */
+    void set_parent(IntervalTreeNode<K> * parent);
+
+    /**
+     * Setter for the node's left child.
+     *
+     * @param[in] left
+     *     A pointer to the node to be set as this node's left child.
+     */
+    void set_left(IntervalTreeNode<K> * left);
+
+    /**
+     * Setter for the node's right child.
+     *
+     * @param[in] right
+     *     A pointer to the node to be set as this node's right child.
+     */
+    void set_right(IntervalTreeNode<K> * right);
+protected:
+private:
+    /**
+     * The low endpoint of the interval.
+     */
+    const K m_low;
+
+    /**
+     * The high endpoint of the interval.
+     */
+    const K m_high;
+
+    /**
+     * The largest high endpoint in the subtree rooted at this node.
+     */
+    K m_max;
+
+    /**
+     * The treap priority; a node's priority is never smaller than its
+     * children's.
+     */
+    const unsigned int m_priority;
+
+    /**
+     * A pointer to the parent of this node.
+     */
+    IntervalTreeNode<K> * m_parent;
+
+    /**
+     * A pointer to the left child of this node.
+     */
+    IntervalTreeNode<K> * m_left;
+
+    /**
+     * A pointer to the right child of this node.
+     */
+    IntervalTreeNode<K> * m_right;
+};
+
+
+template<class K>
+IntervalTreeNode<K>::IntervalTreeNode(K low, K high, unsigned int priority)
+    : m_low(low), m_high(high), m_max(high), m_priority(priority),
+      m_parent(0), m_left(0), m_right(0)
+{
+}
+
+
+template<class K>
+IntervalTreeNode<K>::~IntervalTreeNode()
+{
+}
+
+
+template<class K>
+const K & IntervalTreeNode<K>::low() const
+{
+    return m_low;
+}
+
+
+template<class K>
+const K & IntervalTreeNode<K>::high() const
+{
+    return m_high;
+}
+
+
+template<class K>
+const K & IntervalTreeNode<K>::max() const
+{
+    return m_max;
+}
+
+
+template<class K>
+unsigned int IntervalTreeNode<K>::priority() const
+{
+    return m_priority;
+}
+
+
+template<class K>
+IntervalTreeNode<K> * IntervalTreeNode<K>::parent() const
+{
+    return m_parent;
+}
+
+
+template<class K>
+IntervalTreeNode<K> * IntervalTreeNode<K>::left() const
+{
+    return m_left;
+}
+
+
+template<class K>
+IntervalTreeNode<K> * IntervalTreeNode<K>::right() const
+{
+    return m_right;
+}
+
+
+template<class K>
+void IntervalTreeNode<K>::set_max(const K & max)
+{
+    m_max = max;
+}
+
+
+template<class K>
+void IntervalTreeNode<K>::set_parent(IntervalTreeNode<K> * parent)
+{
+    m_parent = parent;
+}
+
+
+template<class K>
+void IntervalTreeNode<K>::set_left(IntervalTreeNode<K> * left)
+{
+    m_left = left;
+}
+
+
+template<class K>
+void IntervalTreeNode<K>::set_right(IntervalTreeNode<K> * right)
+{
+    m_right = right;
+}
+
+#endif /* INTERVALTREENODE_H_ */
@@ -0,0 +1,15 @@
+/**
+ * @class LowestCommonAncestor
+ *
+ * @file lowestcommonancestor.cpp
+ *
+ * @brief Lowest common ancestor engine for static binary trees class
+ * implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "lowestcommonancestor.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,443 @@
+#ifndef LOWESTCOMMONANCESTOR_H_
+#define LOWESTCOMMONANCESTOR_H_
+
+#include "../binarytree/binarytreenode.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class LowestCommonAncestor
+ *
+ * @file lowestcommonancestor.h
+ *
+ * @brief Lowest common ancestor engine for static binary trees.
+ *
+ * <p>
+ * Unlike <code>BinaryTree::lowest_common_ancestor_bst</code>, which walks
+ * down from the root and relies on the binary search tree ordering, this
+ * class preprocesses an arbitrary binary tree once and then answers lowest
+ * common ancestor queries on its nodes in O(1) time each.
+ *
+ * The nodes are numbered in preorder. Between the first occurrences of two
+ * nodes u and v in the <em>Euler tour</em> of the tree (the sequence of nodes
+ * met by a depth-first walk, a node being listed again every time the walk
+ * returns to it) appear only nodes of the subtree of their lowest common
+ * ancestor, and the ancestor itself. Since in preorder an ancestor is
+ * numbered before every node in its subtree, the lowest common ancestor is
+ * the node with the minimum number in that range. The range minimum is
+ * answered from a <em>sparse table</em> holding the minimum of every range
+ * whose length is a power of two: any range is covered by two such ranges
+ * that may overlap. Preprocessing takes O(n log n) time and space.
+ *
+ * For batches of queries known in advance, <code>query_offline</code>
+ * implements Tarjan's offline algorithm, which answers them all in a single
+ * depth-first walk using a disjoint-set forest.
+ *
+ * The tree is not copied: the engine describes the tree as it was when the
+ * engine was constructed, and has to be rebuilt if the tree changes.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class LowestCommonAncestor {
+public:
+    /**
+     * A pair of nodes whose lowest common ancestor is asked.
+     */
+    typedef std::pair<BinaryTreeNode<T> *, BinaryTreeNode<T> *> Query;
+
+    /**
+     * Constructor. Preprocesses the tree rooted at the given node.
+     *
+     * @param[in] root
+     *     The root node of the tree.
+     */
+    explicit LowestCommonAncestor(BinaryTreeNode<T> * root);
+
+    /**
+     * Destructor.
+     */
+    virtual ~LowestCommonAncestor();
+
+    // -- getter methods
+
+    /**
+     * Getter for the number of nodes in the tree.
+     *
+     * @return
+     *     The number of nodes preprocessed.
+     */
+    int size() const;
+
+    /**
+     * The preorder number of a node. Takes O(1) expected time.
+     *
+     * Queries on numbers skip the lookup of the nodes in a hash table, and
+     * are the fastest way to ask many queries on the same nodes.
+     *
+     * @param[in] node
+     *     A node of the tree.
+     *
+     * @return
+     *     The preorder number of the node, in [0, size()); -1 if the node
+     *     does not belong to the tree.
+     */
+    int index(BinaryTreeNode<T> * node) const;
+
+    /**
+     * The node with a given preorder number.
+     *
+     * @param[in] index
+     *     A preorder number, in [0, size()).
+     *
+     * @return
+     *     A pointer to the node.
+     */
+    BinaryTreeNode<T> * node(int index) const;
+
+    // -- public methods
+
+    /**
+     * Lowest common ancestor of two nodes, given by preorder number. Takes
+     * O(1) time.
+     *
+     * @param[in] one
+     *     The preorder number of the first node.
+     * @param[in] another
+     *     The preorder number of the second node.
+     *
+     * @return
+     *     The preorder number of the lowest common ancestor.
+     */
+    int query(int one, int another) const;
+
+    /**
+     * Lowest common ancestor of two nodes. Takes O(1) expected time.
+     *
+     * @param[in] one
+     *     The first node.
+     * @param[in] another
+     *     The second node.
+     *
+     * @return
+     *     A pointer to the lowest common ancestor of the given nodes;
+     *     <code>null</code> if either node does not belong to the tree.
+     */
+    BinaryTreeNode<T> * query(BinaryTreeNode<T> * one, BinaryTreeNode<T> * another) const;
+
+    /**
+     * Answers a batch of queries with Tarjan's offline algorithm.
+     *
+     * The tree is walked depth first once. When the walk leaves a node, the
+     * node is merged into the set of its parent, whose representative is
+     * tagged with the parent; for every query whose other node has already
+     * been left, the tag of that node's set is the answer. Takes nearly
+     * O(n + q) time and does not use the sparse table.
+     *
+     * @param[in] queries
+     *     The queries.
+     * @param[out] answers
+     *     Resized to the number of queries; the i-th answer is the lowest
+     *     common ancestor of the i-th query, or <code>null</code> if either
+     *     node does not belong to the tree.
+     */
+    void query_offline(const std::vector<Query> & queries, std::vector<BinaryTreeNode<T> *> & answers) const;
+protected:
+private:
+    /**
+     * Finds the representative of a set, halving the path to it on the way.
+     *
+     * @param[in,out] parents
+     *     The disjoint-set forest.
+     * @param[in] x
+     *     An element.
+     *
+     * @return
+     *     The representative of the set of the element.
+     */
+    static int find(std::vector<int> & parents, int x);
+
+    /**
+     * The nodes of the tree, in preorder.
+     */
+    std::vector<BinaryTreeNode<T> *> m_nodes;
+
+    /**
+     * The preorder number of the right child of each node; -1 if there is
+     * none. The left child of node i, if any, is node i + 1.
+     */
+    std::vector<int> m_right;
+
+    /**
+     * The preorder number of each node.
+     */
+    std::unordered_map<BinaryTreeNode<T> *, int> m_index;
+
+    /**
+     * The position of the first occurrence of each node in the Euler tour.
+     */
+    std::vector<int> m_first;
+
+    /**
+     * The sparse table. Level k holds, for every position i of the Euler
+     * tour, the minimum preorder number in the 2^k entries starting at i.
+     * Level 0 is the Euler tour itself.
+     */
+    std::vector<std::vector<int> > m_table;
+
+    /**
+     * The floor of the base 2 logarithm of every range length.
+     */
+    std::vector<int> m_log;
+};
+
+
+template<class T>
+LowestCommonAncestor<T>::LowestCommonAncestor(BinaryTreeNode<T> * root)
+{
+    if (root == 0)
+        return;
+
+    // Preorder numbering and Euler tour in one iterative walk. Each stack
+    // entry is a node and how far its visit has got: 0 when entering it, 1
+    // after its left subtree, 2 after its right one. A node is appended to
+    // the tour every time it comes back to the top of the stack.
+    std::vector<int> euler;
+    std::vector<std::pair<BinaryTreeNode<T> *, int> > st;
+    std::vector<int> ids;
+
+    st.push_back(std::make_pair(root, 0));
+    while (!st.empty())
+    {
+        BinaryTreeNode<T> * node = st.back().first;
+        int & state = st.back().second;
+
+        if (state == 0)
+        {
+            int id = (int) m_nodes.size();
+            m_index[node] = id;
+            m_nodes.push_back(node);
+            m_right.push_back(-1);
+            m_first.push_back((int) euler.size());
+            ids.push_back(id);
+        }
+
+        int id = ids[st.size() - 1];
+        euler.push_back(id);
+
+        BinaryTreeNode<T> * child = 0;
+        if (state == 0)
+        {
+            child = node->left();
+            state = 1;
+        }
+        if (child == 0 && state == 1)
+        {
+            child = node->right();
+            state = 2;
+            if (child != 0)
+                m_right[id] = (int) m_nodes.size();
+        }
+
+        if (child != 0)
+        {
+            st.push_back(std::make_pair(child, 0));
+        }
+        else
+        {
+            st.pop_back();
+            ids.pop_back();
+        }
+    }
+
+    int length = (int) euler.size();
+
+    m_log.assign(length + 1, 0);
+    for (int i = 2; i <= length; i++)
+        m_log[i] = m_log[i / 2] + 1;
+
+    m_table.resize(m_log[length] + 1);
+    m_table[0].swap(euler);
+    for (int k = 1; k < (int) m_table.size(); k++)
+    {
+        const std::vector<int> & below = m_table[k - 1];
+        int half = 1 << (k - 1);
+        int count = length - (1 << k) + 1;
+
+        m_table[k].resize(count);
+        for (int i = 0; i < count; i++)
+            m_table[k][i] = std::min(below[i], below[i + half]);
+    }
+}
+
+
+template<class T>
+LowestCommonAncestor<T>::~LowestCommonAncestor()
+{
+}
+
+
+template<class T>
+int LowestCommonAncestor<T>::size() const
+{
+    return (int) m_nodes.size();
+}
+
+
+template<class T>
+int LowestCommonAncestor<T>::index(BinaryTreeNode<T> * node) const
+{
+    typename std::unordered_map<BinaryTreeNode<T> *, int>::const_iterator it = m_index.find(node);
+
+    return it != m_index.end() ? it->second : -1;
+}
+
+
+template<class T>
+BinaryTreeNode<T> * LowestCommonAncestor<T>::node(int index) const
+{
+    return m_nodes[index];
+}
+
+
+template<class T>
+int LowestCommonAncestor<T>::query(int one, int another) const
+{
+    int lo = m_first[one];
+    int hi = m_first[another];
+    if (lo > hi)
+        std::swap(lo, hi);
+
+    int k = m_log[hi - lo + 1];
+    const std::vector<int> & level = m_table[k];
+
+    return std::min(level[lo], level[hi - (1 << k) + 1]);
+}
+
+
+template<class T>
+BinaryTreeNode<T> * LowestCommonAncestor<T>::query(BinaryTreeNode<T> * one, BinaryTreeNode<T> * another) const
+{
+    int u = index(one);
+    int v = index(another);
+
+    if (u < 0 || v < 0)
+        return 0;
+
+    return m_nodes[query(u, v)];
+}
+
+
+template<class T>
+void LowestCommonAncestor<T>::query_offline(const std::vector<Query> & queries, std::vector<BinaryTreeNode<T> *> & answers) const
+{
+    int n = (int) m_nodes.size();
+    int q = (int) queries.size();
+
+    answers.assign(q, 0);
+
+    // The queries of every node, as a compressed adjacency list: the queries
+    // of node u are others[offsets[u]] .. others[offsets[u + 1] - 1].
+    std::vector<int> ends(2 * q, -1);
+    std::vector<int> offsets(n + 1, 0);
+    for (int i = 0; i < q; i++)
+    {
+        int u = index(queries[i].first);
+        int v = index(queries[i].second);
+        if (u < 0 || v < 0)
+            continue;
+        ends[2 * i] = u;
+        ends[2 * i + 1] = v;
+        offsets[u + 1]++;
+        offsets[v + 1]++;
+    }
+    for (int u = 0; u < n; u++)
+        offsets[u + 1] += offsets[u];
+
+    std::vector<int> others(offsets[n]);
+    std::vector<int> owners(offsets[n]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < q; i++)
+    {
+        int u = ends[2 * i];
+        int v = ends[2 * i + 1];
+        if (u < 0)
+            continue;
+        others[fill[u]] = v;
+        owners[fill[u]++] = i;
+        others[fill[v]] = u;
+        owners[fill[v]++] = i;
+    }
+
+    std::vector<int> parents(n);
+    std::vector<int> ancestors(n);
+    std::vector<char> done(n, 0);
+    for (int u = 0; u < n; u++)
+        parents[u] = ancestors[u] = u;
+
+    // Iterative postorder walk over the preorder numbers. A node is left
+    // once both its children have been; its left child is the next number.
+    std::vector<std::pair<int, int> > st;
+    if (n > 0)
+        st.push_back(std::make_pair(0, 0));
+    while (!st.empty())
+    {
+        int u = st.back().first;
+        int & state = st.back().second;
+
+        if (state == 0)
+        {
+            state = 1;
+            if (m_nodes[u]->left() != 0)
+            {
+                st.push_back(std::make_pair(u + 1, 0));
+                continue;
+            }
+        }
+        if (state == 1)
+        {
+            state = 2;
+            if (m_right[u] >= 0)
+            {
+                st.push_back(std::make_pair(m_right[u], 0));
+                continue;
+            }
+        }
+
+        done[u] = 1;
+        for (int j = offsets[u]; j < offsets[u + 1]; j++)
+            if (done[others[j]])
+                answers[owners[j]] = m_nodes[ancestors[find(parents, others[j])]];
+
+        st.pop_back();
+        if (!st.empty())
+        {
+            // Union with the parent; the parent's set keeps the parent as
+            // its ancestor tag.
+            int p = st.back().first;
+            int ru = find(parents, u);
+            int rp = find(parents, p);
+            parents[ru] = rp;
+            ancestors[rp] = p;
+        }
+    }
+}
+
+
+template<class T>
+int LowestCommonAncestor<T>::find(std::vector<int> & parents, int x)
+{
+    while (parents[x] != x)
+    {
+        parents[x] = parents[parents[x]];
+        x = parents[x];
+    }
+
+    return x;
+}
+
+#endif /* LOWESTCOMMONANCESTOR_H_ */
@@ -0,0 +1,222 @@
+/**
+ * @file lowestcommonancestor_test.cpp
+ *
+ * @brief Test unit for the lowest common ancestor engine class.
+ *
+ * @see lowestcommonancestor.h lowestcommonancestor.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "lowestcommonancestor.h"
+#include "../binarytree/binarytree.h"
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+void test_query();
+void test_query_offline();
+void test_non_bst();
+void test_query_timing();
+
+int main (int argc, char** argv)
+{
+    test_query();
+    test_query_offline();
+    test_non_bst();
+    test_query_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+BinaryTree<int> * init_tree_std()
+{
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    int keys[] = { 100, 50, 150, 25, 75, 125, 175, 110 };
+
+    for (int i = 0; i < 8; i++)
+        bst->insert_iterative(new BinaryTreeNode<int>(keys[i]));
+
+    return bst;
+}
+
+
+// test functions
+
+
+void test_query()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    LowestCommonAncestor<int> lca(bst->root());
+
+    int pairs[][2] = { { 110, 175 }, { 25, 75 }, { 25, 110 }, { 125, 110 }, { 75, 75 }, { 100, 25 } };
+    for (int i = 0; i < 6; i++)
+    {
+        BinaryTreeNode<int> * one = bst->search_iterative(bst->root(), pairs[i][0]);
+        BinaryTreeNode<int> * another = bst->search_iterative(bst->root(), pairs[i][1]);
+        std::cout << "LCA(" << pairs[i][0] << ", " << pairs[i][1] << "): "
+                << lca.query(one, another)->key()
+                << " (bst walk: " << bst->lowest_common_ancestor_bst(pairs[i][0], pairs[i][1])->key()
+                << ")" << std::endl;
+    }
+
+    BinaryTreeNode<int> stranger(0);
+    std::cout << "LCA with a node outside the tree: "
+            << (lca.query(bst->root(), &stranger) ? "found" : "none") << std::endl;
+
+    delete bst;
+    std::cout << std::endl;
+}
+
+
+void test_query_offline()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    LowestCommonAncestor<int> lca(bst->root());
+
+    int pairs[][2] = { { 110, 175 }, { 25, 75 }, { 25, 110 }, { 125, 110 }, { 75, 75 }, { 100, 25 } };
+    std::vector<LowestCommonAncestor<int>::Query> queries;
+    for (int i = 0; i < 6; i++)
+        queries.push_back(LowestCommonAncestor<int>::Query(
+                bst->search_iterative(bst->root(), pairs[i][0]),
+                bst->search_iterative(bst->root(), pairs[i][1])));
+
+    std::vector<BinaryTreeNode<int> *> answers;
+    lca.query_offline(queries, answers);
+
+    for (int i = 0; i < 6; i++)
+        std::cout << "LCA(" << pairs[i][0] << ", " << pairs[i][1] << "): "
+                << answers[i]->key() << std::endl;
+
+    delete bst;
+    std::cout << std::endl;
+}
+
+
+/**
+ * The engine does not rely on key order: a tree whose keys are not in search
+ * tree order is answered the same.
+ */
+void test_non_bst()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    // 1 has children 2 and 3; 2 has right child 4, whose left child is 6;
+    // 3 has left child 5.
+    BinaryTreeNode<int> * _6 = new BinaryTreeNode<int>(6);
+    BinaryTreeNode<int> * _4 = new BinaryTreeNode<int>(4, 0, _6, 0);
+    BinaryTreeNode<int> * _2 = new BinaryTreeNode<int>(2, 0, 0, _4);
+    BinaryTreeNode<int> * _5 = new BinaryTreeNode<int>(5);
+    BinaryTreeNode<int> * _3 = new BinaryTreeNode<int>(3, 0, _5, 0);
+    BinaryTreeNode<int> * _1 = new BinaryTreeNode<int>(1, 0, _2, _3);
+    BinaryTree<int> tree(_1);
+
+    LowestCommonAncestor<int> lca(_1);
+    std::cout << "LCA(6, 2): " << lca.query(_6, _2)->key() << std::endl;
+    std::cout << "LCA(6, 5): " << lca.query(_6, _5)->key() << std::endl;
+    std::cout << "LCA(4, 6): " << lca.query(_4, _6)->key() << std::endl;
+    std::cout << "LCA(5, 3): " << lca.query(_5, _3)->key() << std::endl;
+
+    std::vector<LowestCommonAncestor<int>::Query> queries;
+    queries.push_back(LowestCommonAncestor<int>::Query(_6, _2));
+    queries.push_back(LowestCommonAncestor<int>::Query(_6, _5));
+    queries.push_back(LowestCommonAncestor<int>::Query(_4, _6));
+    queries.push_back(LowestCommonAncestor<int>::Query(_5, _3));
+    std::vector<BinaryTreeNode<int> *> answers;
+    lca.query_offline(queries, answers);
+    std::cout << "Offline:";
+    for (size_t i = 0; i < answers.size(); i++)
+        std::cout << " " << answers[i]->key();
+    std::cout << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Answers random queries on a random search tree with the root walk of
+ * lowest_common_ancestor_bst, the sparse table and Tarjan's algorithm.
+ */
+void test_query_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int nodes = 1 << 17;
+    const int count = 1 << 20;
+
+    srand(7);
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    std::vector<BinaryTreeNode<int> *> all;
+    for (int i = 0; i < nodes; i++)
+    {
+        int key = rand();
+        if (bst->search_iterative(bst->root(), key))
+            continue;
+        BinaryTreeNode<int> * node = new BinaryTreeNode<int>(key);
+        bst->insert_iterative(node);
+        all.push_back(node);
+    }
+
+    std::vector<LowestCommonAncestor<int>::Query> queries(count);
+    for (int i = 0; i < count; i++)
+        queries[i] = LowestCommonAncestor<int>::Query(all[rand() % all.size()], all[rand() % all.size()]);
+
+    long sum = 0;
+    clock_t start = clock();
+    for (int i = 0; i < count; i++)
+        sum += bst->lowest_common_ancestor_bst(queries[i].first->key(), queries[i].second->key())->key();
+    double walk_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    LowestCommonAncestor<int> lca(bst->root());
+    double build_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    std::vector<int> ids(2 * count);
+    for (int i = 0; i < count; i++)
+    {
+        ids[2 * i] = lca.index(queries[i].first);
+        ids[2 * i + 1] = lca.index(queries[i].second);
+    }
+
+    long table_sum = 0;
+    start = clock();
+    for (int i = 0; i < count; i++)
+        table_sum += lca.node(lca.query(ids[2 * i], ids[2 * i + 1]))->key();
+    double table_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    long offline_sum = 0;
+    std::vector<BinaryTreeNode<int> *> answers;
+    start = clock();
+    lca.query_offline(queries, answers);
+    for (int i = 0; i < count; i++)
+        offline_sum += answers[i]->key();
+    double offline_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << all.size() << " nodes, " << count << " queries" << std::endl;
+    std::cout << "lowest_common_ancestor_bst: " << walk_secs << "s" << std::endl;
+    std::cout << "Sparse table: build " << build_secs << "s, queries " << table_secs << "s" << std::endl;
+    std::cout << "Tarjan offline: " << offline_secs << "s" << std::endl;
+    std::cout << "Answers " << (sum == table_sum && sum == offline_sum ? "agree" : "DIFFER") << std::endl;
+
+    delete bst;
+    std::cout << std::endl;
+}
@@ -0,0 +1,14 @@
+/**
+ * @class PersistentBinaryTree
+ *
+ * @file persistentbinarytree.cpp
+ *
+ * @brief Persistent (immutable) binary search tree class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "persistentbinarytree.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,589 @@
+#ifndef PERSISTENTBINARYTREE_H_
+#define PERSISTENTBINARYTREE_H_
+
+#include "../binarytree/binarytreenode.h"
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+/**
+ * @class PersistentBinaryTree
+ *
+ * @file persistentbinarytree.h
+ *
+ * Persistent (immutable) binary search tree class definition.
+ *
+ * <p>
+ * A persistent data structure preserves its previous versions when it is
+ * modified. Every object of this class is one <em>version</em> of a binary
+ * search tree and never changes once constructed: <code>insert</code> and
+ * <code>remove</code> leave the version they are called on untouched and
+ * return a new one.
+ *
+ * The versions share structure through <em>path copying</em>. An update only
+ * changes the nodes on the path from the root to the node that is inserted or
+ * removed, so only these O(h) nodes are copied; every subtree hanging off the
+ * path is shared with the previous version. Taking a snapshot is therefore a
+ * matter of copying a root pointer, and an update costs O(h) time and space
+ * instead of the Θ(n) of a full <code>BinaryTree::copy</code>.
+ *
+ * Since a node may belong to any number of versions, nodes are reference
+ * counted: a node counts the versions that use it as their root plus the
+ * nodes that use it as a child. When the last version that can reach a node
+ * goes away, the node is reclaimed. The counts are atomic, so versions may be
+ * handed to and dropped by different threads; a single version object that is
+ * assigned to by one thread while read by another needs external
+ * synchronisation, like any other value.
+ *
+ * Keys are ordered like in BinaryTree: keys equal to a node's key go to its
+ * right subtree.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class PersistentBinaryTree {
+public:
+    /**
+     * Default constructor. Creates the empty version.
+     */
+    PersistentBinaryTree();
+
+    /**
+     * Constructor. Copies an existing binary tree into a first persistent
+     * version. Takes Θ(n) time.
+     *
+     * @param[in] root
+     *     The root node of the binary tree to copy.
+     */
+    explicit PersistentBinaryTree(BinaryTreeNode<T> * root);
+
+    /**
+     * Copy constructor. Takes a snapshot of a version in O(1) time.
+     *
+     * @param[in] other
+     *     The version to share.
+     */
+    PersistentBinaryTree(const PersistentBinaryTree<T> & other);
+
+    /**
+     * Destructor. Releases the nodes no other version uses.
+     */
+    virtual ~PersistentBinaryTree();
+
+    /**
+     * Assignment. Makes this object refer to another version in O(1) time,
+     * releasing the version it referred to.
+     *
+     * @param[in] other
+     *     The version to share.
+     *
+     * @return
+     *     A reference to this object.
+     */
+    PersistentBinaryTree<T> & operator = (const PersistentBinaryTree<T> & other);
+
+    // -- getter methods
+
+    /**
+     * Checks if the version is empty.
+     *
+     * @return
+     *     <code>true</code> if the version holds no keys; <code>false</code>
+     *     otherwise.
+     */
+    bool empty() const;
+
+    // -- public methods
+
+    /**
+     * Creates a new version with the given key inserted. Takes O(h) time and
+     * space, on a tree of height h.
+     *
+     * @param[in] key
+     *     The key to insert.
+     *
+     * @return
+     *     The new version.
+     */
+    PersistentBinaryTree<T> insert(T key) const;
+
+    /**
+     * Creates a new version with (one occurrence of) the given key removed.
+     * Takes O(h) time and space, on a tree of height h.
+     *
+     * A node with two children is replaced, as in BinaryTree::remove, by a
+     * copy carrying the key of its inorder successor, and the successor is
+     * removed from the right subtree; both steps copy nodes on a single
+     * root-to-leaf path.
+     *
+     * @param[in] key
+     *     The key to remove.
+     *
+     * @return
+     *     The new version; a snapshot of this one if the key is absent.
+     */
+    PersistentBinaryTree<T> remove(T key) const;
+
+    /**
+     * Iterative lookup of a key. Takes O(h) time, on a tree of height h.
+     *
+     * @param[in] key
+     *     The key to search.
+     *
+     * @return
+     *     <code>true</code> if the key is present in this version;
+     *     <code>false</code> otherwise.
+     */
+    bool search_iterative(T key) const;
+
+    /**
+     * Location of the minimum key of the version.
+     *
+     * @param[out] key
+     *     Set to the minimum key if the version is not empty.
+     *
+     * @return
+     *     <code>false</code> for an empty version; <code>true</code>
+     *     otherwise.
+     */
+    bool minimum(T & key) const;
+
+    /**
+     * Location of the maximum key of the version.
+     *
+     * @param[out] key
+     *     Set to the maximum key if the version is not empty.
+     *
+     * @return
+     *     <code>false</code> for an empty version; <code>true</code>
+     *     otherwise.
+     */
+    bool maximum(T & key) const;
+
+    /**
+     * Depth-first inorder traversal that hands every key to a visitor.
+     *
+     * The visitor takes a key and returns <code>false</code> to stop the
+     * traversal.
+     *
+     * @param[in] visit
+     *     The visitor to call on each key.
+     *
+     * @return
+     *     <code>true</code> if every key was visited; <code>false</code> if
+     *     the visitor terminated the traversal early.
+     */
+    template<class Visitor>
+    bool dft_inorder(Visitor visit) const;
+protected:
+private:
+    /**
+     * An immutable, reference counted tree node.
+     */
+    struct Node
+    {
+        const T key;
+        Node * const left;
+        Node * const right;
+        mutable std::atomic<int> references;
+
+        // Takes over one reference to each child.
+        Node(const T & k, Node * l, Node * r)
+            : key(k), left(l), right(r), references(1) {}
+    };
+
+    /**
+     * Constructor. Takes over one reference to the given root.
+     *
+     * @param[in] root
+     *     The root of the version.
+     */
+    PersistentBinaryTree(Node * root, bool);
+
+    /**
+     * Adds a reference to a node.
+     *
+     * @param[in] node
+     *     The node; may be <code>null</code>.
+     *
+     * @return
+     *     The node.
+     */
+    static Node * retain(Node * node);
+
+    /**
+     * Drops a reference to a node, reclaiming it and, transitively, any
+     * children it held the last reference to.
+     *
+     * @param[in] node
+     *     The node; may be <code>null</code>.
+     */
+    static void release(Node * node);
+
+    /**
+     * A search path: the nodes from the root down, each with
+     * <code>true</code> if the search went on to its left child.
+     */
+    typedef std::vector<std::pair<Node *, bool> > Path;
+
+    /**
+     * Copies a BinaryTree subtree into fresh nodes.
+     */
+    static Node * copy(BinaryTreeNode<T> * root);
+
+    /**
+     * Copies the nodes of a search path bottom-up, sharing every child off
+     * the path, with the child below the last one replaced.
+     *
+     * @param[in] path
+     *     The search path.
+     * @param[in] subtree
+     *     A reference to the new subtree below the last node of the path.
+     *
+     * @return
+     *     A new reference to the root of the copied path; the subtree itself
+     *     if the path is empty.
+     */
+    static Node * copy_path(const Path & path, Node * subtree);
+
+    /**
+     * Path-copying insertion.
+     *
+     * @return
+     *     A new reference to the root of the updated subtree.
+     */
+    static Node * insert(Node * root, const T & key);
+
+    /**
+     * Path-copying removal of a key known to be in the subtree.
+     *
+     * @return
+     *     A new reference to the root of the updated subtree.
+     */
+    static Node * remove(Node * root, const T & key);
+
+    /**
+     * Path-copying removal of the minimum of a non-empty subtree.
+     *
+     * @param[in] root
+     *     The root of the subtree.
+     * @param[out] minimum
+     *     Set to the removed key.
+     *
+     * @return
+     *     A new reference to the root of the updated subtree.
+     */
+    static Node * remove_minimum(Node * root, T & minimum);
+
+    /**
+     * The root of this version.
+     */
+    Node * m_root;
+};
+
+
+template<class T>
+PersistentBinaryTree<T>::PersistentBinaryTree()
+    : m_root(0)
+{
+}
+
+
+template<class T>
+PersistentBinaryTree<T>::PersistentBinaryTree(BinaryTreeNode<T> * root)
+    : m_root(copy(root))
+{
+}
+
+
+template<class T>
+PersistentBinaryTree<T>::PersistentBinaryTree(const PersistentBinaryTree<T> & other)
+    : m_root(retain(other.m_root))
+{
+}
+
+
+template<class T>
+PersistentBinaryTree<T>::PersistentBinaryTree(Node * root, bool)
+    : m_root(root)
+{
+}
+
+
+template<class T>
+PersistentBinaryTree<T>::~PersistentBinaryTree()
+{
+    release(m_root);
+}
+
+
+template<class T>
+PersistentBinaryTree<T> & PersistentBinaryTree<T>::operator = (const PersistentBinaryTree<T> & other)
+{
+    // Retain first, in case both refer to the same version.
+    Node * root = retain(other.m_root);
+    release(m_root);
+    m_root = root;
+
+    return *this;
+}
+
+
+template<class T>
+bool PersistentBinaryTree<T>::empty() const
+{
+    return m_root == 0;
+}
+
+
+template<class T>
+PersistentBinaryTree<T> PersistentBinaryTree<T>::insert(T key) const
+{
+    return PersistentBinaryTree<T>(insert(m_root, key), true);
+}
+
+
+template<class T>
+PersistentBinaryTree<T> PersistentBinaryTree<T>::remove(T key) const
+{
+    if (!search_iterative(key))
+        return *this;
+
+    return PersistentBinaryTree<T>(remove(m_root, key), true);
+}
+
+
+template<class T>
+bool PersistentBinaryTree<T>::search_iterative(T key) const
+{
+    Node * node = m_root;
+
+    while (node != 0 && node->key != key) {
+        if (node->key > key)
+            node = node->left;
+        else
+            node = node->right;
+    }
+
+    return node != 0;
+}
+
+
+template<class T>
+bool PersistentBinaryTree<T>::minimum(T & key) const
+{
+    if (m_root == 0)
+        return false;
+
+    Node * node = m_root;
+    while (node->left != 0)
+        node = node->left;
+
+    key = node->key;
+    return true;
+}
+
+
+template<class T>
+bool PersistentBinaryTree<T>::maximum(T & key) const
+{
+    if (m_root == 0)
+        return false;
+
+    Node * node = m_root;
+    while (node->right != 0)
+        node = node->right;
+
+    key = node->key;
+    return true;
+}
+
+
+template<class T>
+template<class Visitor>
+bool PersistentBinaryTree<T>::dft_inorder(Visitor visit) const
+{
+    std::vector<Node *> st;
+    Node * node = m_root;
+
+    while (node || !st.empty())
+    {
+        if (node)
+        {
+            st.push_back(node);
+            node = node->left;
+        }
+        else
+        {
+            node = st.back();
+            st.pop_back();
+
+            if (!visit(node->key))
+                return false;
+
+            node = node->right;
+        }
+    }
+
+    return true;
+}
+
+
+template<class T>
+typename PersistentBinaryTree<T>::Node * PersistentBinaryTree<T>::retain(Node * node)
+{
+    if (node != 0)
+        node->references++;
+
+    return node;
+}
+
+
+template<class T>
+void PersistentBinaryTree<T>::release(Node * node)
+{
+    // Iterative, so that dropping a long chain of nodes cannot overflow the
+    // call stack.
+    std::vector<Node *> dead;
+
+    if (node != 0 && --node->references == 0)
+        dead.push_back(node);
+
+    while (!dead.empty())
+    {
+        Node * d = dead.back();
+        dead.pop_back();
+
+        if (d->left != 0 && --d->left->references == 0)
+            dead.push_back(d->left);
+        if (d->right != 0 && --d->right->references == 0)
+            dead.push_back(d->right);
+
+        delete d;
+    }
+}
+
+
+template<class T>
+typename PersistentBinaryTree<T>::Node * PersistentBinaryTree<T>::copy(BinaryTreeNode<T> * root)
+{
+    // Postorder with an explicit stack, since a node can only be created
+    // once both of its children are; a degenerate tree as deep as it is
+    // large must not overflow the call stack.
+    std::vector<std::pair<BinaryTreeNode<T> *, bool> > pending;
+    std::vector<Node *> copied;
+
+    pending.push_back(std::make_pair(root, false));
+    while (!pending.empty())
+    {
+        BinaryTreeNode<T> * node = pending.back().first;
+        bool children_copied = pending.back().second;
+        pending.pop_back();
+
+        if (node == 0)
+        {
+            copied.push_back(0);
+        }
+        else if (!children_copied)
+        {
+            pending.push_back(std::make_pair(node, true));
+            pending.push_back(std::make_pair(node->right(), false));
+            pending.push_back(std::make_pair(node->left(), false));
+        }
+        else
+        {
+            Node * right = copied.back();
+            copied.pop_back();
+            Node * left = copied.back();
+            copied.pop_back();
+            copied.push_back(new Node(node->key(), left, right));
+        }
+    }
+
+    return copied.back();
+}
+
+
+template<class T>
+typename PersistentBinaryTree<T>::Node * PersistentBinaryTree<T>::copy_path(const Path & path, Node * subtree)
+{
+    for (typename Path::size_type i = path.size(); i-- > 0; )
+    {
+        Node * node = path[i].first;
+
+        // Copy the node on the path; the subtree off the path is shared.
+        if (path[i].second)
+            subtree = new Node(node->key, subtree, retain(node->right));
+        else
+            subtree = new Node(node->key, retain(node->left), subtree);
+    }
+
+    return subtree;
+}
+
+
+template<class T>
+typename PersistentBinaryTree<T>::Node * PersistentBinaryTree<T>::insert(Node * root, const T & key)
+{
+    Path path;
+
+    for (Node * node = root; node != 0; )
+    {
+        bool left = key < node->key;
+        path.push_back(std::make_pair(node, left));
+        node = left ? node->left : node->right;
+    }
+
+    return copy_path(path, new Node(key, 0, 0));
+}
+
+
+template<class T>
+typename PersistentBinaryTree<T>::Node * PersistentBinaryTree<T>::remove(Node * root, const T & key)
+{
+    Path path;
+    Node * node = root;
+
+    while (key != node->key)
+    {
+        bool left = key < node->key;
+        path.push_back(std::make_pair(node, left));
+        node = left ? node->left : node->right;
+    }
+
+    Node * replacement;
+    if (node->left == 0)
+        replacement = retain(node->right);
+    else if (node->right == 0)
+        replacement = retain(node->left);
+    else
+    {
+        // Two children: the inorder successor takes the node's place.
+        T successor = node->key;
+        Node * right = remove_minimum(node->right, successor);
+        replacement = new Node(successor, retain(node->left), right);
+    }
+
+    return copy_path(path, replacement);
+}
+
+
+template<class T>
+typename PersistentBinaryTree<T>::Node * PersistentBinaryTree<T>::remove_minimum(Node * root, T & minimum)
+{
+    Path path;
+    Node * node = root;
+
+    while (node->left != 0)
+    {
+        path.push_back(std::make_pair(node, true));
+        node = node->left;
+    }
+
+    minimum = node->key;
+    return copy_path(path, retain(node->right));
+}
+
+#endif /* PERSISTENTBINARYTREE_H_ */
@@ -0,0 +1,259 @@
+/**
+ * @file persistentbinarytree_test.cpp
+ *
+ * @brief Test unit for the persistent binary search tree class.
+ *
+ * @see persistentbinarytree.h persistentbinarytree.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "persistentbinarytree.h"
+#include "../binarytree/binarytree.h"
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+void test_versions();
+void test_remove();
+void test_from_binary_tree();
+void test_sorted_chain();
+void test_snapshot_timing();
+
+int main (int argc, char** argv)
+{
+    test_versions();
+    test_remove();
+    test_from_binary_tree();
+    test_sorted_chain();
+    test_snapshot_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Visitor that prints the keys it is given.
+ */
+struct KeyPrinter
+{
+    bool operator()(int key) const
+    {
+        std::cout << " " << key;
+        return true;
+    }
+};
+
+
+void print_version(const char * name, const PersistentBinaryTree<int> & version)
+{
+    std::cout << name << ":";
+    version.dft_inorder(KeyPrinter());
+    std::cout << std::endl;
+}
+
+
+/**
+ * Visitor that counts the keys it is given and checks they increase.
+ */
+struct SortedCounter
+{
+    int & count;
+    int & last;
+
+    SortedCounter(int & c, int & l) : count(c), last(l) {}
+
+    bool operator()(int key) const
+    {
+        if (count > 0 && key < last)
+            return false;
+        last = key;
+        count++;
+        return true;
+    }
+};
+
+
+PersistentBinaryTree<int> init_tree_std()
+{
+    PersistentBinaryTree<int> tree;
+    int keys[] = { 100, 50, 150, 25, 75, 125, 175, 110 };
+
+    for (int i = 0; i < 8; i++)
+        tree = tree.insert(keys[i]);
+
+    return tree;
+}
+
+
+// test functions
+
+
+void test_versions()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    PersistentBinaryTree<int> v0;
+    PersistentBinaryTree<int> v1 = v0.insert(100);
+    PersistentBinaryTree<int> v2 = v1.insert(50).insert(150);
+    PersistentBinaryTree<int> v3 = v2.insert(75);
+
+    print_version("v0", v0);
+    print_version("v1", v1);
+    print_version("v2", v2);
+    print_version("v3", v3);
+
+    std::cout << "v2 has 75: " << (v2.search_iterative(75) ? "yes" : "no") << std::endl;
+    std::cout << "v3 has 75: " << (v3.search_iterative(75) ? "yes" : "no") << std::endl;
+
+    int key = 0;
+    std::cout << "v0 minimum: " << (v0.minimum(key) ? "found" : "none") << std::endl;
+    v3.minimum(key);
+    std::cout << "v3 minimum: " << key;
+    v3.maximum(key);
+    std::cout << ", maximum: " << key << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+void test_remove()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    PersistentBinaryTree<int> tree = init_tree_std();
+    PersistentBinaryTree<int> leaf = tree.remove(175);
+    PersistentBinaryTree<int> one = tree.remove(125);
+    PersistentBinaryTree<int> root = tree.remove(100);
+    PersistentBinaryTree<int> absent = tree.remove(69);
+
+    print_version("Original", tree);
+    print_version("Without leaf 175", leaf);
+    print_version("Without one-child 125", one);
+    print_version("Without root 100", root);
+    print_version("Without absent 69", absent);
+
+    // Dropping the original must not affect the versions derived from it.
+    tree = PersistentBinaryTree<int>();
+    print_version("Without root 100, original dropped", root);
+
+    std::cout << std::endl;
+}
+
+
+void test_from_binary_tree()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    int keys[] = { 10, 20, 30, 40, 50, 60, 70 };
+    BinaryTree<int> bst;
+    bst.build_balanced(keys, 7);
+
+    PersistentBinaryTree<int> tree(bst.root());
+    print_version("Copied", tree);
+    print_version("Copied, 35 inserted", tree.insert(35));
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Sorted keys make the tree a chain as deep as it is large. Every update
+ * copies the whole path, so the chain of about a million keys is built as a
+ * BinaryTree and copied in once; the updates at its end must neither
+ * overflow the stack nor disturb the older versions.
+ */
+void test_sorted_chain()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int n = 1 << 20;
+    const int inserts = 8;
+
+    // Linked by hand: the BinaryTree methods recurse on a chain this deep.
+    std::vector<BinaryTreeNode<int> *> nodes(n);
+    for (int i = 0; i < n; i++)
+        nodes[i] = new BinaryTreeNode<int>(i);
+    for (int i = 0; i + 1 < n; i++)
+        nodes[i]->set_right(nodes[i + 1]);
+
+    PersistentBinaryTree<int> chain(nodes[0]);
+    for (int i = 0; i < n; i++)
+        delete nodes[i];
+
+    PersistentBinaryTree<int> version = chain;
+    for (int i = 0; i < inserts; i++)
+        version = version.insert(n + i);
+    PersistentBinaryTree<int> removed = version.remove(n / 2).remove(n + inserts - 1);
+
+    int count = 0;
+    int last = 0;
+    bool ok = version.dft_inorder(SortedCounter(count, last)) && count == n + inserts;
+    count = 0;
+    ok = ok && removed.dft_inorder(SortedCounter(count, last)) && count == n + inserts - 2;
+    ok = ok && !removed.search_iterative(n / 2) && removed.search_iterative(n / 2 + 1);
+    ok = ok && removed.maximum(last) && last == n + inserts - 2;
+    ok = ok && chain.maximum(last) && last == n - 1 && chain.search_iterative(n / 2);
+
+    std::cout << inserts << " sorted inserts after a chain of " << n << " keys, then 2 removes: "
+            << (ok ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Compares applying a batch of updates on a full BinaryTree::copy with
+ * creating a new persistent version per update.
+ */
+void test_snapshot_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int nodes = 100000;
+    const int updates = 200;
+
+    srand(1);
+    BinaryTree<int> bst;
+    for (int i = 0; i < nodes; i++)
+        bst.insert_iterative(new BinaryTreeNode<int>(rand()));
+
+    clock_t start = clock();
+    for (int i = 0; i < updates; i++)
+    {
+        BinaryTree<int> snapshot(bst.copy(bst.root()));
+        snapshot.insert_iterative(new BinaryTreeNode<int>(rand()));
+    }
+    double copy_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    PersistentBinaryTree<int> version(bst.root());
+    start = clock();
+    for (int i = 0; i < updates; i++)
+    {
+        PersistentBinaryTree<int> snapshot = version;
+        version = version.insert(rand());
+    }
+    double persistent_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << nodes << " nodes, " << updates << " snapshot+update rounds" << std::endl;
+    std::cout << "BinaryTree::copy:     " << copy_secs << "s" << std::endl;
+    std::cout << "Persistent versions:  " << persistent_secs << "s" << std::endl;
+
+    std::cout << std::endl;
+}
@@ -0,0 +1,15 @@
+/**
+ * @class SuccinctBinaryTree
+ *
+ * @file succinctbinarytree.cpp
+ *
+ * @brief Succinct, pointer-free binary tree encoding and read-only view
+ * class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "succinctbinarytree.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,578 @@
+#ifndef SUCCINCTBINARYTREE_H_
+#define SUCCINCTBINARYTREE_H_
+
+#include "../binarytree/binarytreenode.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <queue>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @class SuccinctBinaryTree
+ *
+ * @file succinctbinarytree.h
+ *
+ * @brief Succinct, pointer-free binary tree encoding and read-only view.
+ *
+ * <p>
+ * A pointer-based tree cannot be written to disk as is, and holds two or
+ * three pointers per key in memory. This class writes a binary tree in a
+ * pointer-free format and navigates the written form in place, typically
+ * straight out of a memory-mapped file, so that reopening a saved tree costs
+ * one <code>mmap</code> call and no parsing or allocation at all; pages are
+ * brought in by the operating system as the tree is walked.
+ *
+ * The format follows Jacobson's level-order encoding. The nodes are numbered
+ * 0, 1, ... in level order (breadth first) and their keys stored in a
+ * contiguous array in that order. The shape of the tree is a bitstring of 2n
+ * bits: bits 2i and 2i + 1 tell whether node i has a left and a right child.
+ * Since the children are numbered in the same order as the 1 bits that
+ * announce them, the child whose bit is at position p is node rank(p) + 1,
+ * rank(p) being the number of 1 bits before position p (the root is the
+ * only node not announced by a bit). A small directory of precomputed
+ * ranks, one per 512 bits, reduces rank to a lookup and a few population
+ * counts, so each step down the tree takes O(1) time. The shape and the
+ * directory add about 2.25 bits per node to the keys, instead of the 128 or
+ * more bits of the child and parent pointers.
+ *
+ * A level-order layout is used rather than a preorder one, because moving
+ * to a child in preorder also needs select queries or a balanced
+ * parentheses index; here rank is enough.
+ *
+ * The key type has to be trivially copyable, since keys are written and
+ * read as raw bytes; a file can only be read on a machine of the same
+ * endianness.
+ *
+ * The file consists of a header, the shape words, the rank directory and
+ * the keys, each section starting at an offset that is a multiple of 8.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class SuccinctBinaryTree {
+public:
+    /**
+     * Default constructor. Creates a view of nothing.
+     */
+    SuccinctBinaryTree();
+
+    /**
+     * Destructor. Unmaps the file, if any.
+     */
+    virtual ~SuccinctBinaryTree();
+
+    // -- getter methods
+
+    /**
+     * Getter for the number of nodes.
+     *
+     * @return
+     *     The number of nodes in the tree viewed.
+     */
+    int64_t size() const;
+
+    /**
+     * Getter for the root node.
+     *
+     * @return
+     *     The number of the root node; -1 for an empty tree.
+     */
+    int64_t root() const;
+
+    /**
+     * Getter for a node's left child.
+     *
+     * @param[in] node
+     *     The number of a node.
+     *
+     * @return
+     *     The number of the left child of the node; -1 if it has none.
+     */
+    int64_t left(int64_t node) const;
+
+    /**
+     * Getter for a node's right child.
+     *
+     * @param[in] node
+     *     The number of a node.
+     *
+     * @return
+     *     The number of the right child of the node; -1 if it has none.
+     */
+    int64_t right(int64_t node) const;
+
+    /**
+     * Getter for a node's key.
+     *
+     * @param[in] node
+     *     The number of a node.
+     *
+     * @return
+     *     The key of the node.
+     */
+    const T & key(int64_t node) const;
+
+    // -- public methods
+
+    /**
+     * Writes a binary tree to a file in the succinct format. Takes Θ(n)
+     * time and O(w) memory besides the shape, w being the width of the tree.
+     *
+     * @param[in] root
+     *     The root node of the tree to write.
+     * @param[in] path
+     *     The path of the file to create.
+     *
+     * @return
+     *     <code>true</code> on success; <code>false</code> if the file could
+     *     not be written.
+     */
+    static bool write(BinaryTreeNode<T> * root, const char * path);
+
+    /**
+     * Maps a file written by <code>write</code> into memory, read only, and
+     * views it. Takes O(1) time; nothing is read until it is needed.
+     *
+     * @param[in] path
+     *     The path of the file.
+     *
+     * @return
+     *     <code>true</code> on success; <code>false</code> if the file could
+     *     not be mapped or is not in the expected format.
+     */
+    bool open(const char * path);
+
+    /**
+     * Views a buffer holding the contents of a file written by
+     * <code>write</code>. The buffer has to be aligned to 8 bytes and stay
+     * alive while it is viewed.
+     *
+     * @param[in] data
+     *     The buffer.
+     * @param[in] bytes
+     *     The size of the buffer.
+     *
+     * @return
+     *     <code>true</code> on success; <code>false</code> if the buffer is
+     *     not in the expected format.
+     */
+    bool view(const void * data, size_t bytes);
+
+    /**
+     * Stops viewing, unmapping the file if one was mapped.
+     */
+    void close();
+
+    /**
+     * Iterative lookup of a key, in search tree order. Takes O(h) time, on a
+     * tree of height h.
+     *
+     * @param[in] key
+     *     The key to search.
+     *
+     * @return
+     *     The number of the node holding the key; -1 if there is none.
+     */
+    int64_t search_iterative(T key) const;
+protected:
+private:
+    /**
+     * Copy constructor; a view owns the mapping of its file.
+     */
+    SuccinctBinaryTree(const SuccinctBinaryTree<T> & other);
+
+    /**
+     * Assignment operator; a view owns the mapping of its file.
+     */
+    SuccinctBinaryTree<T> & operator=(const SuccinctBinaryTree<T> & other);
+
+    /**
+     * The header of the format.
+     */
+    struct Header
+    {
+        char magic[8];
+        uint32_t key_size;
+        uint32_t reserved;
+        uint64_t nodes;
+        uint64_t shape_offset;
+        uint64_t rank_offset;
+        uint64_t key_offset;
+        uint64_t bytes;
+    };
+
+    /**
+     * The number of shape bits covered by each entry of the rank directory.
+     */
+    static const int RANK_BLOCK_BITS = 512;
+
+    /**
+     * Number of 1 bits in a word.
+     */
+    static int popcount(uint64_t word);
+
+    /**
+     * Number of 1 bits of the shape before a position.
+     *
+     * @param[in] position
+     *     A bit position.
+     *
+     * @return
+     *     The number of 1 bits in positions [0, position).
+     */
+    uint64_t rank(uint64_t position) const;
+
+    /**
+     * The child announced by a shape bit.
+     *
+     * @param[in] position
+     *     The position of the bit.
+     *
+     * @return
+     *     The number of the child; -1 if the bit is 0.
+     */
+    int64_t child(uint64_t position) const;
+
+    /**
+     * Writes a section of bytes, padded to a multiple of 8.
+     */
+    static bool write_padded(std::FILE * file, const void * data, size_t bytes);
+
+    /**
+     * The number of nodes.
+     */
+    int64_t m_nodes;
+
+    /**
+     * The shape bits, 64 to a word, least significant bit first.
+     */
+    const uint64_t * m_shape;
+
+    /**
+     * The number of 1 bits before each block of the shape.
+     */
+    const uint64_t * m_ranks;
+
+    /**
+     * The keys, in level order.
+     */
+    const T * m_keys;
+
+    /**
+     * The mapped file; <code>null</code> if none.
+     */
+    void * m_map;
+
+    /**
+     * The size of the mapped file.
+     */
+    size_t m_map_bytes;
+};
+
+
+template<class T>
+SuccinctBinaryTree<T>::SuccinctBinaryTree()
+    : m_nodes(0), m_shape(0), m_ranks(0), m_keys(0), m_map(0), m_map_bytes(0)
+{
+}
+
+
+template<class T>
+SuccinctBinaryTree<T>::~SuccinctBinaryTree()
+{
+    close();
+}
+
+
+template<class T>
+int64_t SuccinctBinaryTree<T>::size() const
+{
+    return m_nodes;
+}
+
+
+template<class T>
+int64_t SuccinctBinaryTree<T>::root() const
+{
+    return m_nodes > 0 ? 0 : -1;
+}
+
+
+template<class T>
+int64_t SuccinctBinaryTree<T>::left(int64_t node) const
+{
+    return child(2 * (uint64_t) node);
+}
+
+
+template<class T>
+int64_t SuccinctBinaryTree<T>::right(int64_t node) const
+{
+    return child(2 * (uint64_t) node + 1);
+}
+
+
+template<class T>
+const T & SuccinctBinaryTree<T>::key(int64_t node) const
+{
+    return m_keys[node];
+}
+
+
+template<class T>
+bool SuccinctBinaryTree<T>::write(BinaryTreeNode<T> * root, const char * path)
+{
+    std::FILE * file = std::fopen(path, "wb");
+    if (file == 0)
+        return false;
+
+    // The header is rewritten once the sizes are known.
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // First pass: the shape, written out word by word, while the rank
+    // directory is collected.
+    std::vector<uint64_t> ranks;
+    uint64_t ones = 0;
+    uint64_t word = 0;
+    uint64_t bits = 0;
+    uint64_t nodes = 0;
+    std::queue<BinaryTreeNode<T> *> queue;
+    if (root != 0)
+        queue.push(root);
+
+    while (!queue.empty())
+    {
+        BinaryTreeNode<T> * node = queue.front();
+        queue.pop();
+        nodes++;
+
+        BinaryTreeNode<T> * children[2] = { node->left(), node->right() };
+        for (int c = 0; c < 2; c++)
+        {
+            if (bits % RANK_BLOCK_BITS == 0)
+                ranks.push_back(ones);
+            if (children[c] != 0)
+            {
+                word |= (uint64_t) 1 << (bits % 64);
+                ones++;
+                queue.push(children[c]);
+            }
+            if (++bits % 64 == 0)
+            {
+                ok = ok && std::fwrite(&word, sizeof(word), 1, file) == 1;
+                word = 0;
+            }
+        }
+    }
+    if (bits % 64 != 0)
+        ok = ok && std::fwrite(&word, sizeof(word), 1, file) == 1;
+    ranks.push_back(ones);
+
+    header.shape_offset = sizeof(header);
+    header.rank_offset = header.shape_offset + (bits + 63) / 64 * sizeof(uint64_t);
+    ok = ok && write_padded(file, &ranks[0], ranks.size() * sizeof(uint64_t));
+    header.key_offset = header.rank_offset + ranks.size() * sizeof(uint64_t);
+
+    // Second pass: the keys, in the same order.
+    if (root != 0)
+        queue.push(root);
+    while (!queue.empty())
+    {
+        BinaryTreeNode<T> * node = queue.front();
+        queue.pop();
+
+        T key = node->key();
+        ok = ok && std::fwrite(&key, sizeof(T), 1, file) == 1;
+
+        if (node->left())
+            queue.push(node->left());
+        if (node->right())
+            queue.push(node->right());
+    }
+    ok = ok && write_padded(file, 0, nodes * sizeof(T));
+
+    std::memcpy(header.magic, "SBTREE1", 8);
+    header.key_size = sizeof(T);
+    header.nodes = nodes;
+    header.bytes = header.key_offset + (nodes * sizeof(T) + 7) / 8 * 8;
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0;
+    ok = ok && std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+    return std::fclose(file) == 0 && ok;
+}
+
+
+template<class T>
+bool SuccinctBinaryTree<T>::open(const char * path)
+{
+    close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(Header))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void * map = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping outlives the descriptor.
+    ::close(fd);
+    if (map == MAP_FAILED)
+        return false;
+
+    if (!view(map, st.st_size))
+    {
+        munmap(map, st.st_size);
+        return false;
+    }
+
+    m_map = map;
+    m_map_bytes = st.st_size;
+    return true;
+}
+
+
+template<class T>
+bool SuccinctBinaryTree<T>::view(const void * data, size_t bytes)
+{
+    if (data != m_map)
+        close();
+
+    Header header;
+    if (bytes < sizeof(header))
+        return false;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, "SBTREE1", 8) != 0
+            || header.key_size != sizeof(T)
+            || header.bytes > bytes)
+        return false;
+
+    // The sections have to come in order, aligned, within the buffer. The
+    // node count is bounded by the key section before anything is computed
+    // from it, so that none of the sizes below can overflow.
+    if (header.shape_offset < sizeof(header)
+            || header.shape_offset > header.rank_offset
+            || header.rank_offset > header.key_offset
+            || header.key_offset > header.bytes
+            || (header.shape_offset | header.rank_offset | header.key_offset) % 8 != 0
+            || header.nodes > (header.bytes - header.key_offset) / sizeof(T))
+        return false;
+
+    uint64_t bits = 2 * header.nodes;
+    uint64_t shape_words = (bits + 63) / 64;
+    uint64_t rank_entries = (bits + RANK_BLOCK_BITS - 1) / RANK_BLOCK_BITS + 1;
+    if (shape_words > (header.rank_offset - header.shape_offset) / sizeof(uint64_t)
+            || rank_entries > (header.key_offset - header.rank_offset) / sizeof(uint64_t))
+        return false;
+
+    const char * base = static_cast<const char *>(data);
+    m_nodes = (int64_t) header.nodes;
+    m_shape = reinterpret_cast<const uint64_t *>(base + header.shape_offset);
+    m_ranks = reinterpret_cast<const uint64_t *>(base + header.rank_offset);
+    m_keys = reinterpret_cast<const T *>(base + header.key_offset);
+
+    return true;
+}
+
+
+template<class T>
+void SuccinctBinaryTree<T>::close()
+{
+    if (m_map != 0)
+        munmap(m_map, m_map_bytes);
+
+    m_map = 0;
+    m_map_bytes = 0;
+    m_nodes = 0;
+    m_shape = 0;
+    m_ranks = 0;
+    m_keys = 0;
+}
+
+
+template<class T>
+int64_t SuccinctBinaryTree<T>::search_iterative(T key) const
+{
+    int64_t node = root();
+
+    while (node >= 0 && m_keys[node] != key) {
+        if (m_keys[node] > key)
+            node = left(node);
+        else
+            node = right(node);
+    }
+
+    return node;
+}
+
+
+template<class T>
+int SuccinctBinaryTree<T>::popcount(uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word != 0; word &= word - 1)
+        count++;
+    return count;
+#endif
+}
+
+
+template<class T>
+uint64_t SuccinctBinaryTree<T>::rank(uint64_t position) const
+{
+    uint64_t block = position / RANK_BLOCK_BITS;
+    uint64_t count = m_ranks[block];
+
+    uint64_t w = block * (RANK_BLOCK_BITS / 64);
+    for (; w < position / 64; w++)
+        count += popcount(m_shape[w]);
+
+    if (position % 64 != 0)
+        count += popcount(m_shape[w] & (((uint64_t) 1 << (position % 64)) - 1));
+
+    return count;
+}
+
+
+template<class T>
+int64_t SuccinctBinaryTree<T>::child(uint64_t position) const
+{
+    if ((m_shape[position / 64] >> (position % 64) & 1) == 0)
+        return -1;
+
+    return (int64_t) rank(position) + 1;
+}
+
+
+template<class T>
+bool SuccinctBinaryTree<T>::write_padded(std::FILE * file, const void * data, size_t bytes)
+{
+    if (data != 0 && bytes > 0 && std::fwrite(data, 1, bytes, file) != bytes)
+        return false;
+
+    static const char zeros[8] = { 0 };
+    size_t padding = (8 - bytes % 8) % 8;
+
+    return padding == 0 || std::fwrite(zeros, 1, padding, file) == padding;
+}
+
+#endif /* SUCCINCTBINARYTREE_H_ */
@@ -0,0 +1,285 @@
+/**
+ * @file succinctbinarytree_test.cpp
+ *
+ * @brief Test unit for the succinct binary tree class.
+ *
+ * @see succinctbinarytree.h succinctbinarytree.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "succinctbinarytree.h"
+#include "../binarytree/binarytree.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+void test_write_open();
+void test_view_buffer();
+void test_view_corrupted();
+void test_empty();
+void test_restart_timing();
+
+int main (int argc, char** argv)
+{
+    test_write_open();
+    test_view_buffer();
+    test_view_corrupted();
+    test_empty();
+    test_restart_timing();
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+BinaryTree<int> * init_tree_std()
+{
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    int keys[] = { 100, 50, 150, 25, 75, 125, 175, 110 };
+
+    for (int i = 0; i < 8; i++)
+        bst->insert_iterative(new BinaryTreeNode<int>(keys[i]));
+
+    return bst;
+}
+
+
+/**
+ * Prints a subtree of the view in preorder, with parentheses around the
+ * children of each node.
+ */
+void print_shape(const SuccinctBinaryTree<int> & tree, int64_t node)
+{
+    if (node < 0)
+    {
+        std::cout << "-";
+        return;
+    }
+
+    std::cout << tree.key(node);
+    if (tree.left(node) >= 0 || tree.right(node) >= 0)
+    {
+        std::cout << "(";
+        print_shape(tree, tree.left(node));
+        std::cout << " ";
+        print_shape(tree, tree.right(node));
+        std::cout << ")";
+    }
+}
+
+
+// test functions
+
+
+void test_write_open()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    const char * path = "succinctbinarytree_test.bin";
+
+    std::cout << "Write: " << (SuccinctBinaryTree<int>::write(bst->root(), path) ? "ok" : "failed") << std::endl;
+
+    SuccinctBinaryTree<int> tree;
+    std::cout << "Open: " << (tree.open(path) ? "ok" : "failed") << std::endl;
+    std::cout << "Size: " << tree.size() << std::endl;
+    std::cout << "Level order:";
+    for (int64_t i = 0; i < tree.size(); i++)
+        std::cout << " " << tree.key(i);
+    std::cout << std::endl;
+    std::cout << "Shape: ";
+    print_shape(tree, tree.root());
+    std::cout << std::endl;
+
+    std::cout << "Search 110: " << (tree.search_iterative(110) >= 0 ? "found" : "not found") << std::endl;
+    std::cout << "Search 111: " << (tree.search_iterative(111) >= 0 ? "found" : "not found") << std::endl;
+
+    SuccinctBinaryTree<long> wrong;
+    std::cout << "Open with another key type: " << (wrong.open(path) ? "ok" : "rejected") << std::endl;
+
+    tree.close();
+    std::remove(path);
+    delete bst;
+    std::cout << std::endl;
+}
+
+
+void test_view_buffer()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    const char * path = "succinctbinarytree_test.bin";
+    SuccinctBinaryTree<int>::write(bst->root(), path);
+
+    // Read the whole file into an 8-byte aligned buffer.
+    std::FILE * file = std::fopen(path, "rb");
+    std::vector<uint64_t> buffer(1024);
+    size_t bytes = std::fread(&buffer[0], 1, buffer.size() * sizeof(uint64_t), file);
+    std::fclose(file);
+    std::remove(path);
+
+    SuccinctBinaryTree<int> tree;
+    std::cout << "View: " << (tree.view(&buffer[0], bytes) ? "ok" : "failed") << std::endl;
+    std::cout << "Shape: ";
+    print_shape(tree, tree.root());
+    std::cout << std::endl;
+
+    std::cout << "View truncated: " << (tree.view(&buffer[0], bytes - 8) ? "ok" : "rejected") << std::endl;
+
+    delete bst;
+    std::cout << std::endl;
+}
+
+
+/**
+ * Corrupts the node count and the section offsets of the header, one at a
+ * time; the view must reject every buffer.
+ */
+void test_view_corrupted()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = init_tree_std();
+    const char * path = "succinctbinarytree_test.bin";
+    SuccinctBinaryTree<int>::write(bst->root(), path);
+
+    std::FILE * file = std::fopen(path, "rb");
+    std::vector<uint64_t> buffer(1024);
+    size_t bytes = std::fread(&buffer[0], 1, buffer.size() * sizeof(uint64_t), file);
+    std::fclose(file);
+    std::remove(path);
+
+    // The header words after the magic and the key size: the node count,
+    // then the shape, rank and key offsets, then the size.
+    const char * names[] = {
+        "node count wrapping around",
+        "shape section overlapping the ranks",
+        "rank section overlapping the keys",
+        "key section past the end",
+        "misaligned shape section"
+    };
+    int words[] = { 2, 4, 5, 5, 3 };
+    uint64_t values[] = {
+        (uint64_t) 1 << 62,
+        buffer[3],
+        buffer[4] + 8,
+        bytes + 8,
+        buffer[3] + 4
+    };
+
+    SuccinctBinaryTree<int> tree;
+    for (int i = 0; i < 5; i++)
+    {
+        std::vector<uint64_t> corrupted(buffer);
+        corrupted[words[i]] = values[i];
+        std::cout << "View with " << names[i] << ": "
+                << (tree.view(&corrupted[0], bytes) ? "ok (WRONG)" : "rejected") << std::endl;
+    }
+    std::cout << "View intact: " << (tree.view(&buffer[0], bytes) ? "ok" : "rejected (WRONG)") << std::endl;
+
+    delete bst;
+    std::cout << std::endl;
+}
+
+
+void test_empty()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const char * path = "succinctbinarytree_test.bin";
+    SuccinctBinaryTree<int>::write(0, path);
+
+    SuccinctBinaryTree<int> tree;
+    std::cout << "Open: " << (tree.open(path) ? "ok" : "failed") << std::endl;
+    std::cout << "Size " << tree.size() << ", root " << tree.root()
+            << ", search 1: " << tree.search_iterative(1) << std::endl;
+
+    tree.close();
+    std::remove(path);
+    std::cout << std::endl;
+}
+
+
+/**
+ * Compares rebuilding a random tree from its keys with writing it once and
+ * mapping it back, and lookups in both.
+ */
+void test_restart_timing()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int nodes = 1 << 20;
+    const int lookups = 1 << 20;
+    const char * path = "succinctbinarytree_test.bin";
+
+    srand(3);
+    std::vector<int> keys(nodes);
+    for (int i = 0; i < nodes; i++)
+        keys[i] = rand();
+
+    clock_t start = clock();
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    for (int i = 0; i < nodes; i++)
+        bst->insert_iterative(new BinaryTreeNode<int>(keys[i]));
+    double rebuild_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    SuccinctBinaryTree<int>::write(bst->root(), path);
+    double write_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    SuccinctBinaryTree<int> tree;
+    start = clock();
+    tree.open(path);
+    double open_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    long pointer_found = 0;
+    start = clock();
+    for (int i = 0; i < lookups; i++)
+        if (bst->search_iterative(bst->root(), keys[(long) i * 7919 % nodes] + i % 2))
+            pointer_found++;
+    double pointer_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    long succinct_found = 0;
+    start = clock();
+    for (int i = 0; i < lookups; i++)
+        if (tree.search_iterative(keys[(long) i * 7919 % nodes] + i % 2) >= 0)
+            succinct_found++;
+    double succinct_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+    std::FILE * file = std::fopen(path, "rb");
+    std::fseek(file, 0, SEEK_END);
+    long bytes = std::ftell(file);
+    std::fclose(file);
+
+    std::cout << nodes << " nodes" << std::endl;
+    std::cout << "Rebuild by insertion: " << rebuild_secs << "s, "
+            << (long) nodes * sizeof(BinaryTreeNode<int>) << " bytes of nodes" << std::endl;
+    std::cout << "Write: " << write_secs << "s, open: " << open_secs << "s, "
+            << bytes << " bytes on disk" << std::endl;
+    std::cout << "Lookups: pointer tree " << pointer_secs << "s, succinct view "
+            << succinct_secs << "s (" << (pointer_found == succinct_found ? "same" : "DIFFERENT")
+            << " results)" << std::endl;
+
+    tree.close();
+    std::remove(path);
+    delete bst;
+    std::cout << std::endl;
+}
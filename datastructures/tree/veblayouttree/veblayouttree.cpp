@@ -0,0 +1,14 @@
+/**
+ * @class VebLayoutTree
+ *
+ * @file veblayouttree.cpp
+ *
+ * @brief Static search tree in van Emde Boas layout class implementation.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "veblayouttree.h"
+
+// Empty due to template implementation.
@@ -0,0 +1,628 @@
+#ifndef VEBLAYOUTTREE_H_
+#define VEBLAYOUTTREE_H_
+
+#include "../binarytree/binarytreenode.h"
+
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * @class VebLayoutTree
+ *
+ * @file veblayouttree.h
+ *
+ * @brief Static search tree in van Emde Boas layout class definition.
+ *
+ * <p>
+ * A read-only search tree whose nodes are laid out in a single array in the
+ * <em>van Emde Boas</em> order (Prokop, 1999). A tree of height h is cut at
+ * half its height into a top tree and 2<sup>h/2</sup> bottom trees; the top
+ * tree is laid out first, then the bottom trees one after the other, each
+ * of them recursively in the same way. Whatever the size B of a cache line
+ * (or of a page, or of any other block of the memory hierarchy), some level
+ * of the recursion produces subtrees that fit in a block, and a root to
+ * leaf path crosses O(log<sub>B</sub> n) of them. A search therefore touches
+ * O(log<sub>B</sub> n) blocks at every level of the hierarchy at once,
+ * without knowing its parameters, whereas a pointer-based tree touches
+ * roughly one block per level of the tree.
+ *
+ * The tree is complete: the keys fill a perfect tree of height
+ * &lceil;log(n + 1)&rceil; in order, and the slots past the last key are
+ * padded with copies of the maximum key. There are no child pointers; the
+ * position of a child is computed from the position of its ancestors with
+ * the per-depth tables of Brodal, Fagerberg and Jacob (<em>Cache Oblivious
+ * Search Trees via Binary Trees of Small Height</em>, 2002). For every depth
+ * d they record the depth D[d] of the root of the top tree in which nodes of
+ * depth d are roots of bottom trees, the size T[d] of that top tree and the
+ * size B[d] of its bottom trees. Keeping the positions of the nodes on the
+ * current path in a small array, the position of a child with breadth-first
+ * index i (the root having index 1) at depth d is
+ * <code>pos[D[d]] + T[d] + (i &amp; T[d]) * B[d]</code>.
+ *
+ * The tree is built once, from a BinaryTree or a sorted sequence, in Θ(n)
+ * time and is never modified.
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+template<class T>
+class VebLayoutTree {
+public:
+    /**
+     * The maximum height of the tree.
+     */
+    static const int MAX_HEIGHT = 48;
+
+    /**
+     * @class Iterator
+     *
+     * @brief In-order iterator over the keys of the tree.
+     *
+     * Keeps the path from the root to the current node, so that moving to
+     * the successor takes O(1) amortized time and mostly touches blocks that
+     * the previous steps have already brought in.
+     */
+    class Iterator {
+    public:
+        /**
+         * Getter for the key of the current node.
+         *
+         * @return
+         *     The key.
+         */
+        const T & key() const;
+
+        /**
+         * Getter for the position of the current key in sorted order.
+         *
+         * @return
+         *     The rank of the key, counting from 0; the size of the tree at
+         *     the end.
+         */
+        int64_t rank() const;
+
+        /**
+         * Moves to the next key in order.
+         */
+        void next();
+
+        /**
+         * Checks if the iterator has gone past the last key.
+         *
+         * @return
+         *     <code>true</code> at the end; <code>false</code> otherwise.
+         */
+        bool end() const;
+    private:
+        friend class VebLayoutTree<T>;
+
+        /**
+         * The tree iterated.
+         */
+        const VebLayoutTree<T> * m_tree;
+
+        /**
+         * The depth of the current node.
+         */
+        int m_depth;
+
+        /**
+         * The breadth-first index of the current node.
+         */
+        uint64_t m_index;
+
+        /**
+         * The positions in the layout of the nodes on the path from the root
+         * to the current node, by depth.
+         */
+        int64_t m_path[MAX_HEIGHT];
+    };
+
+    /**
+     * Default constructor. Creates an empty tree.
+     */
+    VebLayoutTree();
+
+    /**
+     * Constructor. Freezes the keys of a binary search tree.
+     *
+     * @param[in] root
+     *     The root node of the binary search tree.
+     */
+    explicit VebLayoutTree(BinaryTreeNode<T> * root);
+
+    /**
+     * Destructor.
+     */
+    virtual ~VebLayoutTree();
+
+    // -- getter methods
+
+    /**
+     * Getter for the number of keys.
+     *
+     * @return
+     *     The number of keys in the tree.
+     */
+    int64_t size() const;
+
+    /**
+     * Getter for the height of the tree.
+     *
+     * @return
+     *     The number of levels of the tree.
+     */
+    int height() const;
+
+    // -- public methods
+
+    /**
+     * Rebuilds the tree out of the keys of a binary search tree, visited in
+     * order. Takes Θ(n) time.
+     *
+     * @param[in] root
+     *     The root node of the binary search tree.
+     */
+    void build(BinaryTreeNode<T> * root);
+
+    /**
+     * Rebuilds the tree out of sorted keys. Takes Θ(n) time.
+     *
+     * @param[in] first
+     *     Iterator to the first key.
+     * @param[in] last
+     *     Iterator past the last key.
+     */
+    template<class InputIterator>
+    void build(InputIterator first, InputIterator last);
+
+    /**
+     * Lookup of a key. Takes O(log n) time and O(log<sub>B</sub> n) block
+     * transfers.
+     *
+     * @param[in] key
+     *     The key to search.
+     *
+     * @return
+     *     <code>true</code> if the key is present; <code>false</code>
+     *     otherwise.
+     */
+    bool search(T key) const;
+
+    /**
+     * Finds the first key that is not less than a given key. Takes O(log n)
+     * time.
+     *
+     * @param[in] key
+     *     The key to search.
+     *
+     * @return
+     *     An iterator at the first key not less than the given key; at the
+     *     end if there is none.
+     */
+    Iterator lower_bound(T key) const;
+
+    /**
+     * An iterator at the smallest key.
+     *
+     * @return
+     *     An iterator at the smallest key; at the end for an empty tree.
+     */
+    Iterator begin() const;
+
+    /**
+     * In-order scan of the keys in a range, handing each to a visitor.
+     *
+     * The visitor takes a key and returns <code>false</code> to stop the
+     * scan.
+     *
+     * @param[in] lo
+     *     The lower end of the range, inclusive.
+     * @param[in] hi
+     *     The upper end of the range, inclusive.
+     * @param[in] visit
+     *     The visitor to call on each key.
+     *
+     * @return
+     *     The number of keys visited.
+     */
+    template<class Visitor>
+    int64_t scan(T lo, T hi, Visitor visit) const;
+protected:
+private:
+    /**
+     * Fills in the layout tables for a (sub)tree split recursively.
+     *
+     * @param[in] depth
+     *     The depth of the root of the (sub)tree.
+     * @param[in] levels
+     *     The height of the (sub)tree.
+     */
+    void prepare(int depth, int levels);
+
+    /**
+     * Position in the layout of a child of the deepest node on a path.
+     *
+     * @param[in] path
+     *     The positions of the nodes on the path, by depth.
+     * @param[in] depth
+     *     The depth of the child.
+     * @param[in] index
+     *     The breadth-first index of the child.
+     *
+     * @return
+     *     The position of the child.
+     */
+    int64_t position(const int64_t * path, int depth, uint64_t index) const;
+
+    /**
+     * Places sorted keys in order in a subtree, computing the positions of
+     * its nodes on the way down.
+     *
+     * @param[in,out] it
+     *     Iterator to the next key to place.
+     * @param[in] depth
+     *     The depth of the root of the subtree.
+     * @param[in] index
+     *     The breadth-first index of the root of the subtree.
+     * @param[in,out] path
+     *     The positions of the ancestors of the subtree, by depth.
+     */
+    template<class InputIterator>
+    void place(InputIterator & it, int depth, uint64_t index, int64_t * path);
+
+    /**
+     * Rank of a node, from its depth and breadth-first index.
+     */
+    int64_t rank_of(int depth, uint64_t index) const;
+
+    /**
+     * The number of keys.
+     */
+    int64_t m_size;
+
+    /**
+     * The height of the perfect tree.
+     */
+    int m_height;
+
+    /**
+     * The keys in van Emde Boas order, padded with the maximum key.
+     */
+    std::vector<T> m_keys;
+
+    /**
+     * Per depth: the size of the top tree whose bottom trees are rooted at
+     * that depth.
+     */
+    int64_t m_top[MAX_HEIGHT];
+
+    /**
+     * Per depth: the size of the bottom trees rooted at that depth.
+     */
+    int64_t m_bottom[MAX_HEIGHT];
+
+    /**
+     * Per depth: the depth of the root of the top tree whose bottom trees
+     * are rooted at that depth.
+     */
+    int m_top_depth[MAX_HEIGHT];
+};
+
+
+template<class T>
+VebLayoutTree<T>::VebLayoutTree()
+    : m_size(0), m_height(0)
+{
+}
+
+
+template<class T>
+VebLayoutTree<T>::VebLayoutTree(BinaryTreeNode<T> * root)
+    : m_size(0), m_height(0)
+{
+    build(root);
+}
+
+
+template<class T>
+VebLayoutTree<T>::~VebLayoutTree()
+{
+}
+
+
+template<class T>
+int64_t VebLayoutTree<T>::size() const
+{
+    return m_size;
+}
+
+
+template<class T>
+int VebLayoutTree<T>::height() const
+{
+    return m_height;
+}
+
+
+template<class T>
+void VebLayoutTree<T>::build(BinaryTreeNode<T> * root)
+{
+    // Collect the keys in order with an explicit stack, as in
+    // BinaryTree::dft_inorder_iterative.
+    std::vector<T> sorted;
+    std::vector<BinaryTreeNode<T> *> st;
+    BinaryTreeNode<T> * node = root;
+
+    while (node || !st.empty())
+    {
+        if (node)
+        {
+            st.push_back(node);
+            node = node->left();
+        }
+        else
+        {
+            node = st.back();
+            st.pop_back();
+            sorted.push_back(node->key());
+            node = node->right();
+        }
+    }
+
+    build(sorted.begin(), sorted.end());
+}
+
+
+template<class T>
+template<class InputIterator>
+void VebLayoutTree<T>::build(InputIterator first, InputIterator last)
+{
+    std::vector<T> sorted(first, last);
+
+    m_size = (int64_t) sorted.size();
+    m_height = 0;
+    while (m_height < MAX_HEIGHT - 1 && ((int64_t) 1 << m_height) - 1 < m_size)
+        m_height++;
+
+    m_keys.clear();
+    if (m_size == 0)
+        return;
+
+    prepare(0, m_height);
+
+    // Pad with the maximum key, so that the padding sorts after every key.
+    sorted.resize(((int64_t) 1 << m_height) - 1, sorted.back());
+    m_keys.resize(sorted.size());
+
+    typename std::vector<T>::const_iterator it = sorted.begin();
+    int64_t path[MAX_HEIGHT];
+    path[0] = 0;
+    place(it, 0, 1, path);
+}
+
+
+template<class T>
+void VebLayoutTree<T>::prepare(int depth, int levels)
+{
+    if (levels <= 1)
+        return;
+
+    int top = levels / 2;
+    int bottom = levels - top;
+
+    m_top_depth[depth + top] = depth;
+    m_top[depth + top] = ((int64_t) 1 << top) - 1;
+    m_bottom[depth + top] = ((int64_t) 1 << bottom) - 1;
+
+    prepare(depth, top);
+    prepare(depth + top, bottom);
+}
+
+
+template<class T>
+int64_t VebLayoutTree<T>::position(const int64_t * path, int depth, uint64_t index) const
+{
+    return path[m_top_depth[depth]] + m_top[depth]
+            + (int64_t) (index & (uint64_t) m_top[depth]) * m_bottom[depth];
+}
+
+
+template<class T>
+template<class InputIterator>
+void VebLayoutTree<T>::place(InputIterator & it, int depth, uint64_t index,
+        int64_t * path)
+{
+    if (depth > 0)
+        path[depth] = position(path, depth, index);
+
+    if (depth + 1 < m_height)
+        place(it, depth + 1, 2 * index, path);
+
+    m_keys[path[depth]] = *it;
+    ++it;
+
+    if (depth + 1 < m_height)
+        place(it, depth + 1, 2 * index + 1, path);
+}
+
+
+template<class T>
+int64_t VebLayoutTree<T>::rank_of(int depth, uint64_t index) const
+{
+    // The j-th node of a level of a perfect tree has (2j + 1) 2^(h-d-1) - 1
+    // nodes before it in order.
+    uint64_t j = index - ((uint64_t) 1 << depth);
+
+    return (int64_t) (((2 * j + 1) << (m_height - depth - 1)) - 1);
+}
+
+
+template<class T>
+bool VebLayoutTree<T>::search(T key) const
+{
+    if (m_size == 0)
+        return false;
+
+    int64_t path[MAX_HEIGHT];
+    uint64_t index = 1;
+    path[0] = 0;
+
+    for (int depth = 0; ; depth++)
+    {
+        const T & k = m_keys[path[depth]];
+        if (k == key)
+            return true;
+        if (depth + 1 == m_height)
+            return false;
+
+        index = 2 * index + (k < key ? 1 : 0);
+        path[depth + 1] = position(path, depth + 1, index);
+    }
+}
+
+
+template<class T>
+typename VebLayoutTree<T>::Iterator VebLayoutTree<T>::lower_bound(T key) const
+{
+    Iterator result;
+    result.m_tree = this;
+    result.m_depth = -1;
+    result.m_index = 0;
+
+    if (m_size == 0)
+        return result;
+
+    // Descend to a leaf, remembering the deepest node whose key is not less
+    // than the given key: that node is the answer.
+    int64_t path[MAX_HEIGHT];
+    uint64_t index = 1;
+    path[0] = 0;
+
+    for (int depth = 0; ; depth++)
+    {
+        bool right = m_keys[path[depth]] < key;
+        if (!right)
+        {
+            result.m_depth = depth;
+            result.m_index = index;
+        }
+        if (depth + 1 == m_height)
+            break;
+
+        index = 2 * index + (right ? 1 : 0);
+        path[depth + 1] = position(path, depth + 1, index);
+    }
+
+    if (result.m_depth >= 0)
+    {
+        for (int d = 0; d <= result.m_depth; d++)
+            result.m_path[d] = path[d];
+        // Padding copies of the maximum are not keys.
+        if (result.rank() >= m_size)
+            result.m_depth = -1;
+    }
+
+    return result;
+}
+
+
+template<class T>
+typename VebLayoutTree<T>::Iterator VebLayoutTree<T>::begin() const
+{
+    Iterator result;
+    result.m_tree = this;
+    result.m_depth = -1;
+    result.m_index = 0;
+
+    if (m_size == 0)
+        return result;
+
+    result.m_path[0] = 0;
+    result.m_index = 1;
+    result.m_depth = 0;
+    while (result.m_depth + 1 < m_height)
+    {
+        result.m_depth++;
+        result.m_index *= 2;
+        result.m_path[result.m_depth] = position(result.m_path, result.m_depth, result.m_index);
+    }
+
+    return result;
+}
+
+
+template<class T>
+template<class Visitor>
+int64_t VebLayoutTree<T>::scan(T lo, T hi, Visitor visit) const
+{
+    int64_t visited = 0;
+
+    for (Iterator it = lower_bound(lo); !it.end() && !(hi < it.key()); it.next())
+    {
+        visited++;
+        if (!visit(it.key()))
+            break;
+    }
+
+    return visited;
+}
+
+
+template<class T>
+const T & VebLayoutTree<T>::Iterator::key() const
+{
+    return m_tree->m_keys[m_path[m_depth]];
+}
+
+
+template<class T>
+int64_t VebLayoutTree<T>::Iterator::rank() const
+{
+    return m_depth < 0 ? m_tree->m_size : m_tree->rank_of(m_depth, m_index);
+}
+
+
+template<class T>
+void VebLayoutTree<T>::Iterator::next()
+{
+    const VebLayoutTree<T> * tree = m_tree;
+
+    if (m_depth + 1 < tree->m_height)
+    {
+        // Leftmost node of the right subtree.
+        m_depth++;
+        m_index = 2 * m_index + 1;
+        m_path[m_depth] = tree->position(m_path, m_depth, m_index);
+        while (m_depth + 1 < tree->m_height)
+        {
+            m_depth++;
+            m_index = 2 * m_index;
+            m_path[m_depth] = tree->position(m_path, m_depth, m_index);
+        }
+    }
+    else
+    {
+        // Climb while coming from a right child, then once more.
+        while (m_depth > 0 && (m_index & 1) == 1)
+        {
+            m_depth--;
+            m_index /= 2;
+        }
+        m_depth--;
+        m_index /= 2;
+    }
+
+    if (m_depth >= 0 && rank() >= tree->m_size)
+        m_depth = -1;
+}
+
+
+template<class T>
+bool VebLayoutTree<T>::Iterator::end() const
+{
+    return m_depth < 0;
+}
+
+#endif /* VEBLAYOUTTREE_H_ */
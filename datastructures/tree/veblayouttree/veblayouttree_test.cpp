@@ -0,0 +1,230 @@
+/**
+ * @file veblayouttree_test.cpp
+ *
+ * @brief Test unit for the van Emde Boas layout search tree class.
+ *
+ * @see veblayouttree.h veblayouttree.cpp
+ *
+ * @created Oct 19, 2026
+ * @author Vassilis S. Moustakas <vsmoustakas@gmail.com>
+ */
+
+#include "veblayouttree.h"
+#include "../binarytree/binarytree.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+void test_freeze();
+void test_lower_bound_scan();
+void test_against_sorted();
+void test_search_timing(bool large);
+
+int main (int argc, char** argv)
+{
+    test_freeze();
+    test_lower_bound_scan();
+    test_against_sorted();
+    // 100M keys need several GB for the pointer-based tree; pass --large to
+    // include them.
+    test_search_timing(argc > 1 && std::strcmp(argv[1], "--large") == 0);
+
+    return EXIT_SUCCESS;
+}
+
+
+// auxiliary functions
+
+
+/**
+ * Visitor that prints the keys it is given.
+ */
+struct PrintKey
+{
+    bool operator()(int key) const
+    {
+        std::cout << " " << key;
+        return true;
+    }
+};
+
+
+// test functions
+
+
+void test_freeze()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    BinaryTree<int> * bst = new BinaryTree<int>();
+    int keys[] = { 100, 50, 150, 25, 75, 125, 175, 110 };
+    for (int i = 0; i < 8; i++)
+        bst->insert_iterative(new BinaryTreeNode<int>(keys[i]));
+
+    VebLayoutTree<int> veb(bst->root());
+    std::cout << "Size " << veb.size() << ", height " << veb.height() << std::endl;
+
+    std::cout << "In order:";
+    for (VebLayoutTree<int>::Iterator it = veb.begin(); !it.end(); it.next())
+        std::cout << " " << it.key();
+    std::cout << std::endl;
+
+    std::cout << "Search 110: " << (veb.search(110) ? "found" : "not found") << std::endl;
+    std::cout << "Search 111: " << (veb.search(111) ? "found" : "not found") << std::endl;
+    std::cout << "Search 175: " << (veb.search(175) ? "found" : "not found") << std::endl;
+
+    VebLayoutTree<int> empty;
+    std::cout << "Empty tree: search " << (empty.search(1) ? "found" : "not found")
+            << ", begin " << (empty.begin().end() ? "at end" : "not at end") << std::endl;
+
+    delete bst;
+    std::cout << std::endl;
+}
+
+
+void test_lower_bound_scan()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    std::vector<int> keys;
+    for (int i = 1; i <= 20; i++)
+        keys.push_back(5 * i);
+
+    VebLayoutTree<int> veb;
+    veb.build(keys.begin(), keys.end());
+
+    int probes[] = { 0, 5, 6, 52, 100, 101 };
+    for (int i = 0; i < 6; i++)
+    {
+        VebLayoutTree<int>::Iterator it = veb.lower_bound(probes[i]);
+        std::cout << "Lower bound of " << probes[i] << ": ";
+        if (it.end())
+            std::cout << "end" << std::endl;
+        else
+            std::cout << it.key() << " (rank " << it.rank() << ")" << std::endl;
+    }
+
+    std::cout << "Scan [23, 61]:";
+    int64_t count = veb.scan(23, 61, PrintKey());
+    std::cout << " (" << count << " keys)" << std::endl;
+
+    std::cout << "Scan [96, 1000]:";
+    count = veb.scan(96, 1000, PrintKey());
+    std::cout << " (" << count << " keys)" << std::endl;
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Compares search, lower_bound and full iteration with std::lower_bound on
+ * sorted arrays of every size up to a few hundred, duplicates included.
+ */
+void test_against_sorted()
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    srand(11);
+    bool consistent = true;
+    for (int n = 0; n < 300 && consistent; n++)
+    {
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; i++)
+            keys[i] = rand() % (2 * n + 1);
+        std::sort(keys.begin(), keys.end());
+
+        VebLayoutTree<int> veb;
+        veb.build(keys.begin(), keys.end());
+
+        std::vector<int> inorder;
+        for (VebLayoutTree<int>::Iterator it = veb.begin(); !it.end(); it.next())
+            inorder.push_back(it.key());
+        consistent = consistent && inorder == keys;
+
+        for (int probe = -1; probe <= 2 * n + 1; probe++)
+        {
+            std::vector<int>::iterator expected = std::lower_bound(keys.begin(), keys.end(), probe);
+            VebLayoutTree<int>::Iterator it = veb.lower_bound(probe);
+            consistent = consistent && it.rank() == expected - keys.begin()
+                    && veb.search(probe) == std::binary_search(keys.begin(), keys.end(), probe);
+        }
+    }
+
+    std::cout << "Against sorted arrays: " << (consistent ? "consistent" : "INCONSISTENT") << std::endl;
+    std::cout << std::endl;
+}
+
+
+/**
+ * Random lookups in the van Emde Boas layout and in a balanced pointer-based
+ * tree over the same keys. The pointer tree is built with build_balanced, so
+ * both trees have the same height and only the layout differs.
+ */
+void test_search_timing(bool large)
+{
+    std::cout << "########################################" << std::endl;
+    std::cout << __FUNCTION__ << std::endl;
+    std::cout << "########################################" << std::endl;
+
+    const int lookups = 1 << 22;
+    int sizes[] = { 1000000, 10000000, 100000000 };
+
+    std::cout << "keys\t\tsearch_iterative\tvEB search\tvEB lower_bound" << std::endl;
+    for (int s = 0; s < (large ? 3 : 2); s++)
+    {
+        int n = sizes[s];
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; i++)
+            keys[i] = 2 * i;
+
+        std::vector<int> probes(lookups);
+        unsigned int state = 12345;
+        for (int i = 0; i < lookups; i++)
+        {
+            state = state * 1103515245 + 12345;
+            probes[i] = (int) ((state >> 1) % (2u * n));
+        }
+
+        BinaryTree<int> * bst = new BinaryTree<int>();
+        bst->build_balanced(keys.begin(), keys.end());
+        VebLayoutTree<int> veb;
+        veb.build(keys.begin(), keys.end());
+        std::vector<int>().swap(keys);
+
+        long found[3] = { 0, 0, 0 };
+        clock_t start = clock();
+        for (int i = 0; i < lookups; i++)
+            if (bst->search_iterative(bst->root(), probes[i]))
+                found[0]++;
+        double pointer_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (int i = 0; i < lookups; i++)
+            if (veb.search(probes[i]))
+                found[1]++;
+        double veb_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (int i = 0; i < lookups; i++)
+            found[2] += veb.lower_bound(probes[i]).rank();
+        double bound_secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+        std::cout << n << "\t" << pointer_secs << "s\t\t" << veb_secs << "s\t"
+                << bound_secs << "s (" << found[1] << " found, rank sum " << found[2] << ")"
+                << (found[0] == found[1] ? "" : " DIFFERENT results") << std::endl;
+
+        delete bst;
+    }
+
+    std::cout << std::endl;
+}